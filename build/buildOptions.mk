@@ -74,6 +74,16 @@ ifeq ($(RunProfiler),yes)
   CXXFLAGS+=-DIOPROFILER
 endif
 
+# Optional: LAPACK for invert/eigensystems, and optimised BLAS for GSL's BLAS
+# calls (in place of GSL's CBLAS). BLAS library must provide CBLAS interface.
+ifeq ($(UseLAPACK),yes)
+  ifeq ($(LAPACKLibs),)
+    LAPACKLibs=-llapack -lblas
+  endif
+  CXXFLAGS+=-DUSELAPACK
+  LIBS=-lgsl $(LAPACKLibs)
+endif
+
 # GSL location (if different from assumed default)
 ifneq ($(PathForGSL),)
   CXXFLAGS+=-I$(PathForGSL)/include/
@@ -3,7 +3,7 @@
 ################################################################################
 #Allow exectuables to be placed in another directory:
 ALLEXES = $(addprefix $(XD)/, \
- ampsci unitTests wigner dmeXSection periodicTable \
+ ampsci unitTests benchmarks wigner dmeXSection periodicTable \
 )
 
 DEFAULTEXES = $(addprefix $(XD)/, \
@@ -45,10 +45,13 @@ $(XD)/ampsci: $(BD)/ampsci.o $(OBJS)
 $(XD)/unitTests: $(BD)/unitTests.o $(OBJS)
 	$(LINK)
 
+$(XD)/benchmarks: $(BD)/benchmarks.o $(OBJS)
+	$(LINK)
+
 $(XD)/dmeXSection: $(BD)/dmeXSection.o $(OBJS)
 	$(LINK)
 
-$(XD)/wigner: $(BD)/wigner.o
+$(XD)/wigner: $(BD)/wigner.o $(BD)/CkTable.o
 	$(LINK)
 
 $(XD)/periodicTable: $(BD)/periodicTable.o $(BD)/AtomData.o \
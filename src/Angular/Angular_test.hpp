@@ -1,11 +1,16 @@
 #pragma once
 #include "Angular/CkTable.hpp"
+#include "Angular/RecouplingCache.hpp"
 #include "qip/Check.hpp"
 #include "qip/Maths.hpp"
 #include "qip/Vector.hpp"
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <gsl/gsl_sf_coupling.h>
+#include <random>
 #include <string>
+#include <vector>
 
 namespace UnitTest {
 
@@ -47,6 +52,208 @@ bool Angular(std::ostream &obuff) {
                              1.0e-13);
   }
 
+  { // Native 3,6,9j symbols, compared to GSL
+    const int max_2j = 12;
+    double eps3 = 0.0, eps6 = 0.0, eps9 = 0.0;
+    std::vector<std::array<int, 6>> list3, list6;
+    for (int a = 0; a <= max_2j; ++a) {
+      for (int b = 0; b <= max_2j; ++b) {
+        for (int c = 0; c <= max_2j; ++c) {
+          for (int ma = -a; ma <= a; ma += 2) {
+            for (int mb = -b; mb <= b; mb += 2) {
+              const auto mc = -ma - mb;
+              const auto tj1 = Angular::threej_2(a, b, c, ma, mb, mc);
+              const auto tj2 = gsl_sf_coupling_3j(a, b, c, ma, mb, mc);
+              eps3 = qip::max_abs(eps3, tj1 - tj2);
+              if (tj2 != 0.0)
+                list3.push_back({a, b, c, ma, mb, mc});
+            }
+          }
+          for (int d = 0; d <= max_2j; ++d) {
+            for (int e = 0; e <= max_2j; ++e) {
+              for (int f = 0; f <= max_2j; ++f) {
+                const auto sj1 = Angular::sixj_2(a, b, c, d, e, f);
+                const auto sj2 = gsl_sf_coupling_6j(a, b, c, d, e, f);
+                eps6 = qip::max_abs(eps6, sj1 - sj2);
+                if (sj2 != 0.0)
+                  list6.push_back({a, b, c, d, e, f});
+              }
+            }
+          }
+        }
+      }
+    }
+    pass &= qip::check_value(&obuff, "3j vs GSL", eps3, 0.0, 1.0e-14);
+    pass &= qip::check_value(&obuff, "6j vs GSL", eps6, 0.0, 1.0e-14);
+
+    // 9j: random sample (too many to do all)
+    std::mt19937 gen(1);
+    std::uniform_int_distribution<int> r2j(0, 8);
+    for (int i = 0; i < 20000; ++i) {
+      std::array<int, 9> j;
+      std::generate(j.begin(), j.end(), [&]() { return r2j(gen); });
+      const auto nj1 = Angular::ninej_2(j[0], j[1], j[2], j[3], j[4], j[5],
+                                        j[6], j[7], j[8]);
+      const auto nj2 = gsl_sf_coupling_9j(j[0], j[1], j[2], j[3], j[4], j[5],
+                                          j[6], j[7], j[8]);
+      eps9 = qip::max_abs(eps9, nj1 - nj2);
+    }
+    pass &= qip::check_value(&obuff, "9j vs GSL", eps9, 0.0, 1.0e-14);
+
+    // Large j: orthogonality,
+    // sum_x [x][f] {a b x \ c d f}{c d x \ a b f'} = delta_{ff'}
+    std::uniform_int_distribution<int> r2J(30, 80);
+    double eps6_large = 0.0;
+    for (int i = 0; i < 20; ++i) {
+      const auto a = r2J(gen), b = r2J(gen), c = r2J(gen);
+      const auto d = 2 * r2J(gen) - a - b - c; // ensure a+b+c+d even
+      if (d < 0)
+        continue;
+      const auto f_min = std::max(std::abs(a - d), std::abs(b - c));
+      const auto f_max = std::min(a + d, b + c);
+      for (int f1 = f_min; f1 <= f_max; f1 += 2) {
+        for (int f2 = f1; f2 <= f_max; f2 += 2) {
+          double sum = 0.0;
+          for (int x = 0; x <= 4 * 80; ++x) {
+            sum += (x + 1) * (f1 + 1) * Angular::sixj_2(a, b, x, c, d, f1) *
+                   Angular::sixj_2(c, d, x, a, b, f2);
+          }
+          eps6_large = qip::max_abs(eps6_large, sum - (f1 == f2 ? 1.0 : 0.0));
+        }
+      }
+    }
+    pass &= qip::check_value(&obuff, "6j orthogonality (large j)", eps6_large,
+                             0.0, 1.0e-12);
+
+    // Very large j, past end of factorial table (n! for n > 1000). Exact:
+    // (j j 0 \ m -m 0) = (-1)^(j-m)/sqrt(2j+1), and
+    // {a b c \ 0 c b} = (-1)^(a+b+c)/sqrt([b][c])
+    const auto nmax = Angular::helper::FactorialTable::max_n;
+    double eps_table_end = 0.0;
+    for (const auto tj : {nmax - 3, nmax - 2, nmax - 1, nmax, nmax + 1,
+                          nmax + 2, 3 * nmax / 2}) {
+      for (const auto tm : {tj, tj - 2, tj % 2, -tj + 4}) {
+        const auto tj3 = Angular::threej_2(tj, tj, 0, tm, -tm, 0);
+        const auto s3 = Angular::neg1pow_2(tj - tm);
+        eps_table_end = qip::max_abs(
+            eps_table_end, tj3 * std::sqrt(tj + 1.0) / s3 - 1.0);
+      }
+      for (const auto ta : {0, 2, 4}) {
+        const auto sj = Angular::sixj_2(ta, tj, tj, 0, tj, tj);
+        const auto s6 = Angular::neg1pow_2(ta + 2 * tj);
+        eps_table_end =
+            qip::max_abs(eps_table_end, sj * (tj + 1.0) / s6 - 1.0);
+      }
+    }
+    pass &= qip::check_value(&obuff, "3j/6j past factorial table",
+                             eps_table_end, 0.0, 1.0e-13);
+
+    // Batch versions: should be identical to individual calls
+    const auto batch3 = Angular::threej_2(list3);
+    const auto batch6 = Angular::sixj_2(list6);
+    double eps_batch = 0.0;
+    for (auto i = 0ul; i < list3.size(); ++i) {
+      const auto &[a, b, c, ma, mb, mc] = list3[i];
+      const auto tj = Angular::threej_2(a, b, c, ma, mb, mc);
+      eps_batch = qip::max_abs(eps_batch, batch3[i] - tj);
+    }
+    for (auto i = 0ul; i < list6.size(); ++i) {
+      const auto &[a, b, c, d, e, f] = list6[i];
+      const auto sj = Angular::sixj_2(a, b, c, d, e, f);
+      eps_batch = qip::max_abs(eps_batch, batch6[i] - sj);
+    }
+    pass &= qip::check_value(&obuff, "3j/6j batch", eps_batch, 0.0, 0.0);
+  }
+
+  { // Recoupling cache: C^k_ac C^k_bd C^l_ad C^l_bc {a c k \ b d l}
+    const auto Lkl = [](int k, int l, int ka, int kb, int kc, int kd) {
+      const auto sj =
+          Angular::sixj_2(Angular::twoj_k(ka), Angular::twoj_k(kc), 2 * k,
+                          Angular::twoj_k(kb), Angular::twoj_k(kd), 2 * l);
+      return sj * Angular::Ck_kk(k, ka, kc) * Angular::Ck_kk(k, kb, kd) *
+             Angular::Ck_kk(l, ka, kd) * Angular::Ck_kk(l, kb, kc);
+    };
+    const int max_k = 4;
+    const int num_kappa = 8;
+    const Angular::RecouplingCache cache(max_k, Lkl);
+
+    // Fill (in parallel) and check against direct calculation, including
+    // beyond max_k, and that non-zero list is complete + ordered
+    double eps = 0.0;
+    int bad_nonzero = 0;
+#pragma omp parallel for reduction(max : eps) reduction(+ : bad_nonzero)
+    for (int i = 0; i < num_kappa * num_kappa * num_kappa * num_kappa; ++i) {
+      const auto ka = Angular::kappaFromIndex(i % num_kappa);
+      const auto kb = Angular::kappaFromIndex((i / num_kappa) % num_kappa);
+      const auto kc =
+          Angular::kappaFromIndex((i / num_kappa / num_kappa) % num_kappa);
+      const auto kd = Angular::kappaFromIndex(i / num_kappa / num_kappa /
+                                              num_kappa);
+      const auto &coefs = cache.get(ka, kb, kc, kd);
+      std::vector<Angular::RecouplingCache::Term> nonzero;
+      for (int k = 0; k <= max_k + 2; ++k) {
+        for (int l = 0; l <= max_k + 2; ++l) {
+          const auto x = Lkl(k, l, ka, kb, kc, kd);
+          eps = std::max(eps, std::abs(coefs(k, l) - x));
+          if (x != 0.0 && k <= max_k && l <= max_k)
+            nonzero.push_back({k, l, x});
+        }
+      }
+      const auto &terms = coefs.nonzero();
+      const auto same = [](const auto &t1, const auto &t2) {
+        return t1.k == t2.k && t1.l == t2.l && t1.value == t2.value;
+      };
+      if (!std::equal(nonzero.cbegin(), nonzero.cend(), terms.cbegin(),
+                      terms.cend(), same))
+        ++bad_nonzero;
+      for (int k = 0; k <= max_k; ++k) {
+        for (const auto &term : coefs.nonzero(k)) {
+          if (term.k != k)
+            ++bad_nonzero;
+        }
+      }
+    }
+    pass &= qip::check_value(&obuff, "RecouplingCache", eps, 0.0, 0.0);
+    pass &= qip::check_value(&obuff, "RecouplingCache non-zero", bad_nonzero,
+                             0, 0);
+    pass &= qip::check_value(&obuff, "RecouplingCache size",
+                             int(cache.size()),
+                             num_kappa * num_kappa * num_kappa * num_kappa, 0);
+
+    // Single l: only that l stored, but all l still correct
+    double eps_l = 0.0;
+    std::size_t num_terms_l = 0;
+    for (int l = 0; l <= max_k + 1; ++l) {
+      const auto &coefs = cache.get_l(l, -1, 2, -2, 1);
+      num_terms_l += coefs.nonzero().size();
+      for (const auto &term : coefs.nonzero()) {
+        if (term.l != l)
+          ++num_terms_l;
+      }
+      for (int k = 0; k <= max_k + 2; ++k) {
+        for (int l2 = 0; l2 <= max_k + 2; ++l2) {
+          eps_l = std::max(eps_l, std::abs(coefs(k, l2) -
+                                           Lkl(k, l2, -1, 2, -2, 1)));
+        }
+      }
+    }
+    pass &= qip::check_value(&obuff, "RecouplingCache single l", eps_l, 0.0,
+                             0.0);
+    pass &= qip::check(&obuff, "RecouplingCache single l terms", num_terms_l,
+                       cache.get(-1, 2, -2, 1).nonzero().size() +
+                           cache.get_l(max_k + 1, -1, 2, -2, 1).nonzero().size());
+
+    // Default-constructed (empty) cache: all zero (no function to call)
+    const Angular::RecouplingCache empty_cache;
+    const auto &empty = empty_cache.get(-1, 2, -2, 1);
+    pass &= qip::check(&obuff, "RecouplingCache empty",
+                       empty(0, 0) == 0.0 && empty(3, 1) == 0.0 &&
+                           empty.nonzero().empty() &&
+                           empty_cache(1, 1, -1, 1, -1, 1) == 0.0 &&
+                           empty_cache.size() == 0ul,
+                       true);
+  }
+
   return pass;
 }
 
@@ -1,6 +1,7 @@
 #pragma once
 #include "Angular/Wigner369j.hpp"
 #include <algorithm>
+#include <cassert>
 #include <iostream>
 #include <vector>
 
@@ -21,6 +22,9 @@ constexpr int jindex_kappa(int ka) { return (ka > 0) ? ka - 1 : -ka - 1; }
   - Ck(ab)      := \f$C^k_{ab} = <ka||C^k||kb>\f$ [symmetric up to +/- sign]
   - TildeCk_ab := \f$(-1)^{ja+1/2} C^k_{ab}\f$ [symmetric]
   - Slightly faster than calculating on-the-fly, but adds some overhead
+  - Values (C^k, tilde C^k, 3j, Lambda^k) stored directly in flat, contiguous
+arrays indexed by (k, kappa_index_a, kappa_index_b); zeros (parity/triangle)
+are stored explicitly, so look-ups need no checks
 \par Construction
   - Needs maximum two*j values. Will build look-up tables for all possible
 symbols.
@@ -45,22 +49,54 @@ public:
   double get_3jkab_mutable(int k, int ka, int kb);
 
   //! @brief Use const versions if sure value already exists
-  //! @details Note: undefined behaviour to call if the value doesn't exist yet
-  double get_Ckab(int k, int ka, int kb) const;
-  double get_tildeCkab(int k, int ka, int kb) const;
-  double get_3jkab(int k, int ka, int kb) const;
+  //! @details Returns 0 if k is beyond table. Note: undefined behaviour to
+  //! call if the kappas are beyond the table
+  double get_Ckab(int k, int ka, int kb) const {
+    return k <= m_max_k_sofar ? m_Ck[index(k, ka, kb)] : 0.0;
+  }
+  double get_tildeCkab(int k, int ka, int kb) const {
+    return k <= m_max_k_sofar ? m_tildeCk[index(k, ka, kb)] : 0.0;
+  }
+  double get_3jkab(int k, int ka, int kb) const {
+    return k <= m_max_k_sofar ? m_3j[index(k, ka, kb)] : 0.0;
+  }
 
   double operator()(int k, int ka, int kb) const { return get_Ckab(k, ka, kb); }
 
   //! Lambda^k_ij := 3js((ji,jj,k),(-1/2,1/2,0))^2 * parity(li+lj+k)
-  double get_Lambdakab(int k, int ka, int kb) const;
+  double get_Lambdakab(int k, int ka, int kb) const {
+    return k <= m_max_k_sofar ? m_Lambda[index(k, ka, kb)] : 0.0;
+  }
+
+  //! @brief Unchecked versions, for hot loops: k, ka, and kb *must* all be
+  //! within the table (only checked by assert)
+  double get_Ckab_unchecked(int k, int ka, int kb) const {
+    return m_Ck[index(k, ka, kb)];
+  }
+  double get_tildeCkab_unchecked(int k, int ka, int kb) const {
+    return m_tildeCk[index(k, ka, kb)];
+  }
 
   int max_tj() const { return twoj(m_max_jindex_sofar); }
   int max_k() const { return m_max_k_sofar; }
 
 private:
-  std::vector<std::vector<std::vector<double>>> m_3j_k_a_b = {};
-  std::vector<std::vector<double>> m_Rjab_a_b = {}; // Sqrt([ja][jb])
+  // Position in (flat) tables of {k, ka, kb}
+  std::size_t index(int k, int ka, int kb) const {
+    assert(k >= 0 && k <= m_max_k_sofar);
+    assert(jindex_kappa(ka) <= m_max_jindex_sofar &&
+           jindex_kappa(kb) <= m_max_jindex_sofar);
+    return (std::size_t(k) * m_num_kappa + std::size_t(indexFromKappa(ka))) *
+               m_num_kappa +
+           std::size_t(indexFromKappa(kb));
+  }
+
+  // Flat tables, indexed by (k, kappa_index_a, kappa_index_b); see index()
+  std::vector<double> m_Ck = {};
+  std::vector<double> m_tildeCk = {};
+  std::vector<double> m_3j = {};
+  std::vector<double> m_Lambda = {};
+  std::size_t m_num_kappa = 0;
   int m_max_jindex_sofar = -1;
   int m_max_k_sofar = -1;
 };
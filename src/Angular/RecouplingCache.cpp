@@ -0,0 +1,91 @@
+#include "Angular/RecouplingCache.hpp"
+#include "Angular/Wigner369j.hpp"
+#include <algorithm>
+#include <cassert>
+#include <mutex>
+
+namespace Angular {
+
+//******************************************************************************
+RecouplingCache::Coefs::Coefs(int max_k, const Function &f, int ka, int kb,
+                              int kc, int kd, int single_l)
+    : m_max_k(f ? max_k : -1),
+      m_ka(ka),
+      m_kb(kb),
+      m_kc(kc),
+      m_kd(kd),
+      m_l0(single_l >= 0 ? single_l : 0),
+      m_num_l(single_l >= 0 ? 1 : max_k + 1),
+      m_f(f) {
+  // nb: if f is empty (default-constructed cache), nothing is stored
+  const auto dim = std::size_t(std::max(m_max_k + 1, 0));
+  m_values.resize(dim * std::size_t(std::max(m_num_l, 0)));
+  m_k_begin.reserve(dim + 1);
+  for (int k = 0; k <= m_max_k; ++k) {
+    m_k_begin.push_back(m_nonzero.size());
+    for (int l = m_l0; l < m_l0 + m_num_l; ++l) {
+      const auto x = f(k, l, ka, kb, kc, kd);
+      m_values[std::size_t(k * m_num_l + l - m_l0)] = x;
+      if (x != 0.0)
+        m_nonzero.push_back({k, l, x});
+    }
+  }
+  m_k_begin.push_back(m_nonzero.size());
+}
+
+//******************************************************************************
+const RecouplingCache::Coefs &RecouplingCache::get(int ka, int kb, int kc,
+                                                   int kd) const {
+  return get_impl(-1, ka, kb, kc, kd);
+}
+
+//******************************************************************************
+const RecouplingCache::Coefs &RecouplingCache::get_l(int l, int ka, int kb,
+                                                     int kc, int kd) const {
+  assert(l >= 0);
+  return get_impl(l, ka, kb, kc, kd);
+}
+
+//******************************************************************************
+const RecouplingCache::Coefs &
+RecouplingCache::get_impl(int l, int ka, int kb, int kc, int kd) const {
+  if (!m_f) {
+    // Default-constructed (empty) cache: all coefficients are zero
+    static const Coefs empty{-1, Function{}, 0, 0, 0, 0};
+    return empty;
+  }
+  const auto index = key(l, ka, kb, kc, kd);
+  {
+    std::shared_lock lock(*m_mutex);
+    const auto it = m_data.find(index);
+    if (it != m_data.cend())
+      return *it->second;
+  }
+
+  // Not found: calculate (outside of lock), then store
+  auto coefs = std::make_unique<const Coefs>(m_max_k, m_f, ka, kb, kc, kd, l);
+  std::unique_lock lock(*m_mutex);
+  // nb: if another thread stored it in the meantime, keep (and return) that
+  return *m_data.try_emplace(index, std::move(coefs)).first->second;
+}
+
+//******************************************************************************
+std::size_t RecouplingCache::size() const {
+  std::shared_lock lock(*m_mutex);
+  return m_data.size();
+}
+
+//******************************************************************************
+std::uint64_t RecouplingCache::key(int l, int ka, int kb, int kc, int kd) {
+  // 16 bits for l+1 (0 means all l), 12 bits for each kappa index
+  const auto il = std::uint64_t(l + 1);
+  const auto ia = std::uint64_t(Angular::indexFromKappa(ka));
+  const auto ib = std::uint64_t(Angular::indexFromKappa(kb));
+  const auto ic = std::uint64_t(Angular::indexFromKappa(kc));
+  const auto id = std::uint64_t(Angular::indexFromKappa(kd));
+  assert(il < 0x10000);
+  assert(ia < 0x1000 && ib < 0x1000 && ic < 0x1000 && id < 0x1000);
+  return (il << 48) | (ia << 36) | (ib << 24) | (ic << 12) | id;
+}
+
+} // namespace Angular
@@ -0,0 +1,147 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <shared_mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace Angular {
+
+//******************************************************************************
+/*!
+@brief
+Thread-safe, lazily-filled cache of composite angular (recoupling)
+coefficients, X^{kl}_{abcd}, which depend on two ranks {k,l} and four kappas.
+@details
+The coefficient is defined by the given function, f(k, l, ka, kb, kc, kd);
+typically some product of C^k's, 6j symbols and phases (e.g., the angular
+factor of an MBPT diagram). The first time a set of kappas {ka,kb,kc,kd} is
+asked for, f is evaluated for all 0 <= k,l <= max_k and stored (see Coefs),
+along with a list of just the non-zero terms. Callers can then loop over only
+the allowed {k,l} channels, rather than testing selection rules for each.
+
+If only a single l is ever needed for a given set of kappas (e.g., l is the
+fixed rank of an external operator), use get_l(l, ka, kb, kc, kd) instead:
+only that l is calculated/stored (for all 0 <= k <= max_k), and sets for
+different l are stored separately.
+
+Each set is calculated outside of any lock; if two threads calculate the same
+set at once, the first one stored is kept. Stored sets are never moved or
+removed (until clear()), so returned references remain valid. For k larger
+than max_k (or l not stored), f is called directly (not stored).
+
+A default-constructed cache is empty: every coefficient is zero.
+
+nb: f must be thread-safe, and anything it refers to must outlive the cache.
+Movable, but not copyable.
+*/
+class RecouplingCache {
+
+public:
+  //! Signature of coefficient function: f(k, l, ka, kb, kc, kd)
+  using Function = std::function<double(int, int, int, int, int, int)>;
+
+  //! A single (non-zero) coefficient: value = X^{kl}
+  struct Term {
+    int k;
+    int l;
+    double value;
+  };
+
+  //! (Non-owning) range of Terms; for use in range-based for loops
+  class Terms {
+    const Term *m_begin, *m_end;
+
+  public:
+    Terms(const Term *begin, const Term *end) : m_begin(begin), m_end(end) {}
+    const Term *begin() const { return m_begin; }
+    const Term *end() const { return m_end; }
+    bool empty() const { return m_begin == m_end; }
+    std::size_t size() const { return std::size_t(m_end - m_begin); }
+  };
+
+  //! All coefficients X^{kl} for a single set of kappas {ka,kb,kc,kd}
+  class Coefs {
+    int m_max_k;
+    int m_ka, m_kb, m_kc, m_kd;
+    // Stored l's: l0 <= l < l0 + num_l
+    int m_l0, m_num_l;
+    Function m_f;
+    // Dense: (k * num_l + l - l0)
+    std::vector<double> m_values{};
+    // Non-zero only, ordered by k then l; terms for k start at m_k_begin[k]
+    std::vector<Term> m_nonzero{};
+    std::vector<std::size_t> m_k_begin{};
+
+  public:
+    //! Calculates (and stores) X^{kl} for all 0 <= k,l <= max_k; or, if
+    //! single_l >= 0, for 0 <= k <= max_k and l = single_l only
+    Coefs(int max_k, const Function &f, int ka, int kb, int kc, int kd,
+          int single_l = -1);
+
+    //! X^{kl}: stored value if k <= max_k (and l stored), otherwise calculated
+    double operator()(int k, int l) const {
+      if (k < 0 || l < 0)
+        return 0.0;
+      if (k > m_max_k || l < m_l0 || l >= m_l0 + m_num_l)
+        return m_f ? m_f(k, l, m_ka, m_kb, m_kc, m_kd) : 0.0;
+      return m_values[std::size_t(k * m_num_l + l - m_l0)];
+    }
+
+    //! All (stored) non-zero terms, ordered by k, then l
+    const std::vector<Term> &nonzero() const { return m_nonzero; }
+
+    //! (Stored) non-zero terms for given k, ordered by l. Empty if k > max_k
+    Terms nonzero(int k) const {
+      if (k < 0 || k > m_max_k)
+        return {nullptr, nullptr};
+      const auto sk = std::size_t(k);
+      return {m_nonzero.data() + m_k_begin[sk],
+              m_nonzero.data() + m_k_begin[sk + 1]};
+    }
+
+    int max_k() const { return m_max_k; }
+  };
+
+private:
+  int m_max_k{-1};
+  Function m_f{};
+  // unique_ptr: so cache is movable
+  std::unique_ptr<std::shared_mutex> m_mutex{
+      std::make_unique<std::shared_mutex>()};
+  mutable std::unordered_map<std::uint64_t, std::unique_ptr<const Coefs>>
+      m_data{};
+
+public:
+  RecouplingCache() {}
+  //! Coefficients stored for 0 <= k,l <= max_k; f(k, l, ka, kb, kc, kd)
+  RecouplingCache(int max_k, Function f) : m_max_k(max_k), m_f(std::move(f)) {}
+
+  //! All coefficients for given set of kappas: from cache if present, otherwise
+  //! calculates and stores them. Thread safe.
+  const Coefs &get(int ka, int kb, int kc, int kd) const;
+
+  //! As get(), but only for single given l (with 0 <= k <= max_k). Thread
+  //! safe.
+  const Coefs &get_l(int l, int ka, int kb, int kc, int kd) const;
+
+  //! Single coefficient X^{kl}_{abcd}. Thread safe.
+  double operator()(int k, int l, int ka, int kb, int kc, int kd) const {
+    return get(ka, kb, kc, kd)(k, l);
+  }
+
+  int max_k() const { return m_max_k; }
+  //! Number of sets of kappas currently stored
+  std::size_t size() const;
+  //! Removes all stored coefficients. Not thread safe
+  void clear() { m_data.clear(); }
+
+private:
+  // l = -1 means all l
+  const Coefs &get_impl(int l, int ka, int kb, int kc, int kd) const;
+  static std::uint64_t key(int l, int ka, int kb, int kc, int kd);
+};
+
+} // namespace Angular
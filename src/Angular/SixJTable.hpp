@@ -1,11 +1,10 @@
 #pragma once
 #include "Angular/Wigner369j.hpp"
+#include "IO/ChronoTimer.hpp"
 #include <algorithm>
 #include <cassert>
 #include <cstdint>
-#include <cstring>
 #include <iostream>
-#include <unordered_map>
 #include <vector>
 
 // XXX Note: This is significantly faster if implemented in header file, not
@@ -22,12 +21,23 @@ Lookup table for Wigner 6J symbols.
 @details
 Note: functions all called with 2*j and 2*k (ensure j integer)
 Makes use of symmetry.
+
+Symbols are stored in a dense array, indexed directly from the 'normal
+ordered' {a,b,c,d,e,f} (see normal_order()), where a = min{a,b,c,d,e,f}, and
+b = min{b,c,e,f}. For each allowed triad {a,b,c} (a <= b <= c), there is a
+block containing all {e,f,d}, where e in [b, max], f in [e-a, e+a], and d in
+[f-b, f+b] (in steps of 2, by the triangle rules). Some elements are zero
+(e.g., fail the {d,e,c} triangle rule); these are never looked up.
 */
 class SixJTable {
 private:
-  std::unordered_map<uint64_t, double> m_data{};
+  // Dense storage of (normal-ordered) 6j symbols
+  std::vector<double> m_data{};
+  // Offset of block in m_data for each triad {a,b,c}: see triad()
+  std::vector<std::size_t> m_offset{};
   int m_max_2jk{-1};
-  static auto s(int i) { return static_cast<uint8_t>(i); };
+  // Total time spent in fill() [ms]
+  double m_fill_time{0.0};
 
 public:
   SixJTable() = default;
@@ -39,6 +49,15 @@ public:
   //! Returns 2* maximum k in the tales
   int max_2jk() const { return m_max_2jk; }
 
+  //! Memory used by table (in bytes)
+  std::size_t bytes() const {
+    return m_data.size() * sizeof(double) +
+           m_offset.size() * sizeof(std::size_t);
+  }
+
+  //! Total time spent filling the table (in ms)
+  double fill_time() const { return m_fill_time; }
+
   //----------------------------------------------------------------------------
   //! Return 6j symbol {a/2,b/2,c/2,d/2,e/2,f/2}. Note: takes in 2*j as int
   //! @details Note: If requesting a 6J symbol beyond what is stores, will
@@ -52,18 +71,17 @@ public:
   //! @details Note: If requesting a 6J symbol beyond what is stored, will
   //! return 0 (without warning)
   inline double get(int a, int b, int c, int d, int e, int f) const {
-    if (Angular::sixj_zeroQ(a, b, c, d, e, f))
+    if (!contains(a, b, c, d, e, f))
       return 0.0;
-    const auto it = m_data.find(normal_order(a, b, c, d, e, f));
-    return (it == m_data.cend()) ? 0.0 : it->second;
+    return m_data[normal_order(a, b, c, d, e, f)];
   }
 
   //----------------------------------------------------------------------------
   //! Checks if given 6j symbol is in table (note: may not be in table because
-  //! it's zero)
+  //! it's zero by triangle rules)
   bool contains(int a, int b, int c, int d, int e, int f) const {
-    const auto it = m_data.find(normal_order(a, b, c, d, e, f));
-    return (it != m_data.cend());
+    return std::max({a, b, c, d, e, f}) <= m_max_2jk &&
+           !Angular::sixj_zeroQ(a, b, c, d, e, f);
   }
 
   //----------------------------------------------------------------------------
@@ -71,7 +89,8 @@ public:
   //! (note: 2*, as integer).
   /*! @details Typically, max_2jk is 2*max_2j, where max_2j is 2* max j of set
     of orbitals. You may call this function several times; if the new max_2jk is
-    larger, it will extend the table. If it is smaller, does nothing. */
+    larger, it will extend the table (symbols already in the table are copied,
+    not re-calculated). If it is smaller, does nothing. Filled in parallel. */
   void fill(int max_2jk) {
     // a = min{a,b,c,d,e,f}
     // b = min{b, c, e, f}
@@ -79,76 +98,110 @@ public:
     if (max_2jk <= m_max_2jk)
       return;
 
-    // Calculate all new *unique* 6J symbols:
-    // Take advantage of symmetries, to only calc those that are needed.
-    // We define a = min(a,b,c,d,e,f), b=min(b,d,e,f) => unique 6j symbol
-    // in "normal" order
+    IO::ChronoTimer timer; // nb: un-named, so doesn't print
+
+    // Layout: offset of each {a,b,c} block (new size)
+    struct Triad {
+      int a, b, c;
+      std::size_t offset;
+    };
+    std::vector<Triad> triads;
+    const auto dim = std::size_t(max_2jk + 1);
+    std::vector<std::size_t> offset(dim * dim * dim, 0);
+    std::size_t size = 0;
     for (int a = 0; a <= max_2jk; ++a) {
-      auto a0 = a; // std::max(min_2jk, a);
-      for (int b = a0; b <= max_2jk; ++b) {
-        for (int c = b; c <= max_2jk; ++c) {
-          for (int d = a0; d <= max_2jk; ++d) { // note: different!
-            for (int e = b; e <= max_2jk; ++e) {
-              for (int f = b; f <= max_2jk; ++f) {
-                if (Angular::sixj_zeroQ(a, b, c, d, e, f))
-                  continue;
-                if (contains(a, b, c, d, e, f))
-                  continue;
-                const auto sj = Angular::sixj_2(a, b, c, d, e, f);
-                if (std::abs(sj) > 1.0e-16) {
-                  m_data[normal_order(a, b, c, d, e, f)] = sj;
-                }
-              }
+      for (int b = a; b <= max_2jk; ++b) {
+        // c in [b, a+b], with (a+b+c) even
+        for (int c = b + a % 2; c <= std::min(a + b, max_2jk); c += 2) {
+          offset[triad(a, b, c, max_2jk)] = size;
+          triads.push_back({a, b, c, size});
+          size += block_size(a, b, max_2jk);
+        }
+      }
+    }
+
+    // Calculate all new *unique* 6J symbols; copy existing ones.
+    std::vector<double> data(size, 0.0);
+#pragma omp parallel for schedule(dynamic)
+    for (auto i = 0ul; i < triads.size(); ++i) {
+      const auto [a, b, c, block] = triads[i];
+      for (int e = b; e <= max_2jk; ++e) {
+        for (int f = e - a; f <= std::min(e + a, max_2jk); f += 2) {
+          if (f < b)
+            continue;
+          for (int d = f - b; d <= std::min(f + b, max_2jk); d += 2) {
+            if (d < a || Angular::sixj_zeroQ(a, b, c, d, e, f))
+              continue;
+            const auto sj = contains(a, b, c, d, e, f) ?
+                                get(a, b, c, d, e, f) :
+                                Angular::sixj_2(a, b, c, d, e, f);
+            if (std::abs(sj) > 1.0e-16) {
+              data[position(block, a, b, d, e, f)] = sj;
             }
           }
         }
       }
     }
 
+    m_data = std::move(data);
+    m_offset = std::move(offset);
     // update max 2k
     m_max_2jk = max_2jk;
+    m_fill_time += timer.reading_ms();
   }
 
 private:
   //----------------------------------------------------------------------------
-  inline static auto make_key(uint8_t a, uint8_t b, uint8_t c, uint8_t d,
-                              uint8_t e, uint8_t f) {
-    uint64_t key = 0;
-    // std::memcpy(&key, &abcdef[0], 6 * sizeof(uint8_t));
-    auto pk = (uint8_t *)(&key);
-    std::memcpy(pk, &a, sizeof(uint8_t));
-    std::memcpy(pk + 1, &b, sizeof(uint8_t));
-    std::memcpy(pk + 2, &c, sizeof(uint8_t));
-    std::memcpy(pk + 3, &d, sizeof(uint8_t));
-    std::memcpy(pk + 4, &e, sizeof(uint8_t));
-    std::memcpy(pk + 5, &f, sizeof(uint8_t));
-    return key;
+  // Index into m_offset for triad {a,b,c}
+  static std::size_t triad(int a, int b, int c, int max_2jk) {
+    const auto dim = std::size_t(max_2jk + 1);
+    return (std::size_t(a) * dim + std::size_t(b)) * dim + std::size_t(c);
+  }
+
+  // Size of the {e,f,d} block for triad {a,b,c}
+  static std::size_t block_size(int a, int b, int max_2jk) {
+    return std::size_t(max_2jk - b + 1) * std::size_t(a + 1) *
+           std::size_t(b + 1);
+  }
+
+  // Position (in m_data) of normal-ordered {a,b,c,d,e,f}, given block offset
+  static std::size_t position(std::size_t block, int a, int b, int d, int e,
+                              int f) {
+    // e in [b, max], f in [e-a, e+a], d in [f-b, f+b]
+    const auto ie = std::size_t(e - b);
+    const auto i_f = std::size_t((f - e + a) / 2);
+    const auto id = std::size_t((d - f + b) / 2);
+    return block + (ie * std::size_t(a + 1) + i_f) * std::size_t(b + 1) + id;
+  }
+
+  //----------------------------------------------------------------------------
+  inline std::size_t index(int a, int b, int c, int d, int e, int f) const {
+    return position(m_offset[triad(a, b, c, m_max_2jk)], a, b, d, e, f);
   }
 
   //----------------------------------------------------------------------------
-  inline static auto normal_order_level2(int a, int b, int c, int d, int e,
-                                         int f) {
+  inline std::size_t normal_order_level2(int a, int b, int c, int d, int e,
+                                         int f) const {
     // note: 'a' must be minimum!
     // assert(a == std::min({a, b, c, d, e, f})); // remove
     // {a,b,c|d,e,f} = {a,c,b|d,f,e} = {a,e,f|d,b,c} = {a,f,e|d,c,b}
     const auto min_bcef = std::min({b, c, e, f});
 
     if (min_bcef == b) {
-      return make_key(s(a), s(b), s(c), s(d), s(e), s(f));
+      return index(a, b, c, d, e, f);
     } else if (min_bcef == c) {
-      return make_key(s(a), s(c), s(b), s(d), s(f), s(e));
+      return index(a, c, b, d, f, e);
     } else if (min_bcef == e) {
-      return make_key(s(a), s(e), s(f), s(d), s(b), s(c));
-    } else if (min_bcef == f) {
-      return make_key(s(a), s(f), s(e), s(d), s(c), s(b));
+      return index(a, e, f, d, b, c);
     }
-    assert(false && "Fatal error 170: unreachable");
+    assert(min_bcef == f && "Fatal error 170: unreachable");
+    return index(a, f, e, d, c, b);
   }
 
   //----------------------------------------------------------------------------
-  static uint64_t normal_order(int a, int b, int c, int d, int e, int f) {
-    // returns unique "normal ordering" of {a,b,c,d,e,f}->{i,j,k,l,m,n}
-    // where i = min{a,b,c,d,e,f}, j = min{b,c,e,f}
+  std::size_t normal_order(int a, int b, int c, int d, int e, int f) const {
+    // returns position of unique "normal ordering" of {a,b,c,d,e,f}
+    // ->{i,j,k,l,m,n}, where i = min{a,b,c,d,e,f}, j = min{b,c,e,f}
     const auto min = std::min({a, b, c, d, e, f});
     //   {a,b,c|d,e,f} = {b,a,c|e,d,f} = {c,a,b|f,d,e}
     // = {d,e,c|a,b,f} = {e,d,c|b,a,f} = {f,a,e|c,d,b}
@@ -164,10 +217,9 @@ private:
       return normal_order_level2(d, e, c, a, b, f);
     } else if (min == e) {
       return normal_order_level2(e, d, c, b, a, f);
-    } else if (min == f) {
-      return normal_order_level2(f, a, e, c, d, b);
     }
-    assert(false && "Fatal error 193: unreachable");
+    assert(min == f && "Fatal error 193: unreachable");
+    return normal_order_level2(f, a, e, c, d, b);
   }
 };
 
@@ -2,6 +2,7 @@
 #include "Angular/SixJTable.hpp"
 #include "IO/ChronoTimer.hpp"
 #include "qip/Check.hpp"
+#include <gsl/gsl_sf_coupling.h>
 #include <string>
 
 namespace UnitTest {
@@ -24,6 +25,7 @@ bool SixJTable(std::ostream &obuff) {
       IO::ChronoTimer t("Fill " + std::to_string(max_2k));
       sjt.fill(max_2k); // nb: each loop, "extends" the table
     }
+    std::cout << "6j table: " << double(sjt.bytes()) / 1.0e6 << " MB\n";
 
     std::stringstream ss;
     auto max_del = 0.0;
@@ -1,18 +1,22 @@
 #pragma once
 #include <algorithm> //std::min!
+#include <array>
+#include <cassert>
 #include <cmath>
-#include <gsl/gsl_sf_coupling.h>
+#include <limits>
 #include <utility>
+#include <vector>
 
 /*!
 @brief
 Calculate wigner 3,6,9-J symbols + Clebsh-Gordon coefs etc..
 @details
-Wrapper functions to calculate wigner 3,6,9-J symbols.
-Uses GSL:
+Functions to calculate wigner 3,6,9-J symbols.
+Uses the Racah formulas directly (see helper::threej_racah etc.), with a shared
+lookup table of factorials. Cross-checked against GSL in unit tests:
 https://www.gnu.org/software/gsl/doc/html/specfunc.html?highlight=3j#coupling-coefficients
 NOTE:
-Since j always integer or half-integer, GSL inputs are always integer.
+Since j always integer or half-integer, inputs (2*j) are always integer.
 Three versions of each symbol:
  - 'regular', takes in double. Converts to integer safely. Slower (marginally),
     but easier
@@ -113,6 +117,218 @@ constexpr int sumsToZero(double m1, double m2, double m3) {
 }
 
 //******************************************************************************
+// Racah-formula implementation of 3j/6j symbols
+namespace helper {
+
+using LD = long double;
+
+//! Number stored as m * 2^e. Used for products/ratios of large factorials,
+//! which would otherwise overflow (or underflow) a double.
+struct Split {
+  double m{1.0};
+  int e{0};
+};
+
+//! Lookup table of factorials n!, n <= max_n, stored as (Split) m * 2^e.
+//! Formed once (thread-safe); accumulated in long double. Beyond table (n >
+//! max_n), n! is calculated from lgamma (slower); n < 0 gives NaN.
+class FactorialTable {
+public:
+  static constexpr int max_n = 1000;
+
+private:
+  std::array<double, max_n + 1> m_mantissa{};
+  std::array<int, max_n + 1> m_exponent{};
+
+  FactorialTable() {
+    LD f = 1.0L;
+    int e = 0;
+    for (int n = 0; n <= max_n; ++n) {
+      int de = 0;
+      f = std::frexp(f * (n == 0 ? 1 : n), &de);
+      e += de;
+      m_mantissa[std::size_t(n)] = double(f);
+      m_exponent[std::size_t(n)] = e;
+    }
+  }
+
+public:
+  //! Returns the (single, shared) factorial table
+  static const FactorialTable &get() {
+    static const FactorialTable table{};
+    return table;
+  }
+
+  //! Returns n! (as Split)
+  Split factorial(int n) const {
+    if (n >= 0 && n <= max_n)
+      return {m_mantissa[std::size_t(n)], m_exponent[std::size_t(n)]};
+    if (n < 0)
+      return {std::numeric_limits<double>::quiet_NaN(), 0};
+    // Outside table: log2(n!) = lgamma(n+1)/ln(2)
+    const auto log2_f = std::lgamma(LD(n) + 1.0L) / std::log(2.0L);
+    const auto e = std::floor(log2_f);
+    return {double(std::exp2(log2_f - e)), int(e)};
+  }
+
+  //! x -> x * n!
+  void mul(Split *x, int n) const {
+    const auto f = factorial(n);
+    x->m *= f.m;
+    x->e += f.e;
+  }
+  //! x -> x / n!
+  void div(Split *x, int n) const {
+    const auto f = factorial(n);
+    x->m /= f.m;
+    x->e -= f.e;
+  }
+};
+
+//! sqrt(x) for Split number
+inline Split sqrt_split(Split x) {
+  if (x.e % 2 != 0) {
+    x.m *= 2.0;
+    x.e -= 1;
+  }
+  return {std::sqrt(x.m), x.e / 2};
+}
+
+//! x -> x * Delta(abc)^2, where
+//! Delta(abc)^2 = (a+b-c)!(a-b+c)!(-a+b+c)!/(a+b+c+1)!   [2*j]
+inline void triangle_coef(const FactorialTable &fact, Split *x, int a, int b,
+                          int c) {
+  fact.mul(x, (a + b - c) / 2);
+  fact.mul(x, (a - b + c) / 2);
+  fact.mul(x, (-a + b + c) / 2);
+  fact.div(x, (a + b + c) / 2 + 1);
+}
+
+//! 3j symbol, via Racah formula. Takes 2*j, 2*m. Does not check selection
+//! rules (triangle, m's, parity) - these must be checked first
+inline double threej_racah(const FactorialTable &fact, int a, int b, int c,
+                           int ma, int mb, int mc) {
+  // pre-factor: sqrt{ Delta(abc)^2 * prod_i (j_i+m_i)!(j_i-m_i)! }
+  Split pre{};
+  triangle_coef(fact, &pre, a, b, c);
+  fact.mul(&pre, (a + ma) / 2);
+  fact.mul(&pre, (a - ma) / 2);
+  fact.mul(&pre, (b + mb) / 2);
+  fact.mul(&pre, (b - mb) / 2);
+  fact.mul(&pre, (c + mc) / 2);
+  fact.mul(&pre, (c - mc) / 2);
+  pre = sqrt_split(pre);
+
+  // sum_t (-1)^t / [t!(x1+t)!(x2+t)!(y1-t)!(y2-t)!(y3-t)!]
+  const auto x1 = (c - b + ma) / 2;
+  const auto x2 = (c - a - mb) / 2;
+  const auto y1 = (a + b - c) / 2;
+  const auto y2 = (a - ma) / 2;
+  const auto y3 = (b + mb) / 2;
+  const auto tmin = std::max({0, -x1, -x2});
+  const auto tmax = std::min({y1, y2, y3});
+  if (tmax < tmin)
+    return 0.0;
+
+  // first term (all others found from ratio to previous term)
+  fact.div(&pre, tmin);
+  fact.div(&pre, x1 + tmin);
+  fact.div(&pre, x2 + tmin);
+  fact.div(&pre, y1 - tmin);
+  fact.div(&pre, y2 - tmin);
+  fact.div(&pre, y3 - tmin);
+  // nb: long double, since terms may cancel strongly at large j
+  LD term = 1.0L, sum = 1.0L;
+  for (int t = tmin; t < tmax; ++t) {
+    term *= -(LD(y1 - t) * (y2 - t) * (y3 - t)) /
+            (LD(t + 1) * (x1 + t + 1) * (x2 + t + 1));
+    sum += term;
+  }
+
+  // phase: (-1)^{a-b-mc} * (-1)^tmin
+  const auto s = (((a - b - mc) / 2 + tmin) % 2 == 0) ? 1.0 : -1.0;
+  return s * std::ldexp(pre.m * double(sum), pre.e);
+}
+
+//! 6j symbol, via Racah formula. Takes 2*j. Does not check selection rules
+//! (triangle, parity) - these must be checked first [see sixj_zeroQ]
+inline double sixj_racah(const FactorialTable &fact, int a, int b, int c,
+                         int d, int e, int f) {
+  // pre-factor: Delta(abc)Delta(aef)Delta(dbf)Delta(dec)
+  Split pre{};
+  triangle_coef(fact, &pre, a, b, c);
+  triangle_coef(fact, &pre, a, e, f);
+  triangle_coef(fact, &pre, d, b, f);
+  triangle_coef(fact, &pre, d, e, c);
+  pre = sqrt_split(pre);
+
+  // sum_t (-1)^t (t+1)! / [(t-t1)!(t-t2)!(t-t3)!(t-t4)!(p1-t)!(p2-t)!(p3-t)!]
+  const auto t1 = (a + b + c) / 2;
+  const auto t2 = (a + e + f) / 2;
+  const auto t3 = (d + b + f) / 2;
+  const auto t4 = (d + e + c) / 2;
+  const auto p1 = (a + b + d + e) / 2;
+  const auto p2 = (b + c + e + f) / 2;
+  const auto p3 = (a + c + d + f) / 2;
+  const auto tmin = std::max({t1, t2, t3, t4});
+  const auto tmax = std::min({p1, p2, p3});
+  if (tmax < tmin)
+    return 0.0;
+
+  // first term (all others found from ratio to previous term)
+  fact.mul(&pre, tmin + 1);
+  fact.div(&pre, tmin - t1);
+  fact.div(&pre, tmin - t2);
+  fact.div(&pre, tmin - t3);
+  fact.div(&pre, tmin - t4);
+  fact.div(&pre, p1 - tmin);
+  fact.div(&pre, p2 - tmin);
+  fact.div(&pre, p3 - tmin);
+  // nb: long double, since terms may cancel strongly at large j
+  LD term = 1.0L, sum = 1.0L;
+  for (int t = tmin; t < tmax; ++t) {
+    term *= -(LD(t + 2) * (p1 - t) * (p2 - t) * (p3 - t)) /
+            (LD(t + 1 - t1) * (t + 1 - t2) * (t + 1 - t3) * (t + 1 - t4));
+    sum += term;
+  }
+
+  const auto s = (tmin % 2 == 0) ? 1.0 : -1.0;
+  return s * std::ldexp(pre.m * double(sum), pre.e);
+}
+
+} // namespace helper
+
+//******************************************************************************
+//! @brief Calculates wigner 3j symbol: takes INTEGER values, that have already
+//! multiplied by 2. Works for l and j (integer and half-integer).
+inline double threej_2(int two_j1, int two_j2, int two_j3, int two_m1,
+                       int two_m2, int two_m3) {
+  if (triangle(two_j1, two_j2, two_j3) * sumsToZero(two_m1, two_m2, two_m3) ==
+      0)
+    return 0;
+  if (!evenQ(two_j1 + two_j2 + two_j3) || !evenQ(two_j1 + two_m1) ||
+      !evenQ(two_j2 + two_m2) || !evenQ(two_j3 + two_m3))
+    return 0.0;
+  if (std::abs(two_m1) > two_j1 || std::abs(two_m2) > two_j2 ||
+      std::abs(two_m3) > two_j3)
+    return 0.0;
+  return helper::threej_racah(helper::FactorialTable::get(), two_j1, two_j2,
+                              two_j3, two_m1, two_m2, two_m3);
+}
+
+//! Batch version of threej_2: 3j symbol for each {2j1,2j2,2j3,2m1,2m2,2m3}
+//! in list
+inline std::vector<double>
+threej_2(const std::vector<std::array<int, 6>> &list) {
+  std::vector<double> out;
+  out.reserve(list.size());
+  for (const auto &[j1, j2, j3, m1, m2, m3] : list) {
+    out.push_back(threej_2(j1, j2, j3, m1, m2, m3));
+  }
+  return out;
+}
+
+//------------------------------------------------------------------------------
 //! @brief Calculates wigner 3j symbol: Works for l and j (integer and
 //! half-integer)
 /*! @details
@@ -128,7 +344,7 @@ inline double threej(double j1, double j2, double j3, double m1, double m2,
   int two_m1 = (int)round(2 * m1);
   int two_m2 = (int)round(2 * m2);
   int two_m3 = (int)round(2 * m3);
-  return gsl_sf_coupling_3j(two_j1, two_j2, two_j3, two_m1, two_m2, two_m3);
+  return threej_2(two_j1, two_j2, two_j3, two_m1, two_m2, two_m3);
 }
 
 //------------------------------------------------------------------------------
@@ -137,18 +353,7 @@ inline double threej_1(int j1, int j2, int j3, int m1, int m2, int m3)
 {
   if (triangle(j1, j2, j3) * sumsToZero(m1, m2, m3) == 0)
     return 0;
-  return gsl_sf_coupling_3j(2 * j1, 2 * j2, 2 * j3, 2 * m1, 2 * m2, 2 * m3);
-}
-
-//------------------------------------------------------------------------------
-//! @brief Calculates wigner 3j symbol: takes INTEGER values, that have already
-//! multiplied by 2. Works for l and j (integer and half-integer).
-inline double threej_2(int two_j1, int two_j2, int two_j3, int two_m1,
-                       int two_m2, int two_m3) {
-  if (triangle(two_j1, two_j2, two_j3) * sumsToZero(two_m1, two_m2, two_m3) ==
-      0)
-    return 0;
-  return gsl_sf_coupling_3j(two_j1, two_j2, two_j3, two_m1, two_m2, two_m3);
+  return threej_2(2 * j1, 2 * j2, 2 * j3, 2 * m1, 2 * m2, 2 * m3);
 }
 
 //******************************************************************************
@@ -167,7 +372,7 @@ inline double special_threej_2(int two_j1, int two_j2, int two_k) {
   // else if(two_k == 1){
   // XXX Simple formula??
   // }
-  return gsl_sf_coupling_3j(two_j1, two_j2, two_k, -1, 1, 0);
+  return threej_2(two_j1, two_j2, two_k, -1, 1, 0);
 }
 
 //******************************************************************************
@@ -191,7 +396,7 @@ inline double cg(double j1, double m1, double j2, double m2, double J, double M)
   if ((two_j1 - two_j2 + two_M) % 4 == 0)
     sign = 1; // mod 4 (instead 2), since x2
   return sign * std::sqrt(two_J + 1.) *
-         gsl_sf_coupling_3j(two_j1, two_j2, two_J, two_m1, two_m2, -two_M);
+         threej_2(two_j1, two_j2, two_J, two_m1, two_m2, -two_M);
 }
 
 //------------------------------------------------------------------------------
@@ -209,7 +414,7 @@ inline double cg_1(int j1, int m1, int j2, int m2, int J, int M)
   if ((j1 - j2 + M) % 2 == 0)
     sign = 1;
   return sign * std::sqrt(2. * J + 1.) *
-         gsl_sf_coupling_3j(2 * j1, 2 * j2, 2 * J, 2 * m1, 2 * m2, -2 * M);
+         threej_2(2 * j1, 2 * j2, 2 * J, 2 * m1, 2 * m2, -2 * M);
 }
 
 //------------------------------------------------------------------------------
@@ -227,7 +432,7 @@ inline double cg_2(int two_j1, int two_m1, int two_j2, int two_m2, int two_J,
   if ((two_j1 - two_j2 + two_M) % 4 == 0)
     sign = 1; // mod 4 (instead 2), since x2
   return sign * std::sqrt(two_J + 1.) *
-         gsl_sf_coupling_3j(two_j1, two_j2, two_J, two_m1, two_m2, -two_M);
+         threej_2(two_j1, two_j2, two_J, two_m1, two_m2, -two_M);
 }
 
 //******************************************************************************
@@ -257,6 +462,35 @@ inline bool sixj_zeroQ(int a, int b, int c, int d, int e, int f) {
 }
 
 //******************************************************************************
+//!@brief 6j symbol {j1 j2 j3 \\ j4 j5 j6}; takes 2*j (as integers)
+inline double sixj_2(int two_j1, int two_j2, int two_j3, int two_j4, int two_j5,
+                     int two_j6)
+// Calculates wigner 6j symbol:
+//   {j1 j2 j3}
+//   {j4 j5 j6}
+// Note: this function takes INTEGER values, that have already multiplied by 2!
+// Works for l and j (integer and half-integer)
+{
+  if (sixj_zeroQ(two_j1, two_j2, two_j3, two_j4, two_j5, two_j6))
+    return 0.0;
+  return helper::sixj_racah(helper::FactorialTable::get(), two_j1, two_j2,
+                            two_j3, two_j4, two_j5, two_j6);
+}
+
+//! Batch version of sixj_2: 6j symbol for each {2j1,...,2j6} in list
+inline std::vector<double> sixj_2(const std::vector<std::array<int, 6>> &list) {
+  std::vector<double> out;
+  out.reserve(list.size());
+  const auto &fact = helper::FactorialTable::get();
+  for (const auto &[j1, j2, j3, j4, j5, j6] : list) {
+    out.push_back(sixj_zeroQ(j1, j2, j3, j4, j5, j6) ?
+                      0.0 :
+                      helper::sixj_racah(fact, j1, j2, j3, j4, j5, j6));
+  }
+  return out;
+}
+
+//------------------------------------------------------------------------------
 //!@brief 6j symbol {j1 j2 j3 \\ j4 j5 j6}
 inline double sixj(double j1, double j2, double j3, double j4, double j5,
                    double j6)
@@ -278,7 +512,7 @@ inline double sixj(double j1, double j2, double j3, double j4, double j5,
   int two_j4 = (int)round(2 * j4);
   int two_j5 = (int)round(2 * j5);
   int two_j6 = (int)round(2 * j6);
-  return gsl_sf_coupling_6j(two_j1, two_j2, two_j3, two_j4, two_j5, two_j6);
+  return sixj_2(two_j1, two_j2, two_j3, two_j4, two_j5, two_j6);
 }
 
 //------------------------------------------------------------------------------
@@ -289,26 +523,46 @@ inline double sixj_1(int j1, int j2, int j3, int j4, int j5, int j6)
 // Note: this function takes INTEGER values, only works for l (not half-integer
 // j)!
 {
-  if (sixj_zeroQ(j1, j2, j3, j4, j5, j6))
-    return 0.0;
-  return gsl_sf_coupling_6j(2 * j1, 2 * j2, 2 * j3, 2 * j4, 2 * j5, 2 * j6);
+  return sixj_2(2 * j1, 2 * j2, 2 * j3, 2 * j4, 2 * j5, 2 * j6);
 }
 
-//------------------------------------------------------------------------------
-inline double sixj_2(int two_j1, int two_j2, int two_j3, int two_j4, int two_j5,
-                     int two_j6)
-// Calculates wigner 6j symbol:
+//******************************************************************************
+inline double ninej_2(int two_j1, int two_j2, int two_j3, int two_j4,
+                      int two_j5, int two_j6, int two_j7, int two_j8,
+                      int two_j9)
+// Calculates wigner 9j symbol:
 //   {j1 j2 j3}
 //   {j4 j5 j6}
+//   {j7 j8 j9}
 // Note: this function takes INTEGER values, that have already multiplied by 2!
 // Works for l and j (integer and half-integer)
+// = sum_x (-1)^{2x} [x] {j1 j2 j3 \ j6 j9 x}{j4 j5 j6 \ j2 x j8}
+//                       {j7 j8 j9 \ x j1 j4}
 {
-  if (sixj_zeroQ(two_j1, two_j2, two_j3, two_j4, two_j5, two_j6))
+  if (triangle(two_j1, two_j2, two_j3) * triangle(two_j4, two_j5, two_j6) *
+          triangle(two_j7, two_j8, two_j9) * triangle(two_j1, two_j4, two_j7) *
+          triangle(two_j2, two_j5, two_j8) * triangle(two_j3, two_j6, two_j9) ==
+      0)
     return 0.0;
-  return gsl_sf_coupling_6j(two_j1, two_j2, two_j3, two_j4, two_j5, two_j6);
+  const auto x_min = std::max({std::abs(two_j1 - two_j9),
+                               std::abs(two_j4 - two_j8),
+                               std::abs(two_j2 - two_j6)});
+  const auto x_max =
+      std::min({two_j1 + two_j9, two_j4 + two_j8, two_j2 + two_j6});
+  double sum = 0.0;
+  for (int two_x = x_min; two_x <= x_max; two_x += 2) {
+    const auto sj1 = sixj_2(two_j1, two_j2, two_j3, two_j6, two_j9, two_x);
+    if (sj1 == 0.0)
+      continue;
+    const auto sj2 = sixj_2(two_j4, two_j5, two_j6, two_j2, two_x, two_j8);
+    const auto sj3 = sixj_2(two_j7, two_j8, two_j9, two_x, two_j1, two_j4);
+    const auto s = evenQ(two_x) ? 1.0 : -1.0;
+    sum += s * (two_x + 1) * sj1 * sj2 * sj3;
+  }
+  return sum;
 }
 
-//******************************************************************************
+//------------------------------------------------------------------------------
 inline double ninej(double j1, double j2, double j3, double j4, double j5,
                     double j6, double j7, double j8, double j9)
 // Calculates wigner 9j symbol:
@@ -327,8 +581,8 @@ inline double ninej(double j1, double j2, double j3, double j4, double j5,
   int two_j7 = (int)round(2 * j7);
   int two_j8 = (int)round(2 * j8);
   int two_j9 = (int)round(2 * j9);
-  return gsl_sf_coupling_9j(two_j1, two_j2, two_j3, two_j4, two_j5, two_j6,
-                            two_j7, two_j8, two_j9);
+  return ninej_2(two_j1, two_j2, two_j3, two_j4, two_j5, two_j6, two_j7,
+                 two_j8, two_j9);
 }
 
 //------------------------------------------------------------------------------
@@ -341,23 +595,8 @@ inline double ninej_1(int j1, int j2, int j3, int j4, int j5, int j6, int j7,
 // Note: this function takes INTEGER values, only works for l (not half-integer
 // j)!
 {
-  return gsl_sf_coupling_9j(2 * j1, 2 * j2, 2 * j3, 2 * j4, 2 * j5, 2 * j6,
-                            2 * j7, 2 * j8, 2 * j9);
-}
-
-//------------------------------------------------------------------------------
-inline double ninej_2(int two_j1, int two_j2, int two_j3, int two_j4,
-                      int two_j5, int two_j6, int two_j7, int two_j8,
-                      int two_j9)
-// Calculates wigner 9j symbol:
-//   {j1 j2 j3}
-//   {j4 j5 j6}
-//   {j7 j8 j9}
-// Note: this function takes INTEGER values, that have already multiplied by 2!
-// Works for l and j (integer and half-integer)
-{
-  return gsl_sf_coupling_9j(two_j1, two_j2, two_j3, two_j4, two_j5, two_j6,
-                            two_j7, two_j8, two_j9);
+  return ninej_2(2 * j1, 2 * j2, 2 * j3, 2 * j4, 2 * j5, 2 * j6, 2 * j7,
+                 2 * j8, 2 * j9);
 }
 
 //******************************************************************************
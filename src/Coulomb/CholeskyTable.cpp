@@ -0,0 +1,236 @@
+#include "CholeskyTable.hpp"
+#include "Angular/Wigner369j.hpp"
+#include "CoulombIntegrals.hpp"
+#include "IO/ChronoTimer.hpp"
+#include "IO/SafeProfiler.hpp"
+#include "Maths/NumCalc_quadIntegrate.hpp"
+#include "Wavefunction/DiracSpinor.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+namespace Coulomb {
+
+//******************************************************************************
+void CholeskyTable::fill(const std::vector<DiracSpinor> &basis,
+                         double tolerance) {
+  [[maybe_unused]] auto sp = IO::Profile::safeProfiler(__func__);
+  IO::ChronoTimer t("CholeskyTable::fill");
+
+  m_tolerance = tolerance;
+  m_num_orbs = basis.size();
+  m_position.clear();
+  for (auto i = 0ul; i < basis.size(); ++i) {
+    const auto nk = std::size_t(basis[i].nk_index());
+    if (nk >= m_position.size())
+      m_position.resize(nk + 1, -1);
+    m_position[nk] = int(i);
+  }
+
+  const auto num_k =
+      basis.empty() ? 0ul : std::size_t(DiracSpinor::max_tj(basis) + 1);
+  m_row.assign(num_k, {});
+  m_L.assign(num_k, {});
+  m_rank.assign(num_k, 0);
+  m_tCk.assign(num_k, {});
+  m_error.assign(num_k, 0.0);
+  if (basis.empty())
+    return;
+
+  // Integration weights (incl. dr/du): integrals are then simple dot products
+  const auto w = NumCalc::integration_weights(*basis.front().rgrid);
+  for (auto k = 0ul; k < num_k; ++k) {
+    fill_k(int(k), basis, w);
+  }
+  count();
+}
+
+//******************************************************************************
+void CholeskyTable::fill_k(int k, const std::vector<DiracSpinor> &basis,
+                           const std::vector<double> &w) {
+  const auto sk = std::size_t(k);
+  const auto num_orbs = basis.size();
+
+  // 1) All pairs {a,c} (a<=c) allowed by C^k selection rules
+  std::vector<std::pair<std::size_t, std::size_t>> pairs;
+  auto &rows = m_row[sk];
+  rows.assign(num_orbs * num_orbs, -1);
+  for (auto ia = 0ul; ia < num_orbs; ++ia) {
+    for (auto ic = ia; ic < num_orbs; ++ic) {
+      if (!Angular::Ck_kk_SR(k, basis[ia].k, basis[ic].k))
+        continue;
+      rows[ia * num_orbs + ic] = int(pairs.size());
+      pairs.emplace_back(ia, ic);
+    }
+  }
+  const auto num_pairs = pairs.size();
+
+  auto &tCk = m_tCk[sk];
+  tCk.resize(num_pairs);
+  for (auto q = 0ul; q < num_pairs; ++q) {
+    const auto &[ia, ic] = pairs[q];
+    tCk[q] = Angular::tildeCk_kk(k, basis[ia].k, basis[ic].k);
+  }
+
+  // R^k_{q,bd} = \int rho_q(r) * y^k_bd(r) dr  (q = {ac})
+  const auto Rk_q = [&](std::size_t q, const std::vector<double> &ykbd) {
+    const auto &Fa = basis[pairs[q].first];
+    const auto &Fc = basis[pairs[q].second];
+    const auto i0 = std::max(Fa.min_pt(), Fc.min_pt());
+    const auto imax = std::min(Fa.max_pt(), Fc.max_pt());
+    double Rk = 0.0;
+    for (auto i = i0; i < imax; ++i) {
+      Rk += w[i] * (Fa.f(i) * Fc.f(i) + Fa.g(i) * Fc.g(i)) * ykbd[i];
+    }
+    return Rk;
+  };
+
+  // 2) Diagonal: R^k_{ac,ac}
+  std::vector<double> diag(num_pairs);
+#pragma omp parallel for
+  for (auto q = 0ul; q < num_pairs; ++q) {
+    const auto &[ia, ic] = pairs[q];
+    diag[q] = Rk_q(q, Coulomb::yk_ab(basis[ia], basis[ic], k));
+  }
+
+  // 3) Pivoted Cholesky: each step, take largest remaining diagonal as pivot
+  std::vector<std::vector<double>> Lcols;
+  while (Lcols.size() < num_pairs) {
+    const auto p_it = std::max_element(diag.cbegin(), diag.cend());
+    const auto p = std::size_t(std::distance(diag.cbegin(), p_it));
+    if (diag[p] <= m_tolerance)
+      break;
+    const auto &[ib, id] = pairs[p];
+    const auto ykbd = Coulomb::yk_ab(basis[ib], basis[id], k);
+    const auto inv_sqrt = 1.0 / std::sqrt(diag[p]);
+    std::vector<double> Lcol(num_pairs);
+#pragma omp parallel for
+    for (auto q = 0ul; q < num_pairs; ++q) {
+      auto Rqp = Rk_q(q, ykbd);
+      for (const auto &Lj : Lcols) {
+        Rqp -= Lj[q] * Lj[p];
+      }
+      Lcol[q] = Rqp * inv_sqrt;
+    }
+    for (auto q = 0ul; q < num_pairs; ++q) {
+      // nb: residual is positive semi-definite; clip rounding errors
+      diag[q] = std::max(0.0, diag[q] - Lcol[q] * Lcol[q]);
+    }
+    diag[p] = 0.0;
+    Lcols.push_back(std::move(Lcol));
+  }
+
+  // 4) Store L row-major, so R^k_abcd is a contiguous dot product
+  const auto rank = Lcols.size();
+  m_rank[sk] = rank;
+  m_error[sk] =
+      num_pairs == 0 ? 0.0 : *std::max_element(diag.cbegin(), diag.cend());
+  auto &L = m_L[sk];
+  L.resize(num_pairs * rank);
+  for (auto q = 0ul; q < num_pairs; ++q) {
+    for (auto j = 0ul; j < rank; ++j) {
+      L[q * rank + j] = Lcols[j][q];
+    }
+  }
+}
+
+//******************************************************************************
+int CholeskyTable::row(int k, const DiracSpinor &a,
+                       const DiracSpinor &c) const {
+  const auto sk = std::size_t(k);
+  const auto nka = std::size_t(a.nk_index());
+  const auto nkc = std::size_t(c.nk_index());
+  if (k < 0 || sk >= m_row.size() || nka >= m_position.size() ||
+      nkc >= m_position.size())
+    return -1;
+  const auto ia = m_position[nka];
+  const auto ic = m_position[nkc];
+  if (ia < 0 || ic < 0)
+    return -1;
+  // only stored for a <= c
+  const auto i = std::size_t(std::min(ia, ic));
+  const auto j = std::size_t(std::max(ia, ic));
+  return m_row[sk][i * m_num_orbs + j];
+}
+
+//******************************************************************************
+bool CholeskyTable::contains(int k, const DiracSpinor &a, const DiracSpinor &b,
+                             const DiracSpinor &c, const DiracSpinor &d) const {
+  return row(k, a, c) >= 0 && row(k, b, d) >= 0;
+}
+
+//******************************************************************************
+double CholeskyTable::R(int k, const DiracSpinor &a, const DiracSpinor &b,
+                        const DiracSpinor &c, const DiracSpinor &d) const {
+  const auto ac = row(k, a, c);
+  const auto bd = row(k, b, d);
+  if (ac < 0 || bd < 0)
+    return 0.0;
+  const auto sk = std::size_t(k);
+  const auto rank = m_rank[sk];
+  const auto *L_ac = m_L[sk].data() + std::size_t(ac) * rank;
+  const auto *L_bd = m_L[sk].data() + std::size_t(bd) * rank;
+  double Rk = 0.0;
+  for (auto j = 0ul; j < rank; ++j) {
+    Rk += L_ac[j] * L_bd[j];
+  }
+  return Rk;
+}
+
+//******************************************************************************
+double CholeskyTable::Q(int k, const DiracSpinor &a, const DiracSpinor &b,
+                        const DiracSpinor &c, const DiracSpinor &d) const {
+  const auto ac = row(k, a, c);
+  const auto bd = row(k, b, d);
+  if (ac < 0 || bd < 0)
+    return 0.0;
+  const auto &tCk = m_tCk[std::size_t(k)];
+  const auto m1tk = Angular::evenQ(k) ? 1.0 : -1.0;
+  return m1tk * tCk[std::size_t(ac)] * tCk[std::size_t(bd)] *
+         R(k, a, b, c, d);
+}
+
+//******************************************************************************
+double CholeskyTable::P(int k, const DiracSpinor &a, const DiracSpinor &b,
+                        const DiracSpinor &c, const DiracSpinor &d) const {
+  double Pk_abcd{0.0};
+  const auto [lmin, lmax] = k_minmax_Q(a, b, d, c); // exchange
+  for (int l = lmin; l <= lmax; l += 2) {
+    const auto ql = Q(l, a, b, d, c); // exchange
+    if (ql == 0.0)
+      continue;
+    const auto sixj = Coulomb::sixj(a, c, k, b, d, l);
+    Pk_abcd += sixj * ql;
+  }
+  Pk_abcd *= double(2 * k + 1);
+  return Pk_abcd;
+}
+
+//******************************************************************************
+double CholeskyTable::W(int k, const DiracSpinor &a, const DiracSpinor &b,
+                        const DiracSpinor &c, const DiracSpinor &d) const {
+  return Q(k, a, b, c, d) + P(k, a, b, c, d);
+}
+
+//******************************************************************************
+std::size_t CholeskyTable::bytes() const {
+  auto total = m_position.size() * sizeof(int);
+  for (auto k = 0ul; k < m_L.size(); ++k) {
+    total += m_L[k].size() * sizeof(Real) + m_tCk[k].size() * sizeof(Real) +
+             m_row[k].size() * sizeof(int);
+  }
+  return total;
+}
+
+//******************************************************************************
+void CholeskyTable::count() const {
+  std::cout << "Cholesky decomposition, tolerance: " << m_tolerance << "\n";
+  for (auto k = 0ul; k < m_rank.size(); ++k) {
+    std::cout << "k=" << k << ": rank " << m_rank[k] << "/" << m_tCk[k].size()
+              << ", max error: " << m_error[k] << "\n";
+  }
+  std::cout << "Memory: " << double(bytes()) / 1.0e6 << " MB\n";
+}
+
+} // namespace Coulomb
@@ -0,0 +1,108 @@
+#pragma once
+#include "Wavefunction/DiracSpinor.hpp"
+#include <vector>
+
+namespace Coulomb {
+
+//******************************************************************************
+/*!
+@brief
+Low-rank (pivoted Cholesky) store of Coulomb integrals. Same query interface as
+CoulombTable (Q, R, P, W), but uses O(N^2 * rank) memory rather than O(N^4).
+ @details
+For each multipolarity k, the radial integrals form a symmetric, positive
+semi-definite matrix over the orbital pairs {ac}:
+
+  R^k_{ac,bd} = \int rho_ac(r) y^k_bd(r) dr.
+
+This is decomposed using a pivoted (incomplete) Cholesky decomposition,
+R^k ~ L L^T, stopping once the largest remaining diagonal element is below the
+given tolerance. L has one row per {ac} pair, and 'rank' columns. Then:
+
+  R^k_abcd = \sum_J L_{ac,J} L_{bd,J},
+  Q^k_abcd = (-1)^k * tildeC^k_ac * tildeC^k_bd * R^k_abcd.
+
+Since the residual is also positive semi-definite, the error in any R^k_abcd
+is bounded by the largest remaining diagonal element, which is reported (and
+is below the tolerance). Only pairs allowed by the C^k selection rules are
+stored, and only for a <= c (rho_ac = rho_ca).
+
+nb: Unlike QkTable, no symmetry is imposed on {abcd}: any order may be used.
+*/
+class CholeskyTable {
+
+public:
+  //! Data type used to store integrals
+  using Real = double;
+
+private:
+  // Maps nk_index -> position of orbital in basis (-1 if not in table)
+  std::vector<int> m_position{};
+  std::size_t m_num_orbs{0};
+  // For each k: row of L for each pair (ia*num_orbs + ic, ia<=ic), -1 if none
+  std::vector<std::vector<int>> m_row{};
+  // For each k: the (row-major) Cholesky factor L, and its rank (num columns)
+  std::vector<std::vector<Real>> m_L{};
+  std::vector<std::size_t> m_rank{};
+  // For each k: tildeC^k_ac for each row of L
+  std::vector<std::vector<Real>> m_tCk{};
+  // For each k: max remaining diagonal element (bound on error in R^k)
+  std::vector<double> m_error{};
+  double m_tolerance{0.0};
+
+public:
+  CholeskyTable() {}
+  //! Constructs and decomposes. tolerance is absolute, for R^k
+  CholeskyTable(const std::vector<DiracSpinor> &basis,
+                double tolerance = 1.0e-8) {
+    fill(basis, tolerance);
+  }
+
+  //! Performs the decomposition, for all pairs of orbitals in basis, for all
+  //! possible k. tolerance is absolute, for R^k (atomic units)
+  void fill(const std::vector<DiracSpinor> &basis, double tolerance = 1.0e-8);
+
+  //! Checks if given {k,a,b,c,d} is in the table (i.e., orbitals are in the
+  //! basis, and k is allowed by angular selection rules)
+  bool contains(int k, const DiracSpinor &a, const DiracSpinor &b,
+                const DiracSpinor &c, const DiracSpinor &d) const;
+
+  //! Q^k_abcd, rebuilt from Cholesky factors. If not present, returns 0.
+  Real Q(int k, const DiracSpinor &a, const DiracSpinor &b,
+         const DiracSpinor &c, const DiracSpinor &d) const;
+
+  //! Returns 'R', defined via: R := Q / (angular_coef)
+  Real R(int k, const DiracSpinor &a, const DiracSpinor &b,
+         const DiracSpinor &c, const DiracSpinor &d) const;
+
+  //! 'Exchange-only', defined via W = Q + P
+  Real P(int k, const DiracSpinor &a, const DiracSpinor &b,
+         const DiracSpinor &c, const DiracSpinor &d) const;
+
+  //! W^k_abcd = Q^k_abcd + \sum_l [k] 6j * Q^l_abdc
+  Real W(int k, const DiracSpinor &a, const DiracSpinor &b,
+         const DiracSpinor &c, const DiracSpinor &d) const;
+
+  //! Rank of decomposition for given k (number of Cholesky vectors)
+  std::size_t rank(int k) const {
+    return std::size_t(k) < m_rank.size() ? m_rank[std::size_t(k)] : 0;
+  }
+  //! Bound on the (absolute) error of any R^k_abcd for given k
+  double error(int k) const {
+    return std::size_t(k) < m_error.size() ? m_error[std::size_t(k)] : 0.0;
+  }
+  //! Memory used by Cholesky vectors and index (in bytes)
+  std::size_t bytes() const;
+
+  //! Prints rank, error and memory for each k
+  void count() const;
+
+private:
+  // Row of L for pair {a,c} and k, or -1 if not present
+  int row(int k, const DiracSpinor &a, const DiracSpinor &c) const;
+  // Decomposition for single k
+  void fill_k(int k, const std::vector<DiracSpinor> &basis,
+              const std::vector<double> &w);
+};
+
+} // namespace Coulomb
@@ -1,4 +1,6 @@
 #pragma once
+#include "Coulomb/CholeskyTable.hpp"
 #include "Coulomb/CoulombIntegrals.hpp"
+#include "Coulomb/QkCache.hpp"
 #include "Coulomb/QkTable.hpp"
 #include "Coulomb/YkTable.hpp"
@@ -7,6 +7,8 @@
 #include "qip/Maths.hpp"
 #include "qip/Vector.hpp"
 #include <algorithm>
+#include <array>
+#include <cassert>
 #include <cmath>
 #include <functional>
 #include <vector>
@@ -130,6 +132,152 @@ void yk_ab(const DiracSpinor &Fa, const DiracSpinor &Fb, const int k,
     yk_ijk_impl<-1>(k, Fa, Fb, vabk, maxi);
 }
 
+//******************************************************************************
+template <std::size_t N>
+static inline void yk_allk_impl(const DiracSpinor &Fa, const DiracSpinor &Fb,
+                                const int k_min, double *const *ykab,
+                                const std::size_t maxi)
+// Calculates y^k_ab for the N multipolarities k = k_min, k_min+2, ...
+// Same method as yk_ijk_impl (see above), but the density (including
+// quadrature weights) is only formed once, and all k's are updated together
+// (one k per SIMD lane) in a single forward + backward sweep of the grid.
+//
+// Note: r^k is calculated exactly as in yk_ijk_impl (by repeated
+// multiplication for k<=10, std::pow otherwise), so results are identical.
+{
+  const auto &gr = *Fa.rgrid;
+  const auto du = gr.du();
+  const auto num_points = gr.num_points();
+  const auto irmax = (maxi == 0 || maxi > num_points) ? num_points : maxi;
+
+  // nb: k>10 uses std::pow in yk_ab (see above)
+  constexpr int max_k_mult = 10;
+  const auto k_max = k_min + 2 * int(N - 1);
+  const auto j_min = std::min(k_min, max_k_mult);
+
+  // x^k for each lane. nb: x^(k+2) = (x^k*x)*x is bitwise identical to
+  // qip::pow<k+2>(x)
+  const auto fill_powk = [=](double x, std::array<double, N> &xk) {
+    auto xtok = 1.0;
+    for (int j = 0; j < j_min; ++j) {
+      xtok *= x;
+    }
+    xk[0] = xtok;
+    for (auto ik = 1ul; ik < N; ++ik) {
+      xk[ik] = xk[ik - 1] * x * x;
+    }
+    if (k_max > max_k_mult) {
+      for (auto ik = 0ul; ik < N; ++ik) {
+        const auto k = k_min + 2 * int(ik);
+        if (k > max_k_mult)
+          xk[ik] = std::pow(x, k);
+      }
+    }
+  };
+
+  // Quadrature integration weights:
+  const auto w = [=](std::size_t i) {
+    if (i < NumCalc::Nquad)
+      return NumCalc::dq_inv * NumCalc::cq[i];
+    if (i < num_points - NumCalc::Nquad)
+      return 1.0;
+    return NumCalc::dq_inv * NumCalc::cq[num_points - i - 1];
+  };
+
+  const auto bmax =
+      std::min(std::min(Fa.max_pt(), Fb.max_pt()), num_points - 1);
+
+  // Form the density (with weights) once, for all k
+  const auto rho_max = std::max(irmax, bmax);
+  std::vector<double> rho(rho_max);
+  const auto &fa = Fa.f();
+  const auto &fb = Fb.f();
+  const auto &ga = Fa.g();
+  const auto &gb = Fb.g();
+  const auto &drduor = gr.drduor();
+  for (std::size_t i = 0; i < rho_max; ++i) {
+    rho[i] = (fa[i] * fb[i] + ga[i] * gb[i]) * w(i) * drduor[i];
+  }
+  const auto &r = gr.r();
+
+  std::array<double, N> Ax{}, Bx{}, xk{};
+  std::array<double *, N> yk{};
+  std::copy(ykab, ykab + N, yk.begin());
+
+  for (auto ik = 0ul; ik < N; ++ik) {
+    yk[ik][0] = 0.0;
+  }
+  for (std::size_t i = 1; i < irmax; ++i) {
+    const auto rat = r[i - 1] / r[i];
+    fill_powk(rat, xk);
+    const auto rhoi = rho[i - 1];
+#pragma omp simd
+    for (auto ik = 0ul; ik < N; ++ik) {
+      Ax[ik] = (Ax[ik] + rhoi) * (rat * xk[ik]);
+    }
+    for (auto ik = 0ul; ik < N; ++ik) {
+      yk[ik][i] = Ax[ik] * du;
+    }
+  }
+
+  for (auto i = bmax; i >= 1; --i) {
+    fill_powk(r[i - 1] / r[i], xk);
+    const auto rhoi = rho[i - 1];
+#pragma omp simd
+    for (auto ik = 0ul; ik < N; ++ik) {
+      Bx[ik] = Bx[ik] * xk[ik] + rhoi;
+    }
+    for (auto ik = 0ul; ik < N; ++ik) {
+      yk[ik][i - 1] += Bx[ik] * du;
+    }
+  }
+
+  for (auto ik = 0ul; ik < N; ++ik) {
+    std::fill(yk[ik] + irmax, yk[ik] + num_points, 0.0);
+  }
+}
+
+//------------------------------------------------------------------------------
+void yk_ab(const DiracSpinor &Fa, const DiracSpinor &Fb, const int k_min,
+           const int k_max, const std::vector<double *> &ykab,
+           const std::size_t maxi) {
+  [[maybe_unused]] auto sp = IO::Profile::safeProfiler(__func__, "allk");
+  assert(ykab.size() >= std::size_t((k_max - k_min) / 2 + 1));
+  // Lanes (number of k's) are fixed at compile time, so that the k-loops are
+  // fully unrolled/vectorised. Almost always a single pass (num_k <= 8 for
+  // j <= 15/2); otherwise, done in blocks of 8
+  constexpr int max_lanes = 8;
+  auto y = ykab.data();
+  for (int k0 = k_min; k0 <= k_max; k0 += 2 * max_lanes, y += max_lanes) {
+    const auto num_k = std::min((k_max - k0) / 2 + 1, max_lanes);
+    switch (num_k) {
+    case 1:
+      yk_allk_impl<1>(Fa, Fb, k0, y, maxi);
+      break;
+    case 2:
+      yk_allk_impl<2>(Fa, Fb, k0, y, maxi);
+      break;
+    case 3:
+      yk_allk_impl<3>(Fa, Fb, k0, y, maxi);
+      break;
+    case 4:
+      yk_allk_impl<4>(Fa, Fb, k0, y, maxi);
+      break;
+    case 5:
+      yk_allk_impl<5>(Fa, Fb, k0, y, maxi);
+      break;
+    case 6:
+      yk_allk_impl<6>(Fa, Fb, k0, y, maxi);
+      break;
+    case 7:
+      yk_allk_impl<7>(Fa, Fb, k0, y, maxi);
+      break;
+    default:
+      yk_allk_impl<8>(Fa, Fb, k0, y, maxi);
+    }
+  }
+}
+
 //******************************************************************************
 template <int k, int pm>
 static inline void Breit_abk_impl(const int l, const DiracSpinor &Fa,
@@ -273,6 +421,11 @@ double Rk_abcd(const DiracSpinor &Fa, const DiracSpinor &Fb,
 //------------------------------------------------------------------------------
 double Rk_abcd(const DiracSpinor &Fa, const DiracSpinor &Fc,
                const std::vector<double> &yk_bd) {
+  return Rk_abcd(Fa, Fc, yk_bd.data());
+}
+//------------------------------------------------------------------------------
+double Rk_abcd(const DiracSpinor &Fa, const DiracSpinor &Fc,
+               const double *yk_bd) {
   [[maybe_unused]] auto sp1 = IO::Profile::safeProfiler(__func__, "yk");
   const auto &drdu = Fa.rgrid->drdu();
   const auto i0 = std::max(Fa.min_pt(), Fc.min_pt());
@@ -304,6 +457,11 @@ DiracSpinor Rkv_bcd(const int kappa_a, const DiracSpinor &Fc,
 //------------------------------------------------------------------------------
 void Rkv_bcd(DiracSpinor *const Rkv, const DiracSpinor &Fc,
              const std::vector<double> &ykbd) {
+  Rkv_bcd(Rkv, Fc, ykbd.data());
+}
+//------------------------------------------------------------------------------
+void Rkv_bcd(DiracSpinor *const Rkv, const DiracSpinor &Fc,
+             const double *ykbd) {
   [[maybe_unused]] auto sp = IO::Profile::safeProfiler(__func__);
   Rkv->set_min_pt() = Fc.min_pt();
   Rkv->set_max_pt() = Fc.max_pt();
@@ -14,6 +14,16 @@ std::vector<double> yk_ab(const DiracSpinor &Fa, const DiracSpinor &Fb,
 void yk_ab(const DiracSpinor &Fa, const DiracSpinor &Fb, const int k,
            std::vector<double> &ykab, const std::size_t maxi = 0);
 
+//! Calculates y^k_ab for each k = k_min, k_min+2, ..., k_max in a single pass
+//! over the radial grid
+//! @details The density rho_ab is formed only once, and the k's are advanced
+//! together (in SIMD lanes). ykab[i] points to y^{k_min+2i}_ab; each must
+//! already have (at least) num_points elements. Results are identical to
+//! calling yk_ab() for each k separately.
+void yk_ab(const DiracSpinor &Fa, const DiracSpinor &Fb, const int k_min,
+           const int k_max, const std::vector<double *> &ykab,
+           const std::size_t maxi = 0);
+
 //! Breit b^k function: (0,r) and (r,inf) part stored sepperately (in/out)
 void bk_ab(const DiracSpinor &Fa, const DiracSpinor &Fb, const int k,
            std::vector<double> &b0, std::vector<double> &binf,
@@ -33,6 +43,9 @@ double Rk_abcd(const DiracSpinor &Fa, const DiracSpinor &Fb,
 //! Overload for when y^k_bd already exists [much faster]
 double Rk_abcd(const DiracSpinor &Fa, const DiracSpinor &Fc,
                const std::vector<double> &ykbd);
+//! Overload for when y^k_bd already exists (e.g., stored in YkTable)
+double Rk_abcd(const DiracSpinor &Fa, const DiracSpinor &Fc,
+               const double *ykbd);
 
 //! "Right-hand-side" R^k{v}_bcd [i.e., without Fv integral]
 DiracSpinor Rkv_bcd(const int kappa_v, const DiracSpinor &Fb,
@@ -45,6 +58,9 @@ DiracSpinor Rkv_bcd(const int kappa_v, const DiracSpinor &Fc,
 //! Overload for when spinor exists. Rkv is overwritten
 void Rkv_bcd(DiracSpinor *const Rkv, const DiracSpinor &Fc,
              const std::vector<double> &ykbd);
+//! Overload for when spinor exists, and y^k_bd stored (e.g., in YkTable)
+void Rkv_bcd(DiracSpinor *const Rkv, const DiracSpinor &Fc,
+             const double *ykbd);
 
 //******************************************************************************
 
@@ -132,6 +132,17 @@ bool Coulomb(std::ostream &obuff) {
     double del2 = helper::check_ykab_Tab(wf.basis, wf.basis, Yij);
     pass &= qip::check_value(&obuff, "Yk_ab tables", std::max(del1, del2), 0.0,
                              1.0e-17);
+
+    // Table built in several calls: should keep y^k from earlier calls
+    Coulomb::YkTable Ytmp;
+    Ytmp.calculate(core);
+    Ytmp.calculate(core, excited);
+    Ytmp.calculate(excited);
+    const auto del3 = std::max({helper::check_ykab_Tab(core, core, Ytmp),
+                                helper::check_ykab_Tab(core, excited, Ytmp),
+                                helper::check_ykab_Tab(excited, excited, Ytmp)});
+    pass &= qip::check_value(&obuff, "Yk_ab tables (extend)", del3, 0.0,
+                             1.0e-17);
   }
 
   { // Testing the Hartree Y functions formula:
@@ -320,7 +331,8 @@ UnitTest::helper::check_ykab_Tab(const std::vector<DiracSpinor> &a,
         if (y1 == nullptr) {
           std::cout << k << " " << Fa.symbol() << " " << Fb.symbol() << "\n";
         }
-        const auto del = std::abs(qip::compare(*y1, y2).first) +
+        const std::vector<double> y1v(y1, y1 + y2.size());
+        const auto del = std::abs(qip::compare(y1v, y2).first) +
                          std::abs(qip::compare(y2, y3).first);
         if (del > worst)
           worst = del;
@@ -404,11 +416,12 @@ UnitTest::helper::check_Rkabcd(const std::vector<DiracSpinor> &orbs,
             const auto r1a = Coulomb::Rk_abcd(Fa, Fb, Fc, Fd, k);
             const auto r1b = Coulomb::Rk_abcd(Fb, Fa, Fd, Fc, k);
             const auto r1c = Coulomb::Rk_abcd(Fc, Fd, Fa, Fb, k);
-            const auto r2a = Coulomb::Rk_abcd(Fa, Fc, *ybd);
-            const auto r2b = Coulomb::Rk_abcd(Fb, Fd, *yac);
-            const auto r2c = Coulomb::Rk_abcd(Fc, Fa, *ybd);
+            const auto r2a = Coulomb::Rk_abcd(Fa, Fc, ybd);
+            const auto r2b = Coulomb::Rk_abcd(Fb, Fd, yac);
+            const auto r2c = Coulomb::Rk_abcd(Fc, Fa, ybd);
             const auto r3 = Fa * Coulomb::Rkv_bcd(Fa.k, Fb, Fc, Fd, k);
-            const auto r4 = Fa * Coulomb::Rkv_bcd(Fa.k, Fc, *ybd);
+            const std::vector<double> ybd_v(ybd, ybd + Fa.rgrid->num_points());
+            const auto r4 = Fa * Coulomb::Rkv_bcd(Fa.k, Fc, ybd_v);
             const auto eps = std::max({r1a, r1b, r1c, r2a, r2b, r2c, r3, r4}) -
                              std::min({r1a, r1b, r1c, r2a, r2b, r2c, r3, r4});
 #pragma omp critical(compare_epsR)
@@ -0,0 +1,147 @@
+#include "QkCache.hpp"
+#include "Angular/CkTable.hpp"
+#include "Angular/SixJTable.hpp"
+#include "Angular/Wigner369j.hpp"
+#include "CoulombIntegrals.hpp"
+#include "Wavefunction/DiracSpinor.hpp"
+#include <iostream>
+#include <mutex>
+
+namespace Coulomb {
+
+//******************************************************************************
+double QkCache::Q(int k, const DiracSpinor &a, const DiracSpinor &b,
+                  const DiracSpinor &c, const DiracSpinor &d) const {
+  // Zero by selection rules: don't look up or store
+  const auto &Ck = m_yk->Ck();
+  if (Angular::zeroQ(Ck.get_tildeCkab(k, a.k, c.k)) ||
+      Angular::zeroQ(Ck.get_tildeCkab(k, b.k, d.k)))
+    return 0.0;
+
+  const auto sk = std::size_t(k);
+  const auto index = m_order.NormalOrder(a, b, c, d);
+  auto &shard = m_shards[shard_index(sk, index)];
+  {
+    std::shared_lock lock(shard.mutex);
+    if (sk < shard.data.size()) {
+      const auto it = shard.data[sk].find(index);
+      if (it != shard.data[sk].cend()) {
+        shard.hits.fetch_add(1, std::memory_order_relaxed);
+        return it->second;
+      }
+    }
+  }
+
+  // Not found: calculate (outside of lock), then store
+  shard.misses.fetch_add(1, std::memory_order_relaxed);
+  const auto value = m_yk->Qk(k, a, b, c, d);
+  std::unique_lock lock(shard.mutex);
+  if (sk >= shard.data.size())
+    shard.data.resize(sk + 1);
+  // nb: if another thread stored it in the meantime, keep (and return) that
+  return shard.data[sk].try_emplace(index, value).first->second;
+}
+
+//******************************************************************************
+double QkCache::R(int k, const DiracSpinor &a, const DiracSpinor &b,
+                  const DiracSpinor &c, const DiracSpinor &d) const {
+  const auto tQk = Q(k, a, b, c, d);
+  if (tQk == 0.0)
+    return 0.0;
+  const auto s = Angular::neg1pow(k);
+  const auto tCkac = Angular::tildeCk_kk(k, a.k, c.k);
+  const auto tCkbd = Angular::tildeCk_kk(k, b.k, d.k);
+  return tQk / (s * tCkac * tCkbd);
+}
+
+//******************************************************************************
+double QkCache::P(int k, const DiracSpinor &a, const DiracSpinor &b,
+                  const DiracSpinor &c, const DiracSpinor &d) const {
+  // Pk = [k] Sum_l {a,c,k,b,d,l} Q^l_abdc
+  if (Angular::triangle(a.twoj(), c.twoj(), 2 * k) == 0)
+    return 0.0;
+  if (Angular::triangle(2 * k, b.twoj(), d.twoj()) == 0)
+    return 0.0;
+
+  const auto &sixj = m_yk->SixJ();
+  double Pk_abcd{0.0};
+  const auto [lmin, lmax] = k_minmax_Q(a, b, d, c); // exchange
+  for (int l = lmin; l <= lmax; l += 2) {
+    const auto ql = Q(l, a, b, d, c); // exchange
+    if (ql == 0.0)
+      continue;
+    const auto sj =
+        sixj(a.twoj(), c.twoj(), 2 * k, b.twoj(), d.twoj(), 2 * l);
+    Pk_abcd += sj * ql;
+  }
+  Pk_abcd *= double(2 * k + 1);
+  return Pk_abcd;
+}
+
+//******************************************************************************
+double QkCache::W(int k, const DiracSpinor &a, const DiracSpinor &b,
+                  const DiracSpinor &c, const DiracSpinor &d) const {
+  return Q(k, a, b, c, d) + P(k, a, b, c, d);
+}
+
+//******************************************************************************
+bool QkCache::contains(int k, const DiracSpinor &a, const DiracSpinor &b,
+                       const DiracSpinor &c, const DiracSpinor &d) const {
+  const auto sk = std::size_t(k);
+  const auto index = m_order.NormalOrder(a, b, c, d);
+  auto &shard = m_shards[shard_index(sk, index)];
+  std::shared_lock lock(shard.mutex);
+  return sk < shard.data.size() && shard.data[sk].count(index) != 0;
+}
+
+//******************************************************************************
+std::size_t QkCache::size() const {
+  auto total = 0ul;
+  for (auto &shard : m_shards) {
+    std::shared_lock lock(shard.mutex);
+    for (const auto &data_k : shard.data) {
+      total += data_k.size();
+    }
+  }
+  return total;
+}
+
+std::size_t QkCache::hits() const {
+  auto total = 0ul;
+  for (const auto &shard : m_shards) {
+    total += shard.hits.load(std::memory_order_relaxed);
+  }
+  return total;
+}
+
+std::size_t QkCache::misses() const {
+  auto total = 0ul;
+  for (const auto &shard : m_shards) {
+    total += shard.misses.load(std::memory_order_relaxed);
+  }
+  return total;
+}
+
+//******************************************************************************
+void QkCache::clear() {
+  for (auto &shard : m_shards) {
+    shard.data.clear();
+    shard.hits = 0;
+    shard.misses = 0;
+  }
+}
+
+//******************************************************************************
+void QkCache::count() const {
+  const auto num_hits = hits();
+  const auto num_misses = misses();
+  const auto num_lookups = num_hits + num_misses;
+  std::cout << "QkCache: " << size() << " Qk stored; " << num_lookups
+            << " look-ups, " << num_hits << " hits ("
+            << (num_lookups == 0 ? 0.0
+                                 : 100.0 * double(num_hits) /
+                                       double(num_lookups))
+            << "%)\n";
+}
+
+} // namespace Coulomb
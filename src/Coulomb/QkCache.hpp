@@ -0,0 +1,112 @@
+#pragma once
+#include "QkTable.hpp"
+#include "Wavefunction/DiracSpinor.hpp"
+#include "YkTable.hpp"
+#include <array>
+#include <atomic>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace Coulomb {
+
+//******************************************************************************
+/*!
+@brief
+Thread-safe, lazily-filled (memoised) store of Q^k integrals. Same query
+interface as CoulombTable (Q, R, P, W), but each Q^k_abcd is only calculated
+(using the given YkTable) the first time it is asked for.
+ @details
+Useful when only a sparse subset of the integrals are needed, but the same ones
+are needed many times (so a full QkTable is wasteful, but calculating each
+from scratch every time is slow).
+
+Uses the Qk symmetry (see QkTable) to reduce the number stored. The integrals
+are stored in a number of 'shards': each is a hash map protected by its own
+reader/writer lock, so that many (OpenMP) threads may read and insert at the
+same time with little contention. Q^k is calculated outside of any lock; if two
+threads calculate the same integral at once, the first one stored is used.
+Integrals that are zero by angular selection rules are not stored.
+
+Number of 'hits' (found in cache) and 'misses' (had to be calculated) are
+counted; see count().
+
+nb: Like CoulombTable, orbitals are identified only by {n,kappa}: do not mix
+two orbitals with the same {n,kappa} (e.g., valence and basis states) in the
+same cache. The YkTable must outlive the cache, and must contain all required
+y^k_bd [see YkTable::Qk()]. Not copyable.
+*/
+class QkCache {
+
+public:
+  //! Data type used to store integrals
+  using Real = double;
+  using BigIndex = CoulombTable::BigIndex;
+
+private:
+  // Number of shards (power of 2)
+  static constexpr std::size_t m_num_shards = 64;
+  // Each shard on own cache line(s), to avoid false sharing
+  struct alignas(64) Shard {
+    std::shared_mutex mutex{};
+    // each vector element corresponds to a 'k'
+    std::vector<std::unordered_map<BigIndex, Real>> data{};
+    std::atomic<std::size_t> hits{0}, misses{0};
+  };
+
+  const YkTable *m_yk;
+  // Used only to form the (Qk symmetry) 'NormalOrder' index
+  QkTable m_order{};
+  mutable std::array<Shard, m_num_shards> m_shards{};
+
+public:
+  //! yk must outlive the cache
+  explicit QkCache(const YkTable &yk) : m_yk(&yk) {}
+
+  QkCache(const QkCache &) = delete;
+  QkCache &operator=(const QkCache &) = delete;
+
+  //! Returns Q^k_abcd: from cache if present, otherwise calculates (using
+  //! YkTable::Qk) and stores it. Thread safe.
+  Real Q(int k, const DiracSpinor &a, const DiracSpinor &b,
+         const DiracSpinor &c, const DiracSpinor &d) const;
+
+  //! Returns 'R', defined via: R := Q / (angular_coef)
+  Real R(int k, const DiracSpinor &a, const DiracSpinor &b,
+         const DiracSpinor &c, const DiracSpinor &d) const;
+
+  //! 'Exchange-only', defined via W = Q + P. Uses cached Q^l.
+  Real P(int k, const DiracSpinor &a, const DiracSpinor &b,
+         const DiracSpinor &c, const DiracSpinor &d) const;
+
+  //! W^k_abcd = Q^k_abcd + \sum_l [k] 6j * Q^l_abdc
+  Real W(int k, const DiracSpinor &a, const DiracSpinor &b,
+         const DiracSpinor &c, const DiracSpinor &d) const;
+
+  //! Checks if given {k,a,b,c,d} is already in the cache
+  bool contains(int k, const DiracSpinor &a, const DiracSpinor &b,
+                const DiracSpinor &c, const DiracSpinor &d) const;
+
+  //! Number of integrals currently stored
+  std::size_t size() const;
+  //! Number of look-ups that were found in the cache
+  std::size_t hits() const;
+  //! Number of look-ups that had to be calculated
+  std::size_t misses() const;
+
+  //! Removes all stored integrals, and resets hit/miss counts. Not thread safe
+  void clear();
+
+  //! Prints number stored, and hit/miss statistics
+  void count() const;
+
+private:
+  // Shard for given {k, index}: mixes bits of both, takes highest bits
+  static std::size_t shard_index(std::size_t k, BigIndex index) {
+    const auto h = (index + k * 0x632be59bd9b4e019ul) * 0x9e3779b97f4a7c15ul;
+    return h >> 58; // 64 = 2^6 shards
+  }
+  static_assert(m_num_shards == 64, "shard_index() assumes 64 shards");
+};
+
+} // namespace Coulomb
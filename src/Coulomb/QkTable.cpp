@@ -2,24 +2,118 @@
 #include "CoulombIntegrals.hpp"
 #include "IO/ChronoTimer.hpp"
 #include "IO/FRW_fileReadWrite.hpp"
+#include "IO/MappedFile.hpp"
 #include "IO/SafeProfiler.hpp"
+#include "Maths/Grid.hpp"
 #include <algorithm>
 #include <cassert>
 #include <cstring> // for memcpy
+#include <fstream>
 #include <string_view>
+#include <utility>
+
+// omp_get_thread_num() is not defined if not using -fopenmp
+#if defined(_OPENMP)
+#include <omp.h>
+#else
+#define omp_get_thread_num() 0
+#define omp_get_max_threads() 1
+#endif
 
 namespace Coulomb {
 
+namespace {
+using KeyValue = std::pair<CoulombTable::BigIndex, CoulombTable::Real>;
+
+// Sorts {key,value} list by key, and removes duplicate keys. For duplicates,
+// the first is kept
+void sort_unique(std::vector<KeyValue> *data) {
+  std::stable_sort(
+      data->begin(), data->end(),
+      [](const auto &x, const auto &y) { return x.first < y.first; });
+  const auto last =
+      std::unique(data->begin(), data->end(), [](const auto &x, const auto &y) {
+        return x.first == y.first;
+      });
+  data->erase(last, data->end());
+}
+
+// Given sorted list of keys, start[i] is position of first key with
+// (key>>48) >= i. Size is num_buckets + 1, and start.back() = keys.size()
+std::vector<uint64_t> bucket_starts(const std::vector<uint64_t> &keys) {
+  const auto num_buckets = keys.empty() ? 0ul : (keys.back() >> 48) + 1;
+  std::vector<uint64_t> start(num_buckets + 1, keys.size());
+  for (auto i = keys.size(); i-- > 0;) {
+    start[keys[i] >> 48] = i;
+  }
+  for (auto b = num_buckets; b-- > 0;) {
+    start[b] = std::min(start[b], start[b + 1]);
+  }
+  return start;
+}
+
+// Memory-mappable file format (see CoulombTable::write(fname, basis)):
+//   MappedHeader
+//   {n, kappa} for each basis orbital (int64_t)
+//   MappedKInfo for each k
+//   data: for each k: keys, values, bucket starts
+// Every entry is 8 bytes, so all data is 8-byte aligned.
+// Data is stored in native byte order; byte_order and real_size in the header
+// are used to reject files written on a machine of different architecture.
+// nb: update version number if file format changes!
+constexpr uint64_t mapped_version = 2;
+constexpr char mapped_magic[8] = {'a', 'm', 'p', 's', 'c', 'i', 'Q', 'k'};
+constexpr uint64_t mapped_byte_order = 0x0102030405060708;
+
+struct MappedHeader {
+  char magic[8];
+  uint64_t byte_order;
+  uint64_t real_size;
+  uint64_t version;
+  uint64_t symmetry;
+  uint64_t grid_hash;
+  uint64_t num_orbs;
+  uint64_t num_k;
+};
+
+// offsets are in bytes, from start of file
+struct MappedKInfo {
+  uint64_t size;
+  uint64_t num_buckets;
+  uint64_t keys;
+  uint64_t values;
+  uint64_t start;
+};
+
+// FNV-1a hash of the radial grid points (used to identify grid)
+uint64_t grid_hash(const std::vector<DiracSpinor> &basis) {
+  if (basis.empty())
+    return 0;
+  uint64_t hash = 14695981039346656037ul;
+  for (const auto r : basis.front().rgrid->r()) {
+    unsigned char bytes[sizeof(double)];
+    std::memcpy(bytes, &r, sizeof(double));
+    for (const auto b : bytes) {
+      hash ^= b;
+      hash *= 1099511628211ul;
+    }
+  }
+  return hash;
+}
+} // namespace
+
 //******************************************************************************
 void CoulombTable::count() const {
   std::cout << "Count: \n";
-  int k = 0;
   auto total = 0ul;
-  for (auto &qk : m_data) {
-    std::cout << "k=" << k << ": " << qk.size() << " [" << qk.bucket_count()
-              << "]\n";
-    total += qk.size();
-    ++k;
+  const auto num_k = std::max({m_data.size(), m_keys.size(), m_mapped.size()});
+  for (auto k = 0ul; k < num_k; ++k) {
+    const auto num_map = k < m_data.size() ? m_data[k].size() : 0ul;
+    const auto num_frozen = k < m_keys.size() ? m_keys[k].size() : 0ul;
+    const auto num_mapped = k < m_mapped.size() ? m_mapped[k].size : 0ul;
+    std::cout << "k=" << k << ": " << num_map + num_frozen + num_mapped
+              << "\n";
+    total += num_map + num_frozen + num_mapped;
   }
   std::cout << "total: " << total << " non-zero Qk\n";
 }
@@ -27,11 +121,7 @@ void CoulombTable::count() const {
 //******************************************************************************
 void CoulombTable::add(int k, const DiracSpinor &a, const DiracSpinor &b,
                        const DiracSpinor &c, const DiracSpinor &d, Real value) {
-  const auto sk = std::size_t(k);
-  if (sk >= m_data.size()) {
-    m_data.resize(sk + 1);
-  }
-  m_data.at(sk).insert({NormalOrder(a, b, c, d), value});
+  add(k, NormalOrder(a, b, c, d), value);
 }
 //----------------
 void CoulombTable::add(int k, BigIndex index, Real value) {
@@ -39,6 +129,8 @@ void CoulombTable::add(int k, BigIndex index, Real value) {
   if (sk >= m_data.size()) {
     m_data.resize(sk + 1);
   }
+  if (find(sk, index) != nullptr)
+    return;
   m_data.at(sk).insert({index, value});
 }
 
@@ -51,16 +143,22 @@ void CoulombTable::update(int k, const DiracSpinor &a, const DiracSpinor &b,
   if (sk >= m_data.size()) {
     m_data.resize(sk + 1);
   }
-  m_data.at(sk).insert_or_assign(NormalOrder(a, b, c, d), value);
+  const auto index = NormalOrder(a, b, c, d);
+  // if already in frozen arrays, update in place. nb: memory-mapped data is
+  // read-only; in that case, new value is stored in map (which takes priority)
+  if (sk < m_keys.size()) {
+    if (auto ptr = frozen_view(sk).find(index); ptr != nullptr) {
+      *const_cast<Real *>(ptr) = value;
+      return;
+    }
+  }
+  m_data.at(sk).insert_or_assign(index, value);
 }
 
 //******************************************************************************
 bool CoulombTable::contains(int k, const DiracSpinor &a, const DiracSpinor &b,
                             const DiracSpinor &c, const DiracSpinor &d) const {
-  const auto sk = std::size_t(k);
-  if (sk >= m_data.size())
-    return false;
-  return m_data.at(sk).find(NormalOrder(a, b, c, d)) != m_data.at(sk).cend();
+  return find(std::size_t(k), NormalOrder(a, b, c, d)) != nullptr;
 }
 
 //******************************************************************************
@@ -69,14 +167,97 @@ bool CoulombTable::contains(int k, const DiracSpinor &a, const DiracSpinor &b,
 //******************************************************************************
 double CoulombTable::Q(int k, const DiracSpinor &a, const DiracSpinor &b,
                        const DiracSpinor &c, const DiracSpinor &d) const {
-  const auto sk = std::size_t(k);
-  if (sk >= m_data.size())
-    return 0.0;
   // check valid k? Probably faster to lookup in table
-  const auto map_it = m_data.at(sk).find(NormalOrder(a, b, c, d));
-  if (map_it == m_data.at(sk).end())
-    return 0.0;
-  return map_it->second;
+  const auto ptr = find(std::size_t(k), NormalOrder(a, b, c, d));
+  return ptr == nullptr ? 0.0 : *ptr;
+}
+
+//******************************************************************************
+const CoulombTable::Real *CoulombTable::find(std::size_t k,
+                                             BigIndex index) const {
+  // First, check the map (this includes anything added after freezing)
+  if (k < m_data.size() && !m_data[k].empty()) {
+    const auto map_it = m_data[k].find(index);
+    if (map_it != m_data[k].cend())
+      return &map_it->second;
+  }
+  // Then, the frozen (sorted) arrays
+  if (k < m_keys.size()) {
+    if (const auto ptr = frozen_view(k).find(index); ptr != nullptr)
+      return ptr;
+  }
+  // Then, the memory-mapped file
+  if (k < m_mapped.size()) {
+    return m_mapped[k].find(index);
+  }
+  return nullptr;
+}
+
+//******************************************************************************
+CoulombTable::SortedView CoulombTable::frozen_view(std::size_t k) const {
+  const auto &start = m_key_start[k];
+  return {m_keys[k].data(), m_values[k].data(), start.data(),
+          start.empty() ? 0ul : start.size() - 1, m_keys[k].size()};
+}
+
+//******************************************************************************
+const CoulombTable::Real *
+CoulombTable::SortedView::find(BigIndex index) const {
+  const std::size_t bucket = index >> 48;
+  if (bucket >= num_buckets)
+    return nullptr;
+  // Branchless binary search for index inside bucket
+  auto pos = start[bucket];
+  auto len = start[bucket + 1] - pos;
+  if (len == 0)
+    return nullptr;
+  while (len > 1) {
+    const auto half = len / 2;
+    pos = keys[pos + half - 1] < index ? pos + half : pos;
+    len -= half;
+  }
+  return keys[pos] == index ? &values[pos] : nullptr;
+}
+
+//******************************************************************************
+void CoulombTable::freeze() {
+  m_keys.resize(std::max(m_keys.size(), m_data.size()));
+  m_values.resize(m_keys.size());
+  m_key_start.resize(m_keys.size());
+  for (auto k = 0ul; k < m_data.size(); ++k) {
+    std::vector<std::pair<BigIndex, Real>> data(m_data[k].cbegin(),
+                                                m_data[k].cend());
+    // nb: swap to actually release memory
+    std::unordered_map<BigIndex, Real>().swap(m_data[k]);
+    freeze_k(k, &data);
+  }
+}
+
+//******************************************************************************
+void CoulombTable::freeze_k(std::size_t k,
+                            std::vector<std::pair<BigIndex, Real>> *data) {
+  auto &keys = m_keys.at(k);
+  auto &values = m_values.at(k);
+
+  // existing values go first: sort_unique then keeps these
+  std::vector<KeyValue> all;
+  all.reserve(keys.size() + data->size());
+  for (auto i = 0ul; i < keys.size(); ++i) {
+    all.emplace_back(keys[i], values[i]);
+  }
+  all.insert(all.end(), data->cbegin(), data->cend());
+  std::vector<KeyValue>().swap(*data);
+  sort_unique(&all);
+
+  keys.resize(all.size());
+  values.resize(all.size());
+  keys.shrink_to_fit();
+  values.shrink_to_fit();
+  for (auto i = 0ul; i < all.size(); ++i) {
+    keys[i] = all[i].first;
+    values[i] = all[i].second;
+  }
+  m_key_start.at(k) = bucket_starts(keys);
 }
 
 //******************************************************************************
@@ -141,36 +322,49 @@ CoulombTable::BigIndex QkTable::NormalOrder_impl(Index a, Index b, Index c,
                                                  Index d) const {
   // put smallest first
   const auto min = std::min({a, b, c, d});
-  if (min == a) {
-    // options are abcd, and adcb
-    return (b < d) ? FormIndex({a, b, c, d}) : FormIndex({a, d, c, b});
-  } else if (min == b) {
-    // options are badc, and bcda
-    return (a < c) ? FormIndex({b, a, d, c}) : FormIndex({b, c, d, a});
-  } else if (min == c) {
-    // options are cbad, and cdab
-    return (b < d) ? FormIndex({c, b, a, d}) : FormIndex({c, d, a, b});
-  } else if (min == d) {
+  const auto num_min = (a == min) + (b == min) + (c == min) + (d == min);
+  if (num_min == 1) {
+    // nb: if second and fourth are equal, both options are the same
+    if (min == a) {
+      // options are abcd, and adcb
+      return (b < d) ? FormIndex({a, b, c, d}) : FormIndex({a, d, c, b});
+    } else if (min == b) {
+      // options are badc, and bcda
+      return (a < c) ? FormIndex({b, a, d, c}) : FormIndex({b, c, d, a});
+    } else if (min == c) {
+      // options are cbad, and cdab
+      return (b < d) ? FormIndex({c, b, a, d}) : FormIndex({c, d, a, b});
+    }
     // options are dabc, and dcba
     return (a < c) ? FormIndex({d, a, b, c}) : FormIndex({d, c, b, a});
   }
-  assert(false);
+  // Smallest index repeated (rare), e.g., {aabc} = {aacb}: above is not
+  // unique, so take lexicographical minimum of the equivalent orderings (same
+  // choice as above whenever that is unique)
+  return FormIndex(std::min({IndexSet{a, b, c, d}, IndexSet{a, d, c, b},
+                             IndexSet{b, a, d, c}, IndexSet{b, c, d, a},
+                             IndexSet{c, b, a, d}, IndexSet{c, d, a, b},
+                             IndexSet{d, a, b, c}, IndexSet{d, c, b, a}}));
 }
 //------------------------------------------------------------------------------
 CoulombTable::BigIndex WkTable::NormalOrder_impl(Index a, Index b, Index c,
                                                  Index d) const {
   // put smallest first
   const auto min = std::min({a, b, c, d});
-  if (min == a) {
-    return FormIndex({a, b, c, d});
-  } else if (min == b) {
-    return FormIndex({b, a, d, c});
-  } else if (min == c) {
-    return FormIndex({c, d, a, b});
-  } else if (min == d) {
+  const auto num_min = (a == min) + (b == min) + (c == min) + (d == min);
+  if (num_min == 1) {
+    if (min == a) {
+      return FormIndex({a, b, c, d});
+    } else if (min == b) {
+      return FormIndex({b, a, d, c});
+    } else if (min == c) {
+      return FormIndex({c, d, a, b});
+    }
     return FormIndex({d, c, b, a});
   }
-  assert(false);
+  // Smallest index repeated: lexicographical minimum (see QkTable)
+  return FormIndex(std::min({IndexSet{a, b, c, d}, IndexSet{b, a, d, c},
+                             IndexSet{c, d, a, b}, IndexSet{d, c, b, a}}));
 }
 
 //------------------------------------------------------------------------------
@@ -205,58 +399,174 @@ CoulombTable::IndexSet CoulombTable::UnFormIndex(const BigIndex &index) const {
 void CoulombTable::fill(const std::vector<DiracSpinor> &basis,
                         const YkTable &yk) {
   IO::ChronoTimer t("fill");
-  // assert(yk.a_is_b());
-  // const auto &basis = yk.get_a();
 
   // XXX Note: This uses 2x memory.. issue?
   // but, much faster than not!
 
-  // Allow fill in parallel, by first storing in a vector, then adding vector
-  // to map in series
-  using TMP = std::pair<BigIndex, Real>;
-  std::vector<std::vector<std::vector<TMP>>> maps_k_a;
-
-  const auto max_k = std::size_t(DiracSpinor::max_tj(basis));
-  maps_k_a.resize(max_k + 1);
-  for (auto &mk : maps_k_a) {
-    mk.resize(basis.size());
+  // Rather than testing every {a,b,c,d}, only those allowed by the C^k
+  // selection rules (parity + triangle) are enumerated. Orbitals are grouped
+  // into 'kappa blocks' (all orbitals with same kappa): the allowed k's depend
+  // only on the kappas, so are found once for each pair of blocks.
+  // For each set of four kappa blocks (and k), all Q^k_abcd in the block are
+  // calculated at once, as a single matrix product (see YkTable::Qk_block).
+  // Symmetry is used at the level of blocks: only blocks {ka,kb,kc,kd} that
+  // are in NormalOrder are calculated, and each Q^k_abcd is stored under its
+  // NormalOrder index. A block may map onto itself under some of the
+  // symmetries (when kappas repeat); then, of each set of equivalent
+  // {a,b,c,d} within the block, only one (the smallest) is stored, so every
+  // integral is stored exactly once, independent of thread scheduling.
+  // Blocks are handed out dynamically, since their sizes are very uneven.
+
+  // 1) Group orbitals into kappa blocks
+  const auto num_kappas = std::size_t(DiracSpinor::max_kindex(basis) + 1);
+  std::vector<std::vector<DiracSpinor>> kappa_blocks(num_kappas);
+  for (const auto &Fn : basis) {
+    kappa_blocks[std::size_t(Fn.k_index())].push_back(Fn);
   }
 
-  // Cannot insert into map in thread-safe manner.
-  // So, fill a std::vector safely, then insert those elements into map
-  // In order to avoid calculating equivilant Qk's twice (due to symmetry), only
-  // calculate when already in NormalOrder
-
-#pragma omp parallel for
-  for (auto i = 0ul; i < basis.size(); ++i) {
-    const auto &a = basis[i];
-    for (const auto &b : basis) {
-      for (const auto &c : basis) {
-        for (const auto &d : basis) {
+  // 2) For each pair of kappa blocks, the allowed {kmin, kmax} for C^k_ac
+  // (includes parity, so k+=2 is safe). Empty if kmin > kmax
+  std::vector<std::pair<int, int>> k_ac(num_kappas * num_kappas, {1, 0});
+  for (auto ika = 0ul; ika < num_kappas; ++ika) {
+    for (auto ikc = 0ul; ikc < num_kappas; ++ikc) {
+      if (kappa_blocks[ika].empty() || kappa_blocks[ikc].empty())
+        continue;
+      k_ac[ika * num_kappas + ikc] =
+          k_minmax(kappa_blocks[ika].front(), kappa_blocks[ikc].front());
+    }
+  }
 
+  // 3) List of all (NormalOrdered) sets of kappa blocks, with allowed k range.
+  // Symmetries of the table, as permutations of {abcd} (excluding identity)
+  using Perm = std::array<std::size_t, 4>;
+  const auto perms = symmetry_impl() == Symmetry::Qk ?
+                         std::vector<Perm>{{0, 3, 2, 1},
+                                           {1, 0, 3, 2},
+                                           {1, 2, 3, 0},
+                                           {2, 1, 0, 3},
+                                           {2, 3, 0, 1},
+                                           {3, 0, 1, 2},
+                                           {3, 2, 1, 0}} :
+                     symmetry_impl() == Symmetry::Wk ?
+                         std::vector<Perm>{{1, 0, 3, 2},
+                                           {2, 3, 0, 1},
+                                           {3, 2, 1, 0}} :
+                         std::vector<Perm>{};
+  struct BlockSet {
+    std::array<std::size_t, 4> ik; // {ka, kb, kc, kd}
+    int kmin, kmax;
+    std::vector<Perm> stab; // symmetries that map block onto itself
+  };
+  std::vector<BlockSet> block_sets;
+  for (auto ika = 0ul; ika < num_kappas; ++ika) {
+    for (auto ikb = 0ul; ikb < num_kappas; ++ikb) {
+      for (auto ikc = 0ul; ikc < num_kappas; ++ikc) {
+        const auto [kmin_ac, kmax_ac] = k_ac[ika * num_kappas + ikc];
+        if (kmin_ac > kmax_ac)
+          continue;
+        for (auto ikd = 0ul; ikd < num_kappas; ++ikd) {
+          const auto [kmin_bd, kmax_bd] = k_ac[ikb * num_kappas + ikd];
+          // parity rule: k must be even/odd for both a-c and b-d
+          if (kmin_bd > kmax_bd || (kmin_ac % 2 != kmin_bd % 2))
+            continue;
+          const auto kmin = std::max(kmin_ac, kmin_bd);
+          const auto kmax = std::min(kmax_ac, kmax_bd);
+          if (kmin > kmax)
+            continue;
           // enfore symmetry here, to avoid calculating anything twice
-          const auto ix = NormalOrder(a, b, c, d);
-          if (ix != CurrentOrder(a, b, c, d))
+          const auto ka = Index(ika), kb = Index(ikb);
+          const auto kc = Index(ikc), kd = Index(ikd);
+          if (NormalOrder_impl(ka, kb, kc, kd) != FormIndex({ka, kb, kc, kd}))
             continue;
+          const std::array<std::size_t, 4> ik{ika, ikb, ikc, ikd};
+          std::vector<Perm> stab;
+          for (const auto &p : perms) {
+            if (ik == Perm{ik[p[0]], ik[p[1]], ik[p[2]], ik[p[3]]})
+              stab.push_back(p);
+          }
+          block_sets.push_back({ik, kmin, kmax, std::move(stab)});
+        }
+      }
+    }
+  }
 
-          const auto [kmin, kmax] = k_minmax_Q(a, b, c, d);
-          for (int k = kmin; k <= kmax; k += 2) {
-            const auto yk_bd = yk.get(k, b, d);
-            if (yk_bd == nullptr)
-              continue;
-
-            const auto qk = yk.Qk(k, a, b, c, d);
-            maps_k_a[std::size_t(k)][i].emplace_back(ix, qk);
+  // Allow fill in parallel, by first storing in a vector (one for each
+  // thread), then adding vector to map in series.
+  // Cannot insert into map in thread-safe manner.
+  using TMP = std::pair<BigIndex, Real>;
+  const auto max_k = std::size_t(DiracSpinor::max_tj(basis));
+  const auto num_threads = std::size_t(omp_get_max_threads());
+  std::vector<std::vector<std::vector<TMP>>> maps_k_t(
+      max_k + 1, std::vector<std::vector<TMP>>(num_threads));
+
+  // 4) Each set of blocks is a unit of work
+#pragma omp parallel for schedule(dynamic)
+  for (auto i = 0ul; i < block_sets.size(); ++i) {
+    const auto tid = std::size_t(omp_get_thread_num());
+    const auto &[ik, kmin, kmax, stab] = block_sets[i];
+    const auto &as = kappa_blocks[ik[0]];
+    const auto &bs = kappa_blocks[ik[1]];
+    const auto &cs = kappa_blocks[ik[2]];
+    const auto &ds = kappa_blocks[ik[3]];
+    for (int k = kmin; k <= kmax; k += 2) {
+      if (yk.get(k, bs.front(), ds.front()) == nullptr)
+        continue;
+      const auto Qk = yk.Qk_block(k, as, bs, cs, ds);
+      auto &map_k = maps_k_t[std::size_t(k)][tid];
+      auto it = Qk.cbegin();
+      for (const auto &a : as) {
+        for (const auto &c : cs) {
+          for (const auto &b : bs) {
+            for (const auto &d : ds) {
+              const auto q = *it++;
+              if (!stab.empty()) {
+                // only store smallest of equivalent {a,b,c,d} in block
+                const IndexSet set{Index(a.nk_index()), Index(b.nk_index()),
+                                   Index(c.nk_index()), Index(d.nk_index())};
+                if (std::any_of(stab.cbegin(), stab.cend(), [&](auto &p) {
+                      return IndexSet{set[p[0]], set[p[1]], set[p[2]],
+                                      set[p[3]]} < set;
+                    }))
+                  continue;
+              }
+              map_k.emplace_back(NormalOrder(a, b, c, d), q);
+            }
           }
         }
       }
     }
   }
 
-  std::cout << "..\n";
-  std::cout << "Fill vector: " << t.reading_str() << std::endl;
+  auto num_tuples = 0ul;
+  for (const auto &maps_t : maps_k_t) {
+    for (const auto &k_maps : maps_t) {
+      num_tuples += k_maps.size();
+    }
+  }
+  const auto fill_time_s = t.reading_ms() / 1000.0;
+  std::cout << "Fill vector: " << t.reading_str() << " (" << block_sets.size()
+            << " blocks, " << num_tuples << " {k,a,b,c,d}, "
+            << double(num_tuples) / fill_time_s << " per second)" << std::endl;
   t.start();
-  // std::cin.get();
+
+  if (m_storage == Storage::frozen) {
+    // Any existing data is frozen first; then, new data may be merged
+    // directly into the sorted arrays (no need for map at all)
+    m_data.resize(std::max(m_data.size(), max_k + 1));
+    freeze();
+#pragma omp parallel for
+    for (auto ik = 0ul; ik <= max_k; ++ik) {
+      std::vector<std::pair<BigIndex, Real>> data_k;
+      for (auto &k_maps : maps_k_t[ik]) {
+        data_k.insert(data_k.end(), k_maps.cbegin(), k_maps.cend());
+        std::vector<TMP>().swap(k_maps);
+      }
+      freeze_k(ik, &data_k);
+    }
+    std::cout << "Freeze: " << t.lap_reading_str() << std::endl;
+    count();
+    return;
+  }
 
   // Three-step method for filling map cut down time by >4x!
 
@@ -266,8 +576,8 @@ void CoulombTable::fill(const std::vector<DiracSpinor> &basis,
   // 2) Reserve enough space in each sub-map (=> 2x speed-up!)
   for (auto ik = 0ul; ik <= max_k; ++ik) {
     auto size_k = 0ul;
-    for (auto ia = 0ul; ia < basis.size(); ++ia) {
-      size_k += maps_k_a[ik][ia].size();
+    for (const auto &k_maps : maps_k_t[ik]) {
+      size_k += k_maps.size();
     }
     m_data[ik].reserve(size_k);
   }
@@ -275,15 +585,14 @@ void CoulombTable::fill(const std::vector<DiracSpinor> &basis,
 // 3) Transfer data to map (can //-ize over k (since map is re-sized!))
 #pragma omp parallel for
   for (auto ik = 0ul; ik <= max_k; ++ik) {
-    for (const auto &k_maps : maps_k_a[ik]) {
+    for (const auto &k_maps : maps_k_t[ik]) {
       m_data[ik].insert(k_maps.begin(), k_maps.end());
     }
-    maps_k_a[ik].clear(); // can clear vector here to "save" memory..
+    maps_k_t[ik].clear(); // can clear vector here to "save" memory..
   }
 
   std::cout << "Fill map: " << t.lap_reading_str() << std::endl;
   count();
-  // std::cin.get();
 }
 
 //******************************************************************************
@@ -292,12 +601,21 @@ void CoulombTable::write(const std::string &fname) const {
   const auto rw = IO::FRW::write;
   IO::FRW::open_binary(f, fname, rw);
 
-  auto size = m_data.size();
+  auto size = std::max(m_data.size(), m_keys.size());
   rw_binary(f, rw, size);
-  for (const auto &Q_k : m_data) {
-    auto size_k = Q_k.size();
+  for (auto k = 0ul; k < size; ++k) {
+    const auto num_frozen = k < m_keys.size() ? m_keys[k].size() : 0ul;
+    const auto num_map = k < m_data.size() ? m_data[k].size() : 0ul;
+    auto size_k = num_frozen + num_map;
     rw_binary(f, rw, size_k);
-    for (auto [key, value] : Q_k) {
+    for (auto i = 0ul; i < num_frozen; ++i) {
+      auto key_copy = m_keys[k][i]; // have no pass non-const reference!
+      auto value_copy = m_values[k][i];
+      rw_binary(f, rw, key_copy, value_copy);
+    }
+    if (num_map == 0)
+      continue;
+    for (auto [key, value] : m_data[k]) {
       auto key_copy = key; // have no pass non-const reference!
       rw_binary(f, rw, key_copy, value);
     }
@@ -328,6 +646,158 @@ bool CoulombTable::read(const std::string &fname) {
       Q_k[key] = value;
     }
   }
+  if (m_storage == Storage::frozen)
+    freeze();
+  return true;
+}
+
+//******************************************************************************
+void CoulombTable::write(const std::string &fname,
+                         const std::vector<DiracSpinor> &basis) const {
+  // Collect all data (map, frozen, and mapped) into sorted arrays for each k
+  // The map takes priority (see find()), so goes first
+  const auto num_k = std::max({m_data.size(), m_keys.size(), m_mapped.size()});
+  std::vector<std::vector<BigIndex>> keys(num_k);
+  std::vector<std::vector<Real>> values(num_k);
+  std::vector<std::vector<uint64_t>> starts(num_k);
+  for (auto k = 0ul; k < num_k; ++k) {
+    std::vector<KeyValue> all;
+    if (k < m_data.size())
+      all.insert(all.end(), m_data[k].cbegin(), m_data[k].cend());
+    const auto views = {k < m_keys.size() ? frozen_view(k) : SortedView{},
+                        k < m_mapped.size() ? m_mapped[k] : SortedView{}};
+    for (const auto &view : views) {
+      for (auto i = 0ul; i < view.size; ++i) {
+        all.emplace_back(view.keys[i], view.values[i]);
+      }
+    }
+    sort_unique(&all);
+    keys[k].reserve(all.size());
+    values[k].reserve(all.size());
+    for (const auto &[key, value] : all) {
+      keys[k].push_back(key);
+      values[k].push_back(value);
+    }
+    starts[k] = bucket_starts(keys[k]);
+  }
+
+  MappedHeader header{};
+  std::memcpy(header.magic, mapped_magic, sizeof(mapped_magic));
+  header.byte_order = mapped_byte_order;
+  header.real_size = sizeof(Real);
+  header.version = mapped_version;
+  header.symmetry = static_cast<uint64_t>(symmetry_impl());
+  header.grid_hash = grid_hash(basis);
+  header.num_orbs = basis.size();
+  header.num_k = num_k;
+
+  std::vector<int64_t> orbs;
+  for (const auto &Fn : basis) {
+    orbs.push_back(Fn.n);
+    orbs.push_back(Fn.k);
+  }
+
+  std::vector<MappedKInfo> info(num_k);
+  auto offset = sizeof(MappedHeader) + orbs.size() * sizeof(int64_t) +
+                num_k * sizeof(MappedKInfo);
+  for (auto k = 0ul; k < num_k; ++k) {
+    info[k].size = keys[k].size();
+    info[k].num_buckets = starts[k].size() - 1;
+    info[k].keys = offset;
+    offset += keys[k].size() * sizeof(BigIndex);
+    info[k].values = offset;
+    offset += values[k].size() * sizeof(Real);
+    info[k].start = offset;
+    offset += starts[k].size() * sizeof(uint64_t);
+  }
+
+  std::ofstream f(fname, std::ios::binary);
+  if (!f.good()) {
+    std::cerr << "\nFAIL in CoulombTable::write: could not open " << fname
+              << " for writing\n";
+    std::abort();
+  }
+  const auto write_raw = [&f](const auto *data, std::size_t count) {
+    f.write(reinterpret_cast<const char *>(data),
+            static_cast<std::streamsize>(count * sizeof(*data)));
+  };
+  write_raw(&header, 1);
+  write_raw(orbs.data(), orbs.size());
+  write_raw(info.data(), info.size());
+  for (auto k = 0ul; k < num_k; ++k) {
+    write_raw(keys[k].data(), keys[k].size());
+    write_raw(values[k].data(), values[k].size());
+    write_raw(starts[k].data(), starts[k].size());
+  }
+  f.flush();
+  if (!f.good()) {
+    std::cerr << "\nFAIL in CoulombTable::write: error writing " << fname
+              << " (disk full?)\n";
+    std::abort();
+  }
+}
+
+//******************************************************************************
+bool CoulombTable::map(const std::string &fname,
+                       const std::vector<DiracSpinor> &basis) {
+  auto file = std::make_shared<const IO::MappedFile>(fname);
+  if (!file->is_open() || file->size() < sizeof(MappedHeader))
+    return false;
+
+  const auto reject = [&fname](const std::string &reason) {
+    std::cout << "Coulomb table " << fname << " not used: " << reason << "\n";
+    return false;
+  };
+
+  MappedHeader header;
+  std::memcpy(&header, file->data(), sizeof(MappedHeader));
+  if (std::memcmp(header.magic, mapped_magic, sizeof(mapped_magic)) != 0)
+    return reject("not a Coulomb table file");
+  if (header.byte_order != mapped_byte_order ||
+      header.real_size != sizeof(Real))
+    return reject("written on machine with different architecture");
+  if (header.version != mapped_version)
+    return reject("file version " + std::to_string(header.version) +
+                  ", expected " + std::to_string(mapped_version));
+  if (header.symmetry != static_cast<uint64_t>(symmetry_impl()))
+    return reject("different symmetry");
+  if (header.grid_hash != grid_hash(basis))
+    return reject("different radial grid");
+  if (header.num_orbs != basis.size())
+    return reject("different basis");
+
+  const auto orbs_offset = sizeof(MappedHeader);
+  const auto info_offset = orbs_offset + 2 * basis.size() * sizeof(int64_t);
+  const auto data_offset = info_offset + header.num_k * sizeof(MappedKInfo);
+  if (file->size() < data_offset)
+    return reject("file is truncated");
+
+  std::vector<int64_t> orbs(2 * basis.size());
+  std::memcpy(orbs.data(), file->data() + orbs_offset,
+              orbs.size() * sizeof(int64_t));
+  for (auto i = 0ul; i < basis.size(); ++i) {
+    if (orbs[2 * i] != basis[i].n || orbs[2 * i + 1] != basis[i].k)
+      return reject("different basis");
+  }
+
+  std::vector<MappedKInfo> info(header.num_k);
+  std::memcpy(info.data(), file->data() + info_offset,
+              info.size() * sizeof(MappedKInfo));
+
+  std::vector<SortedView> mapped;
+  for (const auto &ki : info) {
+    if (ki.start + (ki.num_buckets + 1) * sizeof(uint64_t) > file->size())
+      return reject("file is truncated");
+    // All data is 8-byte aligned in file (and mmap is page-aligned)
+    const auto at = [&file](uint64_t offset) { return file->data() + offset; };
+    mapped.push_back({reinterpret_cast<const BigIndex *>(at(ki.keys)),
+                      reinterpret_cast<const Real *>(at(ki.values)),
+                      reinterpret_cast<const uint64_t *>(at(ki.start)),
+                      ki.num_buckets, ki.size});
+  }
+
+  m_mapped = std::move(mapped);
+  m_file = std::move(file);
   return true;
 }
 
@@ -2,13 +2,22 @@
 #include "Wavefunction/DiracSpinor.hpp"
 #include "YkTable.hpp"
 #include <array>
+#include <memory>
 #include <unordered_map>
 
+namespace IO {
+class MappedFile;
+}
+
 namespace Coulomb {
 
 // ! Symmetry (state index order) for tables.
 enum class Symmetry { Qk, Wk, none };
 
+//! Storage used by tables. hash: std::unordered_map (default). frozen: sorted
+//! flat arrays - much more compact and faster lookup, best once table is filled
+enum class Storage { hash, frozen };
+
 //******************************************************************************
 /*!
 @brief
@@ -27,6 +36,27 @@ question.
  Two options (second and fourth may be swapped): choose 2nd to be smallest
  Wk symmetry:
  {abcd} = badc = cdab = dcba
+
+ Storage:
+ With Storage::hash (default), integrals are kept in std::unordered_map.
+ With Storage::frozen, after fill() or read(), the integrals are instead kept
+ in sorted arrays of keys (with corresponding array of values), which are
+ searched with binary search (only within a 'bucket' of keys that share their
+ highest 16 bits, so that only a short range is searched). This uses ~3x less
+ memory than the map, and lookups are more cache friendly. Values may still be
+ added/updated after freezing (they are kept in the map until the next call to
+ freeze()).
+
+ File formats:
+ write(fname)/read(fname) store a simple list of {key, value} pairs, which are
+ inserted into the table on reading. write(fname, basis)/map(fname, basis)
+ instead use a versioned format that stores the (frozen) sorted arrays directly,
+ along with the basis {n,kappa} list and a hash of the radial grid. This file
+ is memory-mapped (read-only, shared), and queried directly with no parsing or
+ copying; many processes using the same file share the same memory. A file
+ from a different basis/grid/symmetry/version is rejected. The data is stored
+ in native byte order, so the file is only usable on machines of the same
+ architecture (byte order and sizeof(double)); other files are rejected.
 */
 class CoulombTable {
 
@@ -41,16 +71,49 @@ public:
   using IndexSet = std::array<Index, 4>;
 
 private:
+  Storage m_storage;
   // each vector element corresponds to a 'k'
   std::vector<std::unordered_map<BigIndex, Real>> m_data{};
+  // 'frozen' data: for each k, sorted keys and the corresponding values
+  std::vector<std::vector<BigIndex>> m_keys{};
+  std::vector<std::vector<Real>> m_values{};
+  // For each k, position of first key with given highest 16 bits of key
+  // (i.e., bucket), such that only small range of keys need be searched
+  std::vector<std::vector<uint64_t>> m_key_start{};
+
+  // Non-owning view of sorted (frozen) data for single k
+  struct SortedView {
+    const BigIndex *keys{nullptr};
+    const Real *values{nullptr};
+    const uint64_t *start{nullptr};
+    std::size_t num_buckets{0};
+    std::size_t size{0};
+    // Returns pointer to value, or nullptr if not found
+    const Real *find(BigIndex index) const;
+  };
+  // Memory-mapped data (see map()): a view into the mapped file for each k
+  std::vector<SortedView> m_mapped{};
+  std::shared_ptr<const IO::MappedFile> m_file{nullptr};
 
 public:
+  //! Storage type (hash map or frozen sorted arrays) chosen at construction
+  explicit CoulombTable(Storage storage = Storage::hash)
+      : m_storage(storage) {}
+
   // 'Rule of zero' (except virtual destructor)
   virtual ~CoulombTable() = default;
 
-  //! Gives arrow access to all underlying vector<unordered_map> functions
+  //! Gives arrow access to all underlying vector<unordered_map> functions.
+  //! nb: for frozen table, these are only those added after freezing
   auto operator-> () { return &m_data; }
 
+  //! Storage type used by table
+  Storage storage() const { return m_storage; }
+
+  //! Moves all integrals from the map into sorted (frozen) arrays. Called
+  //! automatically by fill() and read() for Storage::frozen tables.
+  void freeze();
+
   //! For testing: prints details of coulomb integrals stored
   void count() const;
 
@@ -108,6 +171,29 @@ public:
   //! Reads coulomb integrals to disk. Returns false if none read in
   bool read(const std::string &fname);
 
+  //! Writes coulomb integrals to disk, in versioned format that can be memory
+  //! mapped by map(). basis should be that used to fill the table; it is used
+  //! only to identify the file. Aborts if file cannot be written.
+  void write(const std::string &fname,
+             const std::vector<DiracSpinor> &basis) const;
+  //! Memory-maps file written by write(fname, basis); integrals are then read
+  //! directly from the (shared, read-only) mapping, with no parsing/copying.
+  //! Returns false (and table unchanged) if file cannot be read, or if it was
+  //! written for a different basis/grid/symmetry, by another version, or on a
+  //! machine with different byte order or sizeof(double).
+  bool map(const std::string &fname, const std::vector<DiracSpinor> &basis);
+
+private:
+  // Returns pointer to stored value, or nullptr if not in table
+  const Real *find(std::size_t k, BigIndex index) const;
+
+  // Sorted view of the (owned) frozen arrays for given k
+  SortedView frozen_view(std::size_t k) const;
+
+  // Merges {key,value} pairs into the frozen arrays for given k, and clears
+  // input. Keys already present are not overwritten.
+  void freeze_k(std::size_t k, std::vector<std::pair<BigIndex, Real>> *data);
+
 protected:
   // Creates single 'BigIndex', WITHOUT accounting for 'NormalOrder'. Can be
   // used to check if {a,b,c,d} are already in 'NormalOrder'
@@ -124,6 +210,9 @@ protected:
   // derived classes.
   virtual BigIndex NormalOrder_impl(Index a, Index b, Index c,
                                     Index d) const = 0;
+
+  // Virtual: returns the symmetry of the table (used to check files)
+  virtual Symmetry symmetry_impl() const = 0;
 };
 
 //******************************************************************************
@@ -132,11 +221,13 @@ protected:
 class QkTable : public CoulombTable {
 
 public:
+  using CoulombTable::CoulombTable;
   static constexpr Symmetry symmetry = Symmetry::Qk;
 
 private:
   virtual BigIndex NormalOrder_impl(Index a, Index b, Index c,
                                     Index d) const override final;
+  virtual Symmetry symmetry_impl() const override final { return symmetry; }
 };
 
 //******************************************************************************
@@ -144,11 +235,13 @@ private:
 class WkTable : public CoulombTable {
 
 public:
+  using CoulombTable::CoulombTable;
   static constexpr Symmetry symmetry = Symmetry::Wk;
 
 private:
   virtual BigIndex NormalOrder_impl(Index a, Index b, Index c,
                                     Index d) const override final;
+  virtual Symmetry symmetry_impl() const override final { return symmetry; }
 };
 
 //******************************************************************************
@@ -156,11 +249,13 @@ private:
 class NkTable : public CoulombTable {
 
 public:
+  using CoulombTable::CoulombTable;
   static constexpr Symmetry symmetry = Symmetry::none;
 
 private:
   virtual BigIndex NormalOrder_impl(Index a, Index b, Index c,
                                     Index d) const override final;
+  virtual Symmetry symmetry_impl() const override final { return symmetry; }
 };
 
 } // namespace Coulomb
@@ -1,10 +1,15 @@
 #pragma once
+#include "Coulomb/CholeskyTable.hpp"
 #include "Coulomb/CoulombIntegrals.hpp"
+#include "Coulomb/QkCache.hpp"
 #include "Coulomb/QkTable.hpp"
 #include "Coulomb/YkTable.hpp"
 #include "IO/ChronoTimer.hpp"
 #include "Wavefunction/Wavefunction.hpp"
 #include "qip/Check.hpp"
+#include <algorithm>
+#include <array>
+#include <fstream>
 #include <random>
 
 namespace UnitTest {
@@ -104,6 +109,215 @@ bool QkTable(std::ostream &obuff) {
 
   pass &= qip::check(&obuff, "QkTable: timing", tab_time < dir_time, true);
 
+  {
+    // 'Frozen' table (sorted arrays) should give identical results
+    Coulomb::QkTable qk_f(Coulomb::Storage::frozen);
+    qk_f.read(fname);
+    double max_dev = 0.0;
+    double fro_time = 0.0;
+    double map_time = 0.0;
+    for (const auto &a : wf.basis) {
+      for (const auto &b : wf.basis) {
+        for (const auto &c : wf.basis) {
+          for (const auto &d : wf.basis) {
+            const auto [kmin, kmax] = Coulomb::k_minmax_Q(a, b, c, d);
+            for (int k = kmin; k <= kmax; k += 2) {
+              const auto dev = std::abs(qk_f.Q(k, a, b, c, d) -
+                                        qk_t.Q(k, a, b, c, d));
+              max_dev = std::max(dev, max_dev);
+            }
+          }
+        }
+      }
+    }
+    for (auto *table : {&qk_f, &qk_t}) {
+      IO::ChronoTimer t("Lookup");
+      double sum = 0.0;
+#pragma omp parallel for reduction(+ : sum)
+      for (auto ia = 0ul; ia < wf.basis.size(); ++ia) {
+        const auto &a = wf.basis[ia];
+        for (const auto &b : wf.basis) {
+          for (const auto &c : wf.basis) {
+            for (const auto &d : wf.basis) {
+              const auto [kmin, kmax] = Coulomb::k_minmax_Q(a, b, c, d);
+              for (int k = kmin; k <= kmax; k += 2) {
+                sum += table->Q(k, a, b, c, d);
+              }
+            }
+          }
+        }
+      }
+      std::cout << "sum=" << sum << "\n";
+      (table == &qk_f ? fro_time : map_time) = t.reading_ms();
+    }
+    std::cout << "frozen/hash: " << fro_time << "/" << map_time << "\n";
+    pass &= qip::check_value(&obuff, "QkTable: frozen", max_dev, 0.0, 0.0);
+  }
+
+  {
+    // Memory-mapped table: identical results, and rejects wrong basis
+    const std::string fname_map = "tmp_delete_me.qkmap";
+    qk_t.write(fname_map, wf.basis);
+    Coulomb::QkTable qk_m;
+    const auto mapped = qk_m.map(fname_map, wf.basis);
+    double max_dev = 0.0;
+    for (const auto &a : wf.basis) {
+      for (const auto &b : wf.basis) {
+        for (const auto &c : wf.basis) {
+          for (const auto &d : wf.basis) {
+            const auto [kmin, kmax] = Coulomb::k_minmax_Q(a, b, c, d);
+            for (int k = kmin; k <= kmax; k += 2) {
+              const auto dev = std::abs(qk_m.Q(k, a, b, c, d) -
+                                        qk_t.Q(k, a, b, c, d));
+              max_dev = std::max(dev, max_dev);
+            }
+          }
+        }
+      }
+    }
+    pass &= qip::check(&obuff, "QkTable: map", mapped, true);
+    pass &= qip::check_value(&obuff, "QkTable: mapped", max_dev, 0.0, 0.0);
+
+    auto basis2 = wf.basis;
+    basis2.pop_back();
+    Coulomb::QkTable qk_x;
+    Coulomb::WkTable wk_x;
+    const auto stale = qk_x.map(fname_map, basis2) ||
+                       wk_x.map(fname_map, wf.basis) ||
+                       qk_x.map(fname, wf.basis);
+    pass &= qip::check(&obuff, "QkTable: map stale", stale, false);
+
+    // File from machine with different byte order: swap the byte_order field
+    // (directly after 8-byte magic) in a copy of the file
+    const std::string fname_swap = "tmp_delete_me_swap.qkmap";
+    {
+      std::ifstream in(fname_map, std::ios::binary);
+      std::ofstream out(fname_swap, std::ios::binary);
+      out << in.rdbuf();
+    }
+    {
+      std::fstream io(fname_swap,
+                      std::ios::in | std::ios::out | std::ios::binary);
+      std::array<char, 8> bytes;
+      io.seekg(8);
+      io.read(bytes.data(), 8);
+      std::reverse(bytes.begin(), bytes.end());
+      io.seekp(8);
+      io.write(bytes.data(), 8);
+    }
+    Coulomb::QkTable qk_s;
+    pass &= qip::check(&obuff, "QkTable: map byte order",
+                       qk_s.map(fname_swap, wf.basis), false);
+  }
+
+  {
+    // Batched (matrix product) Q^k for blocks of orbitals vs. Qk
+    std::vector<DiracSpinor> s_orbs, p_orbs;
+    for (const auto &Fn : wf.basis) {
+      if (Fn.k == -1)
+        s_orbs.push_back(Fn);
+      if (Fn.k == 1)
+        p_orbs.push_back(Fn);
+    }
+    double max_dev = 0.0;
+    for (int k = 0; k <= 1; ++k) {
+      // {a,b,c,d} = {s,p,s,p} (k=0) and {s,p,p,s} (k=1)
+      const auto &cs = k == 0 ? s_orbs : p_orbs;
+      const auto &ds = k == 0 ? p_orbs : s_orbs;
+      const auto Qk = yk.Qk_block(k, s_orbs, p_orbs, cs, ds);
+      auto it = Qk.cbegin();
+      for (const auto &a : s_orbs) {
+        for (const auto &c : cs) {
+          for (const auto &b : p_orbs) {
+            for (const auto &d : ds) {
+              const auto dev = std::abs(*it++ - yk.Qk(k, a, b, c, d));
+              max_dev = std::max(dev, max_dev);
+            }
+          }
+        }
+      }
+    }
+    pass &=
+        qip::check_value(&obuff, "YkTable: Qk_block", max_dev, 0.0, 1.0e-13);
+  }
+
+  {
+    // Low-rank (Cholesky) store: check vs. direct, for a sub-set of basis.
+    // Error in R^k is bounded by the tolerance
+    std::vector<DiracSpinor> sub_basis;
+    for (const auto &Fn : wf.basis) {
+      if (Fn.n <= 6)
+        sub_basis.push_back(Fn);
+    }
+    const double tol = 1.0e-10;
+    const Coulomb::CholeskyTable ch(sub_basis, tol);
+
+    std::mt19937 gen(17);
+    std::uniform_int_distribution<std::size_t> rindex(0, sub_basis.size() - 1);
+    double max_devR = 0.0, max_devQ = 0.0;
+    for (int tries = 0; tries < 5000; ++tries) {
+      const auto &a = sub_basis[rindex(gen)];
+      const auto &b = sub_basis[rindex(gen)];
+      const auto &c = sub_basis[rindex(gen)];
+      const auto &d = sub_basis[rindex(gen)];
+      const auto [kmin, kmax] = Coulomb::k_minmax_Q(a, b, c, d);
+      for (int k = kmin; k <= kmax; k += 2) {
+        const auto devR =
+            std::abs(ch.R(k, a, b, c, d) - Coulomb::Rk_abcd(a, b, c, d, k));
+        const auto devQ =
+            std::abs(ch.Q(k, a, b, c, d) - qk_t.Q(k, a, b, c, d));
+        max_devR = std::max(max_devR, devR);
+        max_devQ = std::max(max_devQ, devQ);
+      }
+    }
+    pass &= qip::check_value(&obuff, "Cholesky: R", max_devR, 0.0, tol);
+    pass &= qip::check_value(&obuff, "Cholesky: Q", max_devQ, 0.0, 10.0 * tol);
+  }
+
+  {
+    // Lazy (memoised) cache: filled in parallel; compare to table and direct.
+    // Second pass should find every (non-zero) Q in cache
+    const Coulomb::QkCache qc(yk);
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<std::size_t> rindex(0, wf.basis.size() - 1);
+    std::vector<std::array<std::size_t, 4>> quartets(5000);
+    for (auto &[ia, ib, ic, id] : quartets) {
+      ia = rindex(gen);
+      ib = rindex(gen);
+      ic = rindex(gen);
+      id = rindex(gen);
+    }
+    std::vector<double> devQ(quartets.size()), devP(quartets.size());
+    std::size_t first_misses = 0;
+    for (int pass_num = 0; pass_num < 2; ++pass_num) {
+#pragma omp parallel for
+      for (auto i = 0ul; i < quartets.size(); ++i) {
+        const auto &a = wf.basis[quartets[i][0]];
+        const auto &b = wf.basis[quartets[i][1]];
+        const auto &c = wf.basis[quartets[i][2]];
+        const auto &d = wf.basis[quartets[i][3]];
+        const auto [kmin, kmax] = Coulomb::k_minmax_Q(a, b, c, d);
+        for (int k = kmin; k <= kmax; k += 2) {
+          devQ[i] = std::max(devQ[i], std::abs(qc.Q(k, a, b, c, d) -
+                                               qk_t.Q(k, a, b, c, d)));
+          devP[i] = std::max(devP[i], std::abs(qc.P(k, a, b, c, d) -
+                                               yk.Pk(k, a, b, c, d)));
+        }
+      }
+      if (pass_num == 0)
+        first_misses = qc.misses();
+    }
+    qc.count();
+    pass &= qip::check_value(&obuff, "QkCache: Q",
+                             *std::max_element(devQ.cbegin(), devQ.cend()),
+                             0.0, 1.0e-13);
+    pass &= qip::check_value(&obuff, "QkCache: P",
+                             *std::max_element(devP.cbegin(), devP.cend()),
+                             0.0, 1.0e-13);
+    pass &= qip::check(&obuff, "QkCache: 2nd pass all hits",
+                       qc.misses() == first_misses && qc.hits() > 0, true);
+  }
+
   {
 
     // Test number of random instances of Q,P,R,W against direct way:
@@ -2,9 +2,13 @@
 #include "Angular/CkTable.hpp"
 #include "Angular/SixJTable.hpp"
 #include "Coulomb/CoulombIntegrals.hpp"
+#include "IO/SafeProfiler.hpp"
+#include "Maths/Grid.hpp"
+#include "Maths/NumCalc_quadIntegrate.hpp"
 #include "Wavefunction/DiracSpinor.hpp"
-#include <cstdint>
-#include <unordered_map>
+#include <algorithm>
+#include <cassert>
+#include <gsl/gsl_blas.h>
 #include <vector>
 
 namespace Coulomb {
@@ -34,11 +38,14 @@ void YkTable::calculate(const std::vector<DiracSpinor> &a_orbs,
       if (a_is_b && b > a)
         continue;
       const auto [k0, kI] = k_minmax(a, b);
+      if (kI < k0)
+        continue;
+      // Calculate all k for this pair at once (only forms rho_ab once)
+      std::vector<double *> yks;
       for (auto k = k0; k <= kI; k += 2) {
-        // auto &ykab = get_or_insert(std::size_t(k), ab_key(a, b));
-        auto &ykab = get_ref(k, a, b);
-        Coulomb::yk_ab(a, b, k, ykab);
+        yks.push_back(arena() + offset(k, a, b));
       }
+      Coulomb::yk_ab(a, b, k0, kI, yks);
     }
   }
 }
@@ -55,66 +62,80 @@ void YkTable::allocate_space(const std::vector<DiracSpinor> &a_orbs,
 
   const auto a_is_b = (&a_orbs == &b_orbs);
 
+  // Assign each new orbital (in either set) a position in the table.
+  // nb: orbitals (and y^k functions) from previous calls are kept
+  const auto prev_num_orbs = m_num_orbs;
+  const auto prev_num_k = m_num_k;
+  for (const auto *orbs : {&a_orbs, &b_orbs}) {
+    for (const auto &Fa : *orbs) {
+      const auto nk = std::size_t(Fa.nk_index());
+      if (nk >= m_position.size())
+        m_position.resize(nk + 1, -1);
+      if (m_position[nk] < 0)
+        m_position[nk] = int(m_num_orbs++);
+      m_num_k = std::max(m_num_k, std::size_t(Fa.twoj() + 1));
+    }
+  }
+
+  constexpr auto block_size = sizeof(Block) / sizeof(double);
+  if (m_arena.empty()) {
+    m_num_points = a_orbs.empty() ? 0 : a_orbs.front().rgrid->num_points();
+    // round up, so each y^k_ab begins on a new (aligned) block
+    m_stride = block_size * ((m_num_points + block_size - 1) / block_size);
+  }
+
+  // If dimensions changed, re-index the existing offsets (0 for new ones).
+  // Offset 0 is reserved for the 'zero' function
+  if (m_num_orbs != prev_num_orbs || m_num_k != prev_num_k) {
+    std::vector<std::size_t> offsets(m_num_orbs * m_num_orbs * m_num_k, 0);
+    for (auto ia = 0ul; ia < prev_num_orbs; ++ia) {
+      for (auto ib = 0ul; ib < prev_num_orbs; ++ib) {
+        for (auto k = 0ul; k < prev_num_k; ++k) {
+          offsets[index(ia, ib, int(k))] =
+              m_offset[(ia * prev_num_orbs + ib) * prev_num_k + k];
+        }
+      }
+    }
+    m_offset = std::move(offsets);
+  }
+
+  const auto prev_size = m_arena.size() * block_size;
+  auto next_offset = m_arena.empty() ? m_stride : prev_size;
   for (const auto &a : a_orbs) {
     for (const auto &b : b_orbs) {
       if (a_is_b && b > a)
         continue;
+      const auto ia = std::size_t(m_position[std::size_t(a.nk_index())]);
+      const auto ib = std::size_t(m_position[std::size_t(b.nk_index())]);
       const auto [k0, kI] = k_minmax(a, b);
       for (auto k = k0; k <= kI; k += 2) {
-        get_or_insert(std::size_t(k), ab_key(a, b));
+        auto &off_ab = m_offset[index(ia, ib, k)];
+        if (off_ab != 0)
+          continue; // already included (previous call, or a, b in both sets)
+        off_ab = next_offset;
+        m_offset[index(ib, ia, k)] = off_ab;
+        next_offset += m_stride;
       }
     }
   }
-}
-
-//******************************************************************************
-const std::vector<double> *YkTable::get(const int k, const DiracSpinor &Fa,
-                                        const DiracSpinor &Fb) const {
-  const auto sk = static_cast<std::size_t>(k);
-  if (sk >= m_Y.size())
-    return nullptr;
-  // const auto key = ;
-  const auto it = m_Y[sk].find(ab_key(Fa, Fb));
-  if (it == m_Y[sk].cend()) {
-    return nullptr;
-  }
-  return &(it->second);
-}
-
-//******************************************************************************
-uint32_t YkTable::ab_key(const DiracSpinor &Fa, const DiracSpinor &Fb) const {
-  // symmetric: define F1=min(Fa,Fb), F2=max(Fa,Fb)
-  static_assert(sizeof(uint32_t) == 2 * sizeof(uint16_t), "32=2*16");
-  const std::array<uint16_t, 2> key_array{
-      static_cast<uint16_t>(std::min(Fa.nk_index(), Fb.nk_index())),
-      static_cast<uint16_t>(std::max(Fa.nk_index(), Fb.nk_index())) //
-  };
-  uint32_t tkey;
-  std::memcpy(&tkey, &key_array, sizeof(uint32_t));
-  return tkey;
-}
 
-//******************************************************************************
-std::vector<double> &YkTable::get_or_insert(std::size_t k, uint32_t key) {
-  if (k >= m_Y.size()) {
-    m_Y.resize(k + 1);
-  }
-  // Returns reference to vector at 'key'; if no such vector exists, creates
-  // it first.
-  const auto [new_it, ok] = m_Y[k].emplace(key, std::vector<double>{});
-  return new_it->second;
+  // nb: if size is unchanged (e.g., HF iterations), no re-allocation
+  m_arena.resize(next_offset / block_size);
+  if (prev_size == 0)
+    std::fill(arena(), arena() + m_stride, 0.0);
 }
 
 //******************************************************************************
-std::vector<double> &YkTable::get_ref(const int k, const DiracSpinor &Fa,
-                                      const DiracSpinor &Fb) {
-  // May only call this function is assured vector exists
+const double *YkTable::get(const int k, const DiracSpinor &Fa,
+                           const DiracSpinor &Fb) const {
   const auto sk = static_cast<std::size_t>(k);
-  assert(sk < m_Y.size());
-  // const auto key = ;
-  const auto it = m_Y[sk].find(ab_key(Fa, Fb));
-  assert(it != m_Y[sk].cend());
-  return it->second;
+  const auto nka = std::size_t(Fa.nk_index());
+  const auto nkb = std::size_t(Fb.nk_index());
+  if (sk >= m_num_k || nka >= m_position.size() ||
+      nkb >= m_position.size() || m_position[nka] < 0 || m_position[nkb] < 0)
+    return nullptr;
+  const auto off = offset(k, Fa, Fb);
+  return off == 0 ? nullptr : arena() + off;
 }
 
 //****************************************************************************
@@ -131,12 +152,89 @@ double YkTable::Qk(const int k, const DiracSpinor &Fa, const DiracSpinor &Fb,
   const auto tCbd = m_Ck.get_tildeCkab(k, Fb.k, Fd.k);
   if (Angular::zeroQ(tCbd))
     return 0.0;
-  const auto ykbd = get(k, Fb, Fd);
-  const auto Rkabcd = Coulomb::Rk_abcd(Fa, Fc, *ykbd);
+  const auto ykbd = get_unchecked(k, Fb, Fd);
+  const auto Rkabcd = Coulomb::Rk_abcd(Fa, Fc, ykbd);
   const auto m1tk = Angular::evenQ(k) ? 1 : -1;
   return m1tk * tCac * tCbd * Rkabcd;
 }
 
+//******************************************************************************
+std::vector<double>
+YkTable::Qk_block(int k, const std::vector<DiracSpinor> &as,
+                  const std::vector<DiracSpinor> &bs,
+                  const std::vector<DiracSpinor> &cs,
+                  const std::vector<DiracSpinor> &ds) const {
+  [[maybe_unused]] auto sp = IO::Profile::safeProfiler(__func__);
+  const auto num_ac = as.size() * cs.size();
+  const auto num_bd = bs.size() * ds.size();
+  std::vector<double> Qk(num_ac * num_bd, 0.0);
+  // k checked once here, so unchecked C^k look-ups may be used below
+  if (Qk.empty() || k > m_Ck.max_k())
+    return Qk;
+
+  // Angular factors: (-1)^k * tildeC^k_ac, and tildeC^k_bd
+  const auto m1tk = Angular::evenQ(k) ? 1.0 : -1.0;
+  std::vector<double> tC_ac(num_ac), tC_bd(num_bd);
+  for (auto iac = 0ul; iac < num_ac; ++iac) {
+    const auto &Fa = as[iac / cs.size()];
+    const auto &Fc = cs[iac % cs.size()];
+    tC_ac[iac] = m1tk * m_Ck.get_tildeCkab_unchecked(k, Fa.k, Fc.k);
+  }
+  for (auto ibd = 0ul; ibd < num_bd; ++ibd) {
+    const auto &Fb = bs[ibd / ds.size()];
+    const auto &Fd = ds[ibd % ds.size()];
+    tC_bd[ibd] = m_Ck.get_tildeCkab_unchecked(k, Fb.k, Fd.k);
+  }
+  const auto is_zero = [](double x) { return Angular::zeroQ(x); };
+  if (std::all_of(tC_ac.cbegin(), tC_ac.cend(), is_zero) ||
+      std::all_of(tC_bd.cbegin(), tC_bd.cend(), is_zero))
+    return Qk;
+
+  // Quadrature weights, including dr/du * du (as in NumCalc::integrate)
+  const auto num_points = as.front().rgrid->num_points();
+  const auto w = NumCalc::integration_weights(*as.front().rgrid);
+
+  // Weighted densities, w(r)*rho_ac(r): one row for each {a,c}
+  std::vector<double> rho(num_ac * num_points, 0.0);
+  for (auto ia = 0ul; ia < as.size(); ++ia) {
+    const auto &Fa = as[ia];
+    for (auto ic = 0ul; ic < cs.size(); ++ic) {
+      const auto &Fc = cs[ic];
+      auto *row = rho.data() + (ia * cs.size() + ic) * num_points;
+      const auto i0 = std::max(Fa.min_pt(), Fc.min_pt());
+      const auto imax = std::min(Fa.max_pt(), Fc.max_pt());
+      for (auto i = i0; i < imax; ++i) {
+        row[i] = w[i] * (Fa.f(i) * Fc.f(i) + Fa.g(i) * Fc.g(i));
+      }
+    }
+  }
+
+  // y^k_bd(r): one row for each {b,d}
+  std::vector<double> ykbd(num_bd * num_points);
+  for (auto ib = 0ul; ib < bs.size(); ++ib) {
+    for (auto id = 0ul; id < ds.size(); ++id) {
+      const auto yk = get_unchecked(k, bs[ib], ds[id]);
+      std::copy(yk, yk + num_points,
+                ykbd.begin() + long((ib * ds.size() + id) * num_points));
+    }
+  }
+
+  // R^k_abcd = \sum_r [w*rho_ac](r) * y^k_bd(r) : single matrix product
+  auto rho_m = gsl_matrix_view_array(rho.data(), num_ac, num_points);
+  auto yk_m = gsl_matrix_view_array(ykbd.data(), num_bd, num_points);
+  auto Qk_m = gsl_matrix_view_array(Qk.data(), num_ac, num_bd);
+  gsl_blas_dgemm(CblasNoTrans, CblasTrans, 1.0, &rho_m.matrix, &yk_m.matrix,
+                 0.0, &Qk_m.matrix);
+
+  // Q^k = (-1)^k * tildeC^k_ac * tildeC^k_bd * R^k
+  for (auto iac = 0ul; iac < num_ac; ++iac) {
+    for (auto ibd = 0ul; ibd < num_bd; ++ibd) {
+      Qk[iac * num_bd + ibd] *= tC_ac[iac] * tC_bd[ibd];
+    }
+  }
+  return Qk;
+}
+
 //******************************************************************************
 double YkTable::Pk(const int k, const DiracSpinor &Fa, const DiracSpinor &Fb,
                    const DiracSpinor &Fc, const DiracSpinor &Fd) const {
@@ -150,10 +248,7 @@ double YkTable::Pk(const int k, const DiracSpinor &Fa, const DiracSpinor &Fb,
   double pk = 0.0;
   const auto [l0, lI] = Coulomb::k_minmax_Q(Fa, Fb, Fd, Fc);
   for (int l = l0; l <= lI; l += 2) {
-    const auto ylbc = get(l, Fb, Fc);
-    assert(ylbc != nullptr);
-
-    // const auto Ql = Coulomb::Qk_abcd(Fa, Fb, Fd, Fc, l, *ylbc, m_Ck);
+    assert(get(l, Fb, Fc) != nullptr);
     const auto Ql = Qk(l, Fa, Fb, Fd, Fc);
     const auto sj =
         m_6j(Fa.twoj(), Fc.twoj(), 2 * k, Fb.twoj(), Fd.twoj(), 2 * l);
@@ -181,9 +276,8 @@ DiracSpinor YkTable::Qkv_bcd(int kappa, const DiracSpinor &Fb,
     // Qkv.scale(0.0);
     return Qkv;
   }
-  // const auto ylbc = get(l, Fb, Fc);
-  const auto ykbd = get(k, Fb, Fd);
-  Coulomb::Rkv_bcd(&Qkv, Fc, *ykbd);
+  const auto ykbd = get_unchecked(k, Fb, Fd);
+  Coulomb::Rkv_bcd(&Qkv, Fc, ykbd);
   const auto m1tk = Angular::evenQ(k) ? 1 : -1;
   Qkv.scale(m1tk * tCC);
   return Qkv;
@@ -211,8 +305,7 @@ DiracSpinor YkTable::Pkv_bcd(int kappa, const DiracSpinor &Fb,
   const auto [l0, lI] = Coulomb::k_minmax_Q(Pkv, Fb, Fd, Fc);
   // for (const auto &ybc_l : ybc) {
   for (int l = l0; l <= lI; l += 2) {
-    const auto ylbc = get(l, Fb, Fc);
-    assert(ylbc != nullptr);
+    assert(get(l, Fb, Fc) != nullptr);
 
     const auto sj = fk(l) * m_6j(Fc.twoj(), Angular::twoj_k(kappa), 2 * k,
                                  Fd.twoj(), Fb.twoj(), 2 * l);
@@ -2,7 +2,7 @@
 #include "Angular/CkTable.hpp"
 #include "Angular/SixJTable.hpp"
 #include "Wavefunction/DiracSpinor.hpp"
-#include <unordered_map>
+#include <cassert>
 #include <vector>
 
 namespace Coulomb {
@@ -13,6 +13,10 @@ namespace Coulomb {
 
 Also stores a Ck and 6J table
 
+All y^k_ab functions are stored in a single contiguous (aligned) arena; the
+(k,a,b) -> offset index is formed once (in calculate), so look-up is a direct
+array index (no hashing).
+
 Definitions:
 
 \f[
@@ -26,7 +30,23 @@ with \f$r_< = min(r,r')\f$
 class YkTable {
 
 private:
-  std::vector<std::unordered_map<uint32_t, std::vector<double>>> m_Y{};
+  // Cache-line sized block; used to give aligned storage for y^k functions
+  struct alignas(64) Block {
+    double x[8];
+  };
+  // All y^k_ab functions, stored contiguously in a single (aligned) arena.
+  // Each function has m_num_points elements, and starts on a new Block.
+  // The first function (offset 0) is all zeros: used for y^k_ab that are not
+  // stored (e.g., forbidden by parity), so look-ups need no branching.
+  std::vector<Block> m_arena{};
+  // Maps nk_index -> position of orbital in table (-1 if not in table)
+  std::vector<int> m_position{};
+  // Offset of y^k_ab in arena (in doubles), for [ia][ib][k]; symmetric
+  std::vector<std::size_t> m_offset{};
+  // Number of orbitals in table (all of {a} and {b}), and max k + 1
+  std::size_t m_num_orbs{0}, m_num_k{0};
+  // Number of grid points (length of each y^k_ab function) and stride
+  std::size_t m_num_points{0}, m_stride{0};
   Angular::CkTable m_Ck{};
   Angular::SixJTable m_6j{};
 
@@ -57,10 +77,26 @@ public:
   //! Returns a (const ref) to SixJ table [see Angular::SixJTable]
   const Angular::SixJTable &SixJ() const { return m_6j; }
 
-  //! Returns a pointer to constant vector y^k_ab. If that integral is not
-  //! stores, returns nullptr
-  const std::vector<double> *get(const int k, const DiracSpinor &Fa,
-                                 const DiracSpinor &Fb) const;
+  //! Returns a pointer to y^k_ab(r) (array of size num_points). If that
+  //! integral is not stored, returns nullptr
+  const double *get(const int k, const DiracSpinor &Fa,
+                    const DiracSpinor &Fb) const;
+
+  //! As get(), but with no checks: Fa and Fb *must* be in the table, and k
+  //! must not exceed max k. Returns pointer to zeros if y^k_ab is not stored
+  //! (i.e., forbidden by parity). No branching or hashing.
+  const double *get_unchecked(const int k, const DiracSpinor &Fa,
+                              const DiracSpinor &Fb) const {
+    assert(std::size_t(Fa.nk_index()) < m_position.size() &&
+           m_position[std::size_t(Fa.nk_index())] >= 0);
+    assert(std::size_t(Fb.nk_index()) < m_position.size() &&
+           m_position[std::size_t(Fb.nk_index())] >= 0);
+    assert(std::size_t(k) < m_num_k);
+    return arena() + offset(k, Fa, Fb);
+  }
+
+  //! Total memory used to store y^k functions (in bytes)
+  std::size_t arena_bytes() const { return m_arena.size() * sizeof(Block); }
 
   //! Calculates Qk using the existing yk integrals. Note: Yk and Ck tables
   //! *must* include all required values, or behaviour not defined.
@@ -80,6 +116,22 @@ public:
                           const DiracSpinor &Fb, const DiracSpinor &Fc,
                           const DiracSpinor &Fd) const;
 
+  //! Calculates block of Q^k_abcd, for all a in as, b in bs, c in cs, d in ds,
+  //! at once (for single k).
+  /*! @details
+  Forms the matrix rho_ac(r) (quadrature weights folded in) for all {a,c}, and
+  y^k_bd(r) for all {b,d}, and gets R^k as their product via a single BLAS-3
+  (dgemm) call. Returned as flat array, Q^k_abcd = Q[iac*(nb*nd) + ibd], with
+  iac = ia*nc + ic, and ibd = ib*nd + id. Zero where forbidden by angular
+  selection rules. {b} and {d} *must* be in the table. Agrees with Qk() to
+  within numerical precision (different summation order).
+  */
+  [[nodiscard]] std::vector<double>
+  Qk_block(int k, const std::vector<DiracSpinor> &as,
+           const std::vector<DiracSpinor> &bs,
+           const std::vector<DiracSpinor> &cs,
+           const std::vector<DiracSpinor> &ds) const;
+
   //! Calculates Q^K(v)_bcd using existing yk integrals
   [[nodiscard]] DiracSpinor Qkv_bcd(int kappa, const DiracSpinor &Fb,
                                     const DiracSpinor &Fc,
@@ -93,22 +145,29 @@ public:
                                     const std::vector<double> &f2k = {}) const;
 
 private:
-  // Allocates space for the Yk table, but does not calculate Yk. This is
-  // because allocation cannot be done in parallel, but once allocation is done,
-  // calculation can be done in //
+  // Builds the (k,a,b) -> offset index, and allocates the arena, but does not
+  // calculate Yk. This is because allocation cannot be done in parallel, but
+  // once allocation is done, calculation can be done in //
   void allocate_space(const std::vector<DiracSpinor> &a_orbs,
                       const std::vector<DiracSpinor> &b_orbs);
 
-  // Returns key used for look-up table (unordered_map), considers symmetry
-  uint32_t ab_key(const DiracSpinor &Fa, const DiracSpinor &Fb) const;
+  // Index into m_offset, for orbitals at positions ia, ib (in table)
+  std::size_t index(std::size_t ia, std::size_t ib, int k) const {
+    return (ia * m_num_orbs + ib) * m_num_k + std::size_t(k);
+  }
 
-  // Returns reference to yk vector at 'key'; if no such vector exists, creates
-  // it first.
-  std::vector<double> &get_or_insert(std::size_t k, uint32_t key);
+  // Offset (in arena) of y^k_ab. Fa and Fb *must* be in table
+  std::size_t offset(int k, const DiracSpinor &Fa,
+                     const DiracSpinor &Fb) const {
+    return m_offset[index(std::size_t(m_position[std::size_t(Fa.nk_index())]),
+                          std::size_t(m_position[std::size_t(Fb.nk_index())]),
+                          k)];
+  }
 
-  // Returns reference to yk vector at 'key'. This vector *must* exist already
-  std::vector<double> &get_ref(const int k, const DiracSpinor &Fa,
-                               const DiracSpinor &Fb);
+  const double *arena() const {
+    return reinterpret_cast<const double *>(m_arena.data());
+  }
+  double *arena() { return reinterpret_cast<double *>(m_arena.data()); }
 };
 
 } // namespace Coulomb
@@ -6,6 +6,13 @@
 #include "Maths/NumCalc_quadIntegrate.hpp"
 #include "Wavefunction/DiracSpinor.hpp"
 #include "qip/Vector.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <utility>
 #include <vector>
 /*
 
@@ -55,13 +62,237 @@ void solve_inhomog(DiracSpinor &Fa, DiracSpinor &Fzero, DiracSpinor &Finf,
   Adams::GreenSolution(Fa, Finf, Fzero, alpha, source);
 }
 
+//******************************************************************************
+InhomogSolver::InhomogSolver(std::shared_ptr<const Grid> rgrid, double alpha)
+    : m_rgrid(std::move(rgrid)),
+      m_alpha(alpha),
+      m_Fzero(std::make_unique<DiracSpinor>(0, -1, m_rgrid)),
+      m_Finf(std::make_unique<DiracSpinor>(0, -1, m_rgrid)) {}
+
+InhomogSolver::~InhomogSolver() = default;
+
+//------------------------------------------------------------------------------
+bool InhomogSolver::update(int kappa, double en, const std::vector<double> &v,
+                           const std::vector<double> &H_mag) {
+  if (m_solved && kappa == m_kappa && en == m_en && v == m_v &&
+      H_mag == m_Hmag)
+    return false;
+  [[maybe_unused]] auto sp = IO::Profile::safeProfiler(__func__);
+  m_kappa = kappa;
+  m_en = en;
+  m_v = v;
+  m_Hmag = H_mag;
+  // kappa is const in DiracSpinor: new ones only if kappa changes
+  if (m_Fzero->k != kappa) {
+    m_Fzero = std::make_unique<DiracSpinor>(0, kappa, m_rgrid);
+    m_Finf = std::make_unique<DiracSpinor>(0, kappa, m_rgrid);
+  }
+  regularAtOrigin(*m_Fzero, en, v, H_mag, m_alpha);
+  regularAtInfinity(*m_Finf, en, v, H_mag, m_alpha);
+  m_w2 = Adams::Wronskian(*m_Finf, *m_Fzero);
+  m_solved = true;
+  return true;
+}
+
+//------------------------------------------------------------------------------
+void InhomogSolver::solve(DiracSpinor &Fa, const DiracSpinor &source) const {
+  assert(m_solved && Fa.k == m_kappa);
+  Fa.set_en() = m_en;
+  Adams::GreenSolution(Fa, *m_Finf, *m_Fzero, m_alpha, source, m_w2);
+}
+
+DiracSpinor InhomogSolver::solve(const DiracSpinor &source) const {
+  auto Fa = DiracSpinor(0, m_kappa, m_rgrid);
+  solve(Fa, source);
+  return Fa;
+}
+
+std::vector<DiracSpinor>
+InhomogSolver::solve(const std::vector<DiracSpinor> &sources) const {
+  [[maybe_unused]] auto sp = IO::Profile::safeProfiler(__func__);
+  std::vector<DiracSpinor> Fs(sources.size(),
+                              DiracSpinor(0, m_kappa, m_rgrid));
+#pragma omp parallel for
+  for (auto i = 0ul; i < sources.size(); ++i) {
+    solve(Fs[i], sources[i]);
+  }
+  return Fs;
+}
+
+//******************************************************************************
+int solve_nonlocal(DiracSpinor &F, const DiracSpinor &S,
+                   const InhomogSolver &G0, const NonLocalOp &V, double eps,
+                   int max_its)
+// GMRES for [1 + G0*V]F = G0*S, with F0 = 0. Krylov basis q is formed with
+// (modified) Gram-Schmidt; Hessenberg matrix h kept upper-triangular by Givens
+// rotations, so the residual |g[j+1]| is known at each step without forming F.
+// Inner product is the usual <a|b> = int (fa*fb + ga*gb) dr
+{
+  [[maybe_unused]] auto sp = IO::Profile::safeProfiler(__func__);
+  assert(F.k == G0.kappa() && S.k == G0.kappa());
+  const auto m = std::size_t(std::max(max_its, 1));
+
+  // Work spinor, for G0*(V*x)
+  auto G0Vx = DiracSpinor(F.n, F.k, F.rgrid);
+
+  // b = G0*S; q[0] = b/|b|
+  std::vector<DiracSpinor> q;
+  q.reserve(m + 1);
+  q.push_back(DiracSpinor(F.n, F.k, F.rgrid));
+  G0.solve(q[0], S);
+  const auto beta = std::sqrt(q[0] * q[0]);
+
+  F.set_max_pt() = F.f().size();
+  F *= 0.0;
+  F.set_max_pt() = q[0].max_pt();
+  F.set_en() = G0.en();
+  if (beta == 0.0)
+    return 0;
+  q[0] *= (1.0 / beta);
+
+  std::vector<std::vector<double>> h; // h[j][i] = H_ij (column j)
+  h.reserve(m);
+  std::vector<double> cs, sn, g{beta}, y;
+  // Back-substitution: h*y = g, for first n Krylov vectors; F = sum_i y_i q_i
+  const auto solve_y = [&](std::size_t n) {
+    y.resize(n);
+    for (auto i = n; i-- > 0;) {
+      auto yi = g[i];
+      for (auto l = i + 1; l < n; ++l) {
+        yi -= h[l][i] * y[l];
+      }
+      y[i] = yi / h[i][i];
+    }
+    return std::sqrt(std::inner_product(y.begin(), y.end(), y.begin(), 0.0));
+  };
+
+  std::size_t nq = 0;
+  while (nq < m) {
+    const auto j = nq++;
+    // w = [1 + G0*V] q_j
+    G0.solve(G0Vx, V(q[j]));
+    auto w = q[j] + G0Vx;
+    std::vector<double> hj(j + 2);
+    for (std::size_t i = 0; i <= j; ++i) {
+      hj[i] = q[i] * w;
+      w -= hj[i] * q[i];
+    }
+    const auto w_norm = std::sqrt(w * w);
+    hj[j + 1] = w_norm;
+    for (std::size_t i = 0; i < j; ++i) {
+      const auto t = cs[i] * hj[i] + sn[i] * hj[i + 1];
+      hj[i + 1] = -sn[i] * hj[i] + cs[i] * hj[i + 1];
+      hj[i] = t;
+    }
+    const auto r = std::hypot(hj[j], hj[j + 1]);
+    cs.push_back(hj[j] / r);
+    sn.push_back(hj[j + 1] / r);
+    hj[j] = r;
+    hj[j + 1] = 0.0;
+    g.push_back(-sn[j] * g[j]);
+    g[j] *= cs[j];
+    h.push_back(std::move(hj));
+
+    // Residual is relative to |F| if larger than |b|: when nearly singular
+    // (en close to an eigenvalue), can't do better than ~ machine eps * |F|.
+    // w_norm=0: Krylov space is invariant, solution is exact
+    if (std::abs(g[j + 1]) < eps * std::max(beta, solve_y(nq)) ||
+        w_norm == 0.0)
+      break;
+    q.push_back((1.0 / w_norm) * w);
+  }
+
+  solve_y(nq);
+  for (std::size_t i = 0; i < nq; ++i) {
+    F += y[i] * q[i];
+  }
+
+  return int(nq);
+}
+
+//******************************************************************************
+void boundState_nonlocal(DiracSpinor &Fa, const double en0,
+                         const std::vector<double> &v,
+                         const std::vector<double> &H_mag, const double alpha,
+                         const NonLocalOp &V, double eps_target, int max_its)
+// Shifted inverse iteration: X = (H - s)^{-1} Fa, Fa -> X/|X|.
+// Energy is not from Rayleigh quotient <X|Fa>/<X|X>: that assumes (H - s) is
+// symmetric, which the discrete G0 is not quite, and is only as accurate as the
+// solve for X. Instead, for eigenstate, Fa + G0(s)*V*Fa = (en - s)*G0(s)*Fa, so:
+//   en = s + <G0Fa|Fa + G0VFa> / <G0Fa|G0Fa>
+// which uses only Fa (exact residual). The shift s is updated to en until they
+// agree to ~sqrt(eps_target): so (H - s) never becomes too close to singular,
+// but s is close enough that the s-dependence of discrete G0 doesn't matter.
+// Inverse iteration converges to the state nearest s, which is not checked
+// to be Fa: so, the nodes of the solution are checked at the end
+{
+  [[maybe_unused]] auto sp = IO::Profile::safeProfiler(__func__);
+  InhomogSolver G0(Fa.rgrid, alpha);
+  auto X = DiracSpinor(Fa.n, Fa.k, Fa.rgrid);
+  auto G0F = DiracSpinor(Fa.n, Fa.k, Fa.rgrid);
+  auto G0VF = DiracSpinor(Fa.n, Fa.k, Fa.rgrid);
+  const auto eps_solve = std::max(0.1 * eps_target, 1.0e-13);
+  const auto eps_shift = std::sqrt(eps_target);
+  // Krylov space size for GMRES; if all used, the solve may not have converged
+  constexpr int max_gmres = 32;
+  bool gmres_ok = true;
+
+  Fa.normalise();
+  auto shift = en0;
+  auto en = en0;
+  double eps = 1.0;
+  int its = 0;
+  while (its < max_its) {
+    ++its;
+    if (std::abs((en - shift) / en) > eps_shift)
+      shift = en;
+    G0.update(Fa.k, shift, v, H_mag);
+    if (solve_nonlocal(X, Fa, G0, V, eps_solve, max_gmres) >= max_gmres) {
+      // Not converged: try once more, with a larger Krylov space
+      gmres_ok &= solve_nonlocal(X, Fa, G0, V, eps_solve, 4 * max_gmres) <
+                  4 * max_gmres;
+    }
+    // keep sign of Fa [sign of X depends on sign of (en - s)]
+    X *= ((X * Fa) > 0.0 ? 1.0 : -1.0) / std::sqrt(X * X);
+    Fa = X;
+    G0.solve(G0F, Fa);
+    G0.solve(G0VF, V(Fa));
+    const auto en_new = shift + (G0F * Fa + G0F * G0VF) / (G0F * G0F);
+    eps = std::abs((en_new - en) / en_new);
+    en = en_new;
+    if (eps < eps_target)
+      break;
+  }
+  Fa.set_en() = en;
+  Fa.set_eps() = eps;
+  Fa.set_its() = its;
+
+  if (!gmres_ok) {
+    std::cout << "\n⚠️  WARNING: solve_nonlocal didn't converge in "
+              << 4 * max_gmres << " iterations, for " << Fa.symbol() << "\n";
+  }
+  const auto pinf =
+      Adams::findPracticalInfinity(en, v, Fa.rgrid->r(), Adams::Param::cALR);
+  const auto nodes = Adams::countNodes(Fa.f(), pinf);
+  const auto required_nodes = Fa.n - Fa.l() - 1;
+  if (nodes != required_nodes) {
+    // Converged to the wrong state: flag as failed
+    std::cout << "\n⚠️  WARNING: boundState_nonlocal: wrong nodes: " << nodes
+              << "/" << required_nodes << " for " << Fa.symbol() << "\n";
+    Fa.set_eps() = 1.0;
+  }
+}
+
 namespace Adams {
 //******************************************************************************
 void GreenSolution(DiracSpinor &Fa, const DiracSpinor &Finf,
                    const DiracSpinor &Fzero, const double alpha,
                    const DiracSpinor &Sr) {
-  [[maybe_unused]] auto sp = IO::Profile::safeProfiler(__func__);
+  GreenSolution(Fa, Finf, Fzero, alpha, Sr, Wronskian(Finf, Fzero));
+}
 
+//******************************************************************************
+double Wronskian(const DiracSpinor &Finf, const DiracSpinor &Fzero) {
   // Wronskian: Should be independent of r
   const auto pp = std::size_t(0.65 * double(Finf.max_pt()));
   auto w2 = (Finf.f(pp) * Fzero.g(pp) - Fzero.f(pp) * Finf.g(pp));
@@ -70,7 +301,14 @@ void GreenSolution(DiracSpinor &Fa, const DiracSpinor &Finf,
     ++f;
     w2 += (Finf.f(pt) * Fzero.g(pt) - Fzero.f(pt) * Finf.g(pt));
   }
-  w2 /= f;
+  return w2 / f;
+}
+
+//******************************************************************************
+void GreenSolution(DiracSpinor &Fa, const DiracSpinor &Finf,
+                   const DiracSpinor &Fzero, const double alpha,
+                   const DiracSpinor &Sr, const double w2) {
+  [[maybe_unused]] auto sp = IO::Profile::safeProfiler(__func__);
 
   // std::vector<double> invW2(Finf.set_f().size());
   // for (std::size_t i = 0; i < Finf.max_pt(); ++i) {
@@ -1,12 +1,124 @@
 #pragma once
+#include <functional>
+#include <memory>
+#include <vector>
 class DiracSpinor;
+class Grid;
 
 namespace DiracODE {
+
+//******************************************************************************
+//! @brief Solves inhomogeneous Dirac equation for many source terms, re-using
+//! the homogeneous solutions
+/*! @details
+\f[ (H_0 + v -\epsilon)F = S \f]
+Same as solve_inhomog(), but the homogeneous solutions (Fzero, Finf: regular
+at origin, infinity) and their Wronskian, which depend only on
+(kappa, en, v, H_mag) - not on the source S - are stored. update() re-solves
+them only if one of those changed (v and H_mag are compared by value); solve()
+is then just the Green's-function integrals, with no ODE integration.
+  - Typical use: fixed-point iterations where only the source changes
+  - Holds state: not thread-safe. Use one per thread.
+  - As with solve_inhomog, returns NON-normalised solutions
+*/
+class InhomogSolver {
+  std::shared_ptr<const Grid> m_rgrid;
+  double m_alpha;
+  int m_kappa{0};
+  double m_en{0.0};
+  std::vector<double> m_v{};
+  std::vector<double> m_Hmag{};
+  std::unique_ptr<DiracSpinor> m_Fzero;
+  std::unique_ptr<DiracSpinor> m_Finf;
+  double m_w2{0.0};
+  bool m_solved{false};
+
+public:
+  InhomogSolver(std::shared_ptr<const Grid> rgrid, double alpha);
+  ~InhomogSolver();
+  InhomogSolver(const InhomogSolver &) = delete;
+  InhomogSolver &operator=(const InhomogSolver &) = delete;
+
+  //! Sets (kappa, en, v, H_mag). Re-solves for Fzero, Finf only if changed.
+  //! Returns true if they were re-solved.
+  bool update(int kappa, double en, const std::vector<double> &v,
+              const std::vector<double> &H_mag);
+
+  //! Solves for Fa, given source (update() must have been called)
+  void solve(DiracSpinor &Fa, const DiracSpinor &source) const;
+  //! Solves for F, given source (update() must have been called)
+  [[nodiscard]] DiracSpinor solve(const DiracSpinor &source) const;
+  //! Solves for each source in list (OpenMP parallel over sources)
+  [[nodiscard]] std::vector<DiracSpinor>
+  solve(const std::vector<DiracSpinor> &sources) const;
+
+  int kappa() const { return m_kappa; }
+  double en() const { return m_en; }
+  //! Homogeneous solution, regular at origin
+  const DiracSpinor &Fzero() const { return *m_Fzero; }
+  //! Homogeneous solution, regular at infinity
+  const DiracSpinor &Finf() const { return *m_Finf; }
+  //! Wronskian of Finf, Fzero (as used in Adams::GreenSolution)
+  double wronskian() const { return m_w2; }
+};
+
+//! Non-local operator: returns V*F. Must be linear in F (e.g., exchange with a
+//! frozen core, Breit, correlation potential Sigma, or a sum of these)
+using NonLocalOp = std::function<DiracSpinor(const DiracSpinor &)>;
+
+//******************************************************************************
+//! @brief Solves inhomogeneous Dirac equation, with non-local operator V
+/*! @details
+\f[ (H_0 + v + V -\epsilon)F = S \f]
+V is treated exactly: it is not replaced by a local approximation, nor moved
+to the right-hand side and iterated. With G0 = (H_0 + v - en)^{-1}, the local
+Green's function (given by InhomogSolver, which must already be update()'d for
+kappa, en, v, H_mag), this is written as the integral equation:
+\f[ [1 + G_0 V] F = G_0 S \f]
+which is solved with GMRES on the radial grid. Each iteration is one
+application of V, plus the G0 integrals (no ODE integration).
+  - eps: target for residual, |(1 + G0 V)F - G0 S|, relative to |G0 S| (or
+to |F|, if larger: i.e., when en is close to an eigenvalue)
+  - max_its: maximum number of iterations (Krylov vectors)
+  - Returns number of iterations used (number of times V was applied)
+*/
+int solve_nonlocal(DiracSpinor &F, const DiracSpinor &S,
+                   const InhomogSolver &G0, const NonLocalOp &V,
+                   double eps = 1.0e-12, int max_its = 32);
+
+//! @brief Bound-state solution of Dirac equation, with non-local operator V
+/*! @details
+\f[ (H_0 + v + V)F = \epsilon F \f]
+V treated exactly (see solve_nonlocal). Solved by shifted inverse iteration,
+\f[ F \to (H - s)^{-1} F \f]
+(one solve_nonlocal() per iteration), with the energy found from the residual
+of F, and shift s updated towards the energy. Converges to the state nearest
+the initial guess: on input, Fa and en0 must already be a reasonable
+approximation (e.g., from a local approximation to V). Typically takes 2-3
+iterations. Fa is normalised; Fa.en(), eps() and its() are set. If the
+solution doesn't have n-l-1 nodes (converged to a different state), a warning
+is printed and eps() is set to 1.
+  - eps_target: convergence target, for |delta_en / en|
+*/
+void boundState_nonlocal(DiracSpinor &Fa, const double en0,
+                         const std::vector<double> &v,
+                         const std::vector<double> &H_mag, const double alpha,
+                         const NonLocalOp &V, double eps_target = 1.0e-14,
+                         int max_its = 30);
+
 namespace Adams {
 
 void GreenSolution(DiracSpinor &Fa, const DiracSpinor &Finf,
                    const DiracSpinor &Fzero, const double alpha,
                    const DiracSpinor &Sr);
 
+//! As above, but with Wronskian, w2 = Wronskian(Finf, Fzero), given
+void GreenSolution(DiracSpinor &Fa, const DiracSpinor &Finf,
+                   const DiracSpinor &Fzero, const double alpha,
+                   const DiracSpinor &Sr, const double w2);
+
+//! Wronskian of Finf, Fzero: averaged over 41 points around 65% of pinf
+double Wronskian(const DiracSpinor &Finf, const DiracSpinor &Fzero);
+
 } // namespace Adams
 } // namespace DiracODE
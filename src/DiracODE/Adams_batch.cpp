@@ -0,0 +1,341 @@
+#include "DiracODE/Adams_batch.hpp"
+#include "DiracODE/Adams_bound.hpp"
+#include "DiracODE/Adams_coefs.hpp"
+#include "IO/SafeProfiler.hpp"
+#include "Maths/Grid.hpp"
+#include "Wavefunction/DiracSpinor.hpp"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <memory>
+#include <vector>
+
+// Unfortunately, seems too messy to fix this
+#pragma GCC diagnostic ignored "-Wsign-conversion"
+
+/*
+Batched (multi-lane) versions of regularAtOrigin/regularAtInfinity.
+The starting points (series expansion at origin, asymptotic expansion at
+pinf) are found for each system separately (as in outwardAM/inwardAM); the
+Adams-Moulton part, which is the bulk of the work, is done for N systems at
+once (adamsMoulton_batch).
+*/
+
+namespace DiracODE {
+
+using namespace Adams;
+
+namespace {
+// Solves systems Fs[i0], ..., Fs[i0+N-1], as N lanes. If fewer than N
+// remain, last system is repeated in the unused lanes (and discarded)
+template <std::size_t N>
+void solve_lanes(std::vector<DiracSpinor> &Fs, const std::vector<double> &ens,
+                 std::size_t i0, const std::vector<double> &v,
+                 const std::vector<double> &H_mag, const double alpha,
+                 bool outward) {
+  const auto &gr = *Fs[i0].rgrid;
+  const auto num_points = gr.num_points();
+  // first point found by Adams-Moulton, for outward integration:
+  const auto amo = get_AM_order();
+  const auto na = Param::num_loops * amo + 1;
+
+  std::array<int, N> kappa, pinf, ni, nf;
+  std::array<double, N> en;
+  // F, G: [point][lane]. Zero, other than starting points. Work-space re-used
+  // between calls (avoids allocating, and page-faulting, each time)
+  static thread_local std::vector<std::array<double, N>> F, G;
+  static thread_local std::vector<double> f, g;
+  F.assign(num_points, {});
+  G.assign(num_points, {});
+  f.resize(num_points);
+  g.resize(num_points);
+  for (std::size_t l = 0; l < N; ++l) {
+    const auto i = std::min(i0 + l, Fs.size() - 1);
+    kappa[l] = Fs[i].k;
+    en[l] = ens[i];
+    pinf[l] = findPracticalInfinity(en[l], v, gr.r(), Param::cALR);
+    // Starting points only (no Adams-Moulton) for each lane, in [j0, j1):
+    DiracMatrix Hd(gr, v, kappa[l], en[l], alpha, H_mag);
+    int j0, j1;
+    if (outward) {
+      outwardAM(f, g, Hd, na);
+      ni[l] = na;
+      nf[l] = pinf[l] - 1 > na ? pinf[l] - 1 : na - 1;
+      j0 = 0;
+      j1 = na;
+    } else {
+      inwardAM(f, g, Hd, pinf[l] - 1, pinf[l] - 1);
+      ni[l] = pinf[l] - 1 - amo - 1;
+      nf[l] = 0;
+      j0 = ni[l] + 1;
+      j1 = pinf[l];
+    }
+    for (auto j = j0; j < j1; ++j) {
+      F[j][l] = f[j];
+      G[j][l] = g[j];
+    }
+  }
+
+  adamsMoulton_batch(F, G, kappa, en, v, H_mag, gr, alpha, outward ? 1 : -1,
+                     ni, nf);
+
+  for (std::size_t l = 0; l < N && i0 + l < Fs.size(); ++l) {
+    auto &Fa = Fs[i0 + l];
+    Fa.set_en() = en[l];
+    auto &fa = Fa.set_f();
+    auto &ga = Fa.set_g();
+    for (auto j = 0; j < pinf[l]; ++j) {
+      fa[j] = F[j][l];
+      ga[j] = G[j][l];
+    }
+    Fa.set_max_pt() = pinf[l];
+    // for safety: make sure zerod! (I may re-use existing orbitals!)
+    Fa.zero_boundaries();
+  }
+}
+
+// Splits Fs into groups of 8 or 4 lanes
+void solve_batch(std::vector<DiracSpinor> &Fs, const std::vector<double> &ens,
+                 const std::vector<double> &v,
+                 const std::vector<double> &H_mag, const double alpha,
+                 bool outward) {
+  assert(Fs.size() == ens.size());
+  for (std::size_t i0 = 0; i0 < Fs.size();) {
+    const auto remaining = Fs.size() - i0;
+    if (remaining == 1) {
+      // Not worth batching a single system
+      if (outward)
+        regularAtOrigin(Fs[i0], ens[i0], v, H_mag, alpha);
+      else
+        regularAtInfinity(Fs[i0], ens[i0], v, H_mag, alpha);
+      i0 += 1;
+    } else if (remaining > 4) {
+      solve_lanes<8>(Fs, ens, i0, v, H_mag, alpha, outward);
+      i0 += 8;
+    } else {
+      solve_lanes<4>(Fs, ens, i0, v, H_mag, alpha, outward);
+      i0 += 4;
+    }
+  }
+}
+} // namespace
+
+//******************************************************************************
+void regularAtOrigin(std::vector<DiracSpinor> &Fs,
+                     const std::vector<double> &ens,
+                     const std::vector<double> &v,
+                     const std::vector<double> &H_mag, const double alpha) {
+  [[maybe_unused]] auto sp = IO::Profile::safeProfiler(__func__, "batch");
+  solve_batch(Fs, ens, v, H_mag, alpha, true);
+}
+
+void regularAtInfinity(std::vector<DiracSpinor> &Fs,
+                       const std::vector<double> &ens,
+                       const std::vector<double> &v,
+                       const std::vector<double> &H_mag, const double alpha) {
+  [[maybe_unused]] auto sp = IO::Profile::safeProfiler(__func__, "batch");
+  solve_batch(Fs, ens, v, H_mag, alpha, false);
+}
+
+//------------------------------------------------------------------------------
+std::vector<DiracSpinor>
+regularAtOrigin(const std::vector<int> &kappas, const std::vector<double> &ens,
+                const std::vector<double> &v, const std::vector<double> &H_mag,
+                const double alpha, std::shared_ptr<const Grid> rgrid) {
+  std::vector<DiracSpinor> Fs;
+  Fs.reserve(kappas.size());
+  for (const auto kappa : kappas) {
+    Fs.emplace_back(0, kappa, rgrid);
+  }
+  regularAtOrigin(Fs, ens, v, H_mag, alpha);
+  return Fs;
+}
+
+std::vector<DiracSpinor> regularAtInfinity(
+    const std::vector<int> &kappas, const std::vector<double> &ens,
+    const std::vector<double> &v, const std::vector<double> &H_mag,
+    const double alpha, std::shared_ptr<const Grid> rgrid) {
+  std::vector<DiracSpinor> Fs;
+  Fs.reserve(kappas.size());
+  for (const auto kappa : kappas) {
+    Fs.emplace_back(0, kappa, rgrid);
+  }
+  regularAtInfinity(Fs, ens, v, H_mag, alpha);
+  return Fs;
+}
+
+namespace Adams {
+
+namespace {
+//******************************************************************************
+// adamsMoulton_batch, for order K
+template <int K, std::size_t N>
+void adamsMoulton_batch_K(std::vector<std::array<double, N>> &F,
+                          std::vector<std::array<double, N>> &G,
+                          const std::array<int, N> &kappa,
+                          const std::array<double, N> &en,
+                          const std::vector<double> &v,
+                          const std::vector<double> &H_mag, const Grid &gr,
+                          const double alpha, const int inc,
+                          const std::array<int, N> &ni,
+                          const std::array<int, N> &nf) {
+  assert(inc == 1 || inc == -1);
+
+  // Range [lo, hi] integrated for each lane, and the union of these
+  std::array<int, N> lo, hi;
+  int r_start = ni[0];
+  int r_end = nf[0];
+  for (std::size_t l = 0; l < N; ++l) {
+    lo[l] = inc > 0 ? ni[l] : nf[l];
+    hi[l] = inc > 0 ? nf[l] : ni[l];
+    r_start = inc > 0 ? std::min(r_start, ni[l]) : std::max(r_start, ni[l]);
+    r_end = inc > 0 ? std::max(r_end, nf[l]) : std::min(r_end, nf[l]);
+  }
+  // Range over which all lanes are integrated
+  const auto lo_all = *std::max_element(lo.begin(), lo.end());
+  const auto hi_all = *std::min_element(hi.begin(), hi.end());
+  const auto nosteps = inc * (r_end - r_start) + 1;
+  if (nosteps <= 0)
+    return;
+
+  const auto &drduor = gr.drduor();
+  const auto &drdu = gr.drdu();
+  const auto cc = 1.0 / alpha;
+  std::array<double, N> ka;
+  for (std::size_t l = 0; l < N; ++l) {
+    ka[l] = double(kappa[l]);
+  }
+
+  // Dirac matrix elements (as DiracMatrix) at point i, for each lane; d = -a.
+  // Grid, potential loaded once for all lanes
+  std::array<double, N> a, b, c;
+  const auto abc = [&](std::size_t i) {
+    const auto dror = drduor[i];
+    const auto dr = drdu[i];
+    const auto vi = v[i];
+    const auto hm = H_mag.empty() ? 0.0 : alpha * H_mag[i] * dr;
+#pragma omp simd
+    for (std::size_t l = 0; l < N; ++l) {
+      a[l] = -ka[l] * dror + hm;
+      b[l] = (alpha * en[l] + 2.0 * cc - alpha * vi) * dr;
+      c[l] = alpha * (vi - en[l]) * dr;
+    }
+  };
+
+  // Adams-Moulton coeficients
+  const auto amDdu = inc * gr.du() * Param::AMcoefs<K>.AMd;
+  std::array<double, K> am;
+  for (std::size_t j = 0; j < K; ++j) {
+    am[j] = amDdu * Param::AMcoefs<K>.AMa[j];
+  }
+  const double a0 = amDdu * Param::AMcoefs<K>.AMaa;
+  const auto a02 = a0 * a0;
+
+  // Derivatives (df/du, dg/du) at previous AMO points, for each lane. Ring
+  // buffer, stored twice, so that the last AMO are always contiguous:
+  // [j0, j0+AMO), oldest first
+  constexpr auto AMO = std::size_t(K);
+  std::array<std::array<double, N>, 2 * AMO> df, dg;
+  for (std::size_t j = 0; j < AMO; ++j) {
+    const auto ri = r_start - inc * (K - int(j));
+    abc(ri);
+#pragma omp simd
+    for (std::size_t l = 0; l < N; ++l) {
+      df[j][l] = df[j + AMO][l] = a[l] * F[ri][l] + b[l] * G[ri][l];
+      dg[j][l] = dg[j + AMO][l] = c[l] * F[ri][l] - a[l] * G[ri][l];
+    }
+  }
+
+  std::size_t j0 = 0;
+  std::array<double, N> ipf, ipg;
+  for (int i = 0, ri = r_start; i < nosteps; ++i, ri += inc) {
+    abc(ri);
+    // sum_j am_j * df_j (same order as adamsMoulton)
+#pragma omp simd
+    for (std::size_t l = 0; l < N; ++l) {
+      ipf[l] = am[0] * df[j0][l];
+      ipg[l] = am[0] * dg[j0][l];
+    }
+    for (std::size_t j = 1; j < AMO; ++j) {
+#pragma omp simd
+      for (std::size_t l = 0; l < N; ++l) {
+        ipf[l] += am[j] * df[j0 + j][l];
+        ipg[l] += am[j] * dg[j0 + j][l];
+      }
+    }
+
+    const auto &Fp = F[ri - inc];
+    const auto &Gp = G[ri - inc];
+    auto &Fi = F[ri];
+    auto &Gi = G[ri];
+    std::array<double, N> fn, gn;
+#pragma omp simd
+    for (std::size_t l = 0; l < N; ++l) {
+      const auto d = -a[l];
+      const auto det_inv = 1.0 / (1.0 - a02 * (b[l] * c[l] - a[l] * d));
+      const auto sf = Fp[l] + ipf[l];
+      const auto sg = Gp[l] + ipg[l];
+      fn[l] = (sf - a0 * (d * sf - b[l] * sg)) * det_inv;
+      gn[l] = (sg - a0 * (-c[l] * sf + a[l] * sg)) * det_inv;
+    }
+    // Lanes outside their range keep existing (starting/zero) values. Checked
+    // per lane only near the ends (a masked select here would not vectorise)
+    if (ri >= lo_all && ri <= hi_all) {
+      Fi = fn;
+      Gi = gn;
+    } else {
+      for (std::size_t l = 0; l < N; ++l) {
+        if (ri >= lo[l] && ri <= hi[l]) {
+          Fi[l] = fn[l];
+          Gi[l] = gn[l];
+        }
+      }
+    }
+
+    // New 'last' derivative (replaces oldest)
+    auto &df_new = df[j0];
+    auto &dg_new = dg[j0];
+    auto &df_new2 = df[j0 + AMO];
+    auto &dg_new2 = dg[j0 + AMO];
+#pragma omp simd
+    for (std::size_t l = 0; l < N; ++l) {
+      df_new[l] = df_new2[l] = a[l] * Fi[l] + b[l] * Gi[l];
+      dg_new[l] = dg_new2[l] = c[l] * Fi[l] - a[l] * Gi[l];
+    }
+    j0 = j0 + 1 == AMO ? 0 : j0 + 1;
+  }
+}
+} // namespace
+
+//******************************************************************************
+template <std::size_t N>
+void adamsMoulton_batch(std::vector<std::array<double, N>> &F,
+                        std::vector<std::array<double, N>> &G,
+                        const std::array<int, N> &kappa,
+                        const std::array<double, N> &en,
+                        const std::vector<double> &v,
+                        const std::vector<double> &H_mag, const Grid &gr,
+                        const double alpha, const int inc,
+                        const std::array<int, N> &ni,
+                        const std::array<int, N> &nf) {
+  [[maybe_unused]] auto sp = IO::Profile::safeProfiler(__func__);
+  AM_order_switch([&](auto K) {
+    adamsMoulton_batch_K<K>(F, G, kappa, en, v, H_mag, gr, alpha, inc, ni, nf);
+  });
+}
+
+template void adamsMoulton_batch<4>(
+    std::vector<std::array<double, 4>> &F,
+    std::vector<std::array<double, 4>> &G, const std::array<int, 4> &kappa,
+    const std::array<double, 4> &en, const std::vector<double> &v,
+    const std::vector<double> &H_mag, const Grid &gr, const double alpha,
+    const int inc, const std::array<int, 4> &ni, const std::array<int, 4> &nf);
+template void adamsMoulton_batch<8>(
+    std::vector<std::array<double, 8>> &F,
+    std::vector<std::array<double, 8>> &G, const std::array<int, 8> &kappa,
+    const std::array<double, 8> &en, const std::vector<double> &v,
+    const std::vector<double> &H_mag, const Grid &gr, const double alpha,
+    const int inc, const std::array<int, 8> &ni, const std::array<int, 8> &nf);
+
+} // namespace Adams
+} // namespace DiracODE
@@ -0,0 +1,71 @@
+#pragma once
+#include <array>
+#include <memory>
+#include <vector>
+class DiracSpinor;
+class Grid;
+
+namespace DiracODE {
+
+//******************************************************************************
+//! @brief Batched regularAtOrigin(): solves for each Fs[i], with energy ens[i]
+/*! @details
+All systems share the local potential v (and H_mag), but each has its own
+kappa (taken from Fs[i]) and energy. Same result as calling regularAtOrigin()
+for each, but several systems are integrated together, one per SIMD lane (see
+Adams::adamsMoulton_batch).
+*/
+void regularAtOrigin(std::vector<DiracSpinor> &Fs,
+                     const std::vector<double> &ens,
+                     const std::vector<double> &v,
+                     const std::vector<double> &H_mag, const double alpha);
+
+//! @brief Batched regularAtInfinity(): solves for each Fs[i], with energy
+//! ens[i] (see batched regularAtOrigin)
+void regularAtInfinity(std::vector<DiracSpinor> &Fs,
+                       const std::vector<double> &ens,
+                       const std::vector<double> &v,
+                       const std::vector<double> &H_mag, const double alpha);
+
+//! @brief As above, but returns solutions for each (kappas[i], ens[i])
+[[nodiscard]] std::vector<DiracSpinor>
+regularAtOrigin(const std::vector<int> &kappas, const std::vector<double> &ens,
+                const std::vector<double> &v, const std::vector<double> &H_mag,
+                const double alpha, std::shared_ptr<const Grid> rgrid);
+
+//! @brief As above, but returns solutions for each (kappas[i], ens[i])
+[[nodiscard]] std::vector<DiracSpinor> regularAtInfinity(
+    const std::vector<int> &kappas, const std::vector<double> &ens,
+    const std::vector<double> &v, const std::vector<double> &H_mag,
+    const double alpha, std::shared_ptr<const Grid> rgrid);
+
+namespace Adams {
+
+//******************************************************************************
+//! @brief Adams-Moulton integration, for N independent systems at once
+/*! @details
+Same recurrence as adamsMoulton(), for N systems (lanes) with different
+(kappa, en), but the same grid and local potential (v, H_mag). The recurrence
+is serial in r, so the lanes are advanced in lockstep: grid and potential are
+loaded once per point, and each operation acts on all N lanes (SIMD).
+  - F, G: solutions, stored [point][lane]. On input, must hold the starting
+(boundary) values for each lane; other points should be zero.
+  - inc = +1 (outward) or -1 (inward). Lane l is integrated from ni[l] to
+nf[l] (inclusive) in that direction; if nf[l] is 'before' ni[l], lane is not
+integrated at all. Outside that range, F, G are left as they are (so, the
+starting values, and zeros, are used as that lane's derivative history).
+  - No exchange term (VxFa) [only for homogeneous solutions].
+*/
+template <std::size_t N>
+void adamsMoulton_batch(std::vector<std::array<double, N>> &F,
+                        std::vector<std::array<double, N>> &G,
+                        const std::array<int, N> &kappa,
+                        const std::array<double, N> &en,
+                        const std::vector<double> &v,
+                        const std::vector<double> &H_mag, const Grid &gr,
+                        const double alpha, const int inc,
+                        const std::array<int, N> &ni,
+                        const std::array<int, N> &nf);
+
+} // namespace Adams
+} // namespace DiracODE
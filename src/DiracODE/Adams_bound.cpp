@@ -13,6 +13,7 @@
 #include <cassert>
 #include <cmath>
 #include <iostream>
+#include <utility>
 #include <vector>
 
 // Unfortunately, seems too messy to fix this
@@ -32,6 +33,15 @@ namespace DiracODE {
 static constexpr bool do_debug = false;
 
 using namespace Adams;
+
+// Order of Adams-Moulton method (see set_AM_order)
+static int s_AM_order = Param::AMO;
+
+//******************************************************************************
+void set_AM_order(int order) { s_AM_order = std::clamp(order, 5, 8); }
+
+int get_AM_order() { return s_AM_order; }
+
 //******************************************************************************
 void boundState(DiracSpinor &psi, const double en0,
                 const std::vector<double> &v, const std::vector<double> &H_mag,
@@ -68,7 +78,11 @@ Rough description of method:
    If the correct number of nodes, uses perturbation theory to make minor
    corrections to the energy to 'zoom in' (matching the in/out solution for
    g), then re-starts from step 2.
-Continues until this energy adjustment falls below a prescribed threshold.
+   The PT correction is a Newton step with an approximate derivative, so on
+   its own converges only linearly. Once there are two such trials (with the
+   same ctp and pinf), the step is corrected using the secant through them.
+Continues until this energy adjustment falls below a prescribed threshold
+(or stops decreasing, once at the level of numerical noise).
 
 Orbitals defined:
   psi := (1/r) {f O_k, ig O_(-k)}
@@ -99,18 +113,24 @@ Orbitals defined:
   double t_eps = 1.0;
   double t_eps_prev = 1.0;
   double anorm = 1.0;
+  // Workspace for inward solution, and dg (gout-gin), re-used for each trial
+  std::vector<double> f_in(rgrid.num_points()), g_in(rgrid.num_points());
+  std::vector<double> dg(2 * Param::d_ctp + 1);
+  // For profiling: each trial is logged, per orbital
+  const auto symbol = IO::Profile::do_profile ? psi.shortSymbol() : "";
   int t_its = 1;
   for (; t_its < Param::max_its; ++t_its) {
+    [[maybe_unused]] auto sp_it =
+        IO::Profile::safeProfiler("boundState_trial", symbol.c_str());
     t_pinf = Adams::findPracticalInfinity(t_en, v, rgrid.r(), Param::cALR);
     const int ctp =
         Adams::findClassicalTurningPoint(t_en, v, t_pinf, Param::d_ctp);
 
     // Find solution (f,g) to DE for given energy:
     // Also stores dg (gout-gin) for PT [used for PT to find better e]
-    std::vector<double> dg(2 * Param::d_ctp + 1);
-    Adams::trialDiracSolution(psi.set_f(), psi.set_g(), dg, t_en, psi.k, v,
-                              H_mag, rgrid, ctp, Param::d_ctp, t_pinf, alpha,
-                              VxFa, Fa0, zion);
+    Adams::trialDiracSolution(psi.set_f(), psi.set_g(), f_in, g_in, dg, t_en,
+                              psi.k, v, H_mag, rgrid, ctp, Param::d_ctp,
+                              t_pinf, alpha, VxFa, Fa0, zion);
 
     const int counted_nodes = Adams::countNodes(psi.f(), t_pinf);
 
@@ -121,7 +141,7 @@ Orbitals defined:
       correct_nodes = true;
       anorm = psi * psi;
       t_en = Adams::smallEnergyChangePT(en_old, anorm, psi.f(), dg, ctp,
-                                        Param::d_ctp, alpha, sofar);
+                                        Param::d_ctp, t_pinf, alpha, &sofar);
     } else {
       correct_nodes = false;
       const bool toomany_nodes =
@@ -139,8 +159,11 @@ Orbitals defined:
 
     auto getting_worse = (t_its > 10 && t_eps >= 1.2 * t_eps_prev &&
                           correct_nodes && t_eps < 1.0e-5);
+    // Energy already found to within numerical noise: steps stop decreasing
+    auto at_noise =
+        (correct_nodes && t_eps < 1.0e-12 && t_eps >= 0.5 * t_eps_prev);
     auto converged = (t_eps < eps_goal && correct_nodes);
-    if (converged || getting_worse)
+    if (converged || getting_worse || at_noise)
       break;
     t_eps_prev = t_eps;
   } // END itterations
@@ -239,8 +262,8 @@ void largeEnergyChange(double *en, TrackEnGuess *sofar_ptr, double frac_de,
 double smallEnergyChangePT(const double en, const double anorm,
                            const std::vector<double> &f,
                            const std::vector<double> &dg, const int ctp,
-                           const int d_ctp, const double alpha,
-                           const TrackEnGuess &sofar)
+                           const int d_ctp, const int pinf, const double alpha,
+                           TrackEnGuess *sofar_ptr)
 // delta E = c*f(r)*[g_out(r)-g_in(r)] - evaluate at ctp
 // nb: wf not yet normalised (anorm is input param)!
 {
@@ -258,6 +281,28 @@ double smallEnergyChangePT(const double en, const double anorm,
   const double de = p_del_q / (alpha * anorm * denom);
   double new_en = en + de;
 
+  auto &sofar = *sofar_ptr; // for ease of typing only
+  // Root is above en if de > 0 (and below if de < 0): tighten bracket
+  if (de > 0.0)
+    sofar.pt_low = std::max(sofar.pt_low, en);
+  else
+    sofar.pt_high = std::min(sofar.pt_high, en);
+
+  // de(en) is ~linear near root, but PT slope is off by a (~constant) factor;
+  // secant through previous PT trial corrects it. Only if ctp, pinf same (so
+  // de(en) is smooth), and the correction is modest - otherwise, keep PT step
+  if (sofar.ctp_pt == ctp && sofar.pinf_pt == pinf && de != sofar.de_pt) {
+    const auto slope = (en - sofar.en_pt) / (sofar.de_pt - de);
+    const auto en_secant = en + slope * de;
+    if (slope > 0.5 && slope < 2.0 && en_secant > sofar.pt_low &&
+        en_secant < sofar.pt_high)
+      new_en = en_secant;
+  }
+  sofar.en_pt = en;
+  sofar.de_pt = de;
+  sofar.ctp_pt = ctp;
+  sofar.pinf_pt = pinf;
+
   if ((sofar.count_toofew != 0) && (new_en < sofar.low_en)) {
     new_en = 0.5 * (en + sofar.low_en);
   } else if ((sofar.count_toomany != 0) && (new_en > sofar.high_en)) {
@@ -312,6 +357,7 @@ int countNodes(const std::vector<double> &f, const int pinf)
 
 //******************************************************************************
 void trialDiracSolution(std::vector<double> &f, std::vector<double> &g,
+                        std::vector<double> &f_in, std::vector<double> &g_in,
                         std::vector<double> &dg, const double en, const int ka,
                         const std::vector<double> &v,
                         const std::vector<double> &H_mag, const Grid &gr,
@@ -326,7 +372,7 @@ void trialDiracSolution(std::vector<double> &f, std::vector<double> &g,
   [[maybe_unused]] auto sp = IO::Profile::safeProfiler(__func__);
   DiracMatrix Hd(gr, v, ka, en, alpha, H_mag, VxFa, Fa0, zion);
   outwardAM(f, g, Hd, ctp + d_ctp);
-  std::vector<double> f_in(gr.num_points()), g_in(gr.num_points());
+  // nb: f_in, g_in only used from ctp - d_ctp to pinf - 1 (all over-written)
   inwardAM(f_in, g_in, Hd, ctp - d_ctp, pinf - 1);
   joinInOutSolutions(f, g, dg, f_in, g_in, ctp, d_ctp, pinf);
 }
@@ -372,10 +418,36 @@ void joinInOutSolutions(std::vector<double> &f, std::vector<double> &g,
 }
 
 //******************************************************************************
+namespace {
+// sum_j am_j * df_j, unrolled at compile time (same order as inner_product)
+template <std::size_t N, std::size_t... j>
+double am_sum(const std::array<double, N> &am, const std::array<double, N> &df,
+              std::index_sequence<j...>) {
+  return (... + (am[j] * df[j]));
+}
+} // namespace
+
+void outwardAM(std::vector<double> &f, std::vector<double> &g,
+               const DiracMatrix &Hd, const int nf) {
+  AM_order_switch([&](auto K) { outwardAM<K>(f, g, Hd, nf); });
+}
+
+void inwardAM(std::vector<double> &f, std::vector<double> &g,
+              const DiracMatrix &Hd, const int nf, const int pinf) {
+  AM_order_switch([&](auto K) { inwardAM<K>(f, g, Hd, nf, pinf); });
+}
+
+void adamsMoulton(std::vector<double> &f, std::vector<double> &g,
+                  const DiracMatrix &Hd, const int ni, const int nf) {
+  AM_order_switch([&](auto K) { adamsMoulton<K>(f, g, Hd, ni, nf); });
+}
+
+//******************************************************************************
+template <int K>
 void outwardAM(std::vector<double> &f, std::vector<double> &g,
                const DiracMatrix &Hd, const int nf)
 // Program to start the OUTWARD integration.
-// Starts from 0, and uses an expansion(?) to go to (num_loops*AMO).
+// Starts from 0, and uses an expansion(?) to go to (num_loops*K).
 // Then, it then call ADAMS-MOULTON, to finish
 // (from num_loops*AMO+1 to nf = ctp+d_ctp)
 {
@@ -398,16 +470,16 @@ void outwardAM(std::vector<double> &f, std::vector<double> &g,
   f[0] = std::pow(r[0], ga0) * u0;
   g[0] = std::pow(r[0], ga0) * v0;
 
-  // loop through and find first Param::num_loops*AMO points of wf
+  // loop through and find first Param::num_loops*K points of wf
   for (int ln = 0; ln < Param::num_loops; ln++) {
-    const int i0 = ln * Param::AMO + 1;
+    const int i0 = ln * K + 1;
 
     // defines/populates em expansion coeficients (then inverts)
-    std::array<double, Param::AMO> coefa, coefb, coefc, coefd;
-    std::array<double, Param::AMO> ga;
-    LinAlg::SqMatrix em(Param::AMO);
-    const auto oid_du = Param::AMcoef.OId * du;
-    for (int i = 0; i < Param::AMO; i++) {
+    std::array<double, K> coefa, coefb, coefc, coefd;
+    std::array<double, K> ga;
+    LinAlg::SqMatrix em(K);
+    const auto oid_du = Param::AMcoefs<K>.OId * du;
+    for (int i = 0; i < K; i++) {
       const std::size_t ir = static_cast<std::size_t>(i + i0);
       const auto az = -v[ir] * r[ir] * alpha;
       ga[i] = std::sqrt(ka * ka - az * az);
@@ -416,8 +488,8 @@ void outwardAM(std::vector<double> &f, std::vector<double> &g,
       coefb[i] = -oid_du * Hd.b(ir);
       coefc[i] = -oid_du * Hd.c(ir);
       coefd[i] = oid_du * (Hd.d(ir) - ga[i] * dror);
-      for (int j = 0; j < Param::AMO; j++) {
-        em[i][j] = Param::AMcoef.OIe[i][j];
+      for (int j = 0; j < K; j++) {
+        em[i][j] = Param::AMcoefs<K>.OIe[i][j];
       }
       em[i][i] -= coefd[i];
     }
@@ -425,13 +497,14 @@ void outwardAM(std::vector<double> &f, std::vector<double> &g,
     em.invert();
 
     // defines/populates fm, s coefs
-    std::array<double, Param::AMO> s;
-    LinAlg::SqMatrix fm(Param::AMO);
-    for (int i = 0; i < Param::AMO; i++) {
-      s[i] = -Param::AMcoef.OIa[i] * u0;
-      for (int j = 0; j < Param::AMO; j++) {
-        fm[i][j] = Param::AMcoef.OIe[i][j] - coefb[i] * em[i][j] * coefc[j];
-        s[i] += coefb[i] * em[i][j] * Param::AMcoef.OIa[j] * v0;
+    std::array<double, K> s;
+    LinAlg::SqMatrix fm(K);
+    for (int i = 0; i < K; i++) {
+      s[i] = -Param::AMcoefs<K>.OIa[i] * u0;
+      for (int j = 0; j < K; j++) {
+        fm[i][j] =
+            Param::AMcoefs<K>.OIe[i][j] - coefb[i] * em[i][j] * coefc[j];
+        s[i] += coefb[i] * em[i][j] * Param::AMcoefs<K>.OIa[j] * v0;
       }
       fm[i][i] -= coefa[i];
     }
@@ -440,23 +513,23 @@ void outwardAM(std::vector<double> &f, std::vector<double> &g,
 
     // writes u(r) in terms of coefs and the inverse of fm
     // P(r) = r^gamma u(r)
-    std::array<double, Param::AMO> us;
-    for (int i = 0; i < Param::AMO; i++) {
+    std::array<double, K> us;
+    for (int i = 0; i < K; i++) {
       us[i] = qip::inner_product(s, fm[i]);
     }
 
     // writes v(r) in terms of coefs + u(r)
     // Q(r) = r^gamma v(r)
-    std::array<double, Param::AMO> vs;
-    for (int i = 0; i < Param::AMO; i++) {
+    std::array<double, K> vs;
+    for (int i = 0; i < K; i++) {
       vs[i] = 0;
-      for (int j = 0; j < Param::AMO; j++) {
-        vs[i] -= em[i][j] * (coefc[j] * us[j] + Param::AMcoef.OIa[j] * v0);
+      for (int j = 0; j < K; j++) {
+        vs[i] -= em[i][j] * (coefc[j] * us[j] + Param::AMcoefs<K>.OIa[j] * v0);
       }
     }
 
     // writes wavefunction: P= r^gamma u(r) etc..
-    for (int i = 0; i < Param::AMO; i++) {
+    for (int i = 0; i < K; i++) {
       const auto r_ga = std::pow(r[i + i0], ga[i]);
       f[i + i0] = r_ga * us[i];
       g[i + i0] = r_ga * vs[i];
@@ -468,15 +541,16 @@ void outwardAM(std::vector<double> &f, std::vector<double> &g,
 
   } // END loop through outint [num_loops]
 
-  // Call adamsmoulton to finish integration from (num_loops*AMO) to ctp+d_ctp
-  const auto na = Param::num_loops * Param::AMO + 1;
+  // Call adamsmoulton to finish integration from (num_loops*K) to ctp+d_ctp
+  const auto na = Param::num_loops * K + 1;
   if (nf > na)
-    adamsMoulton(f, g, Hd, na, nf);
+    adamsMoulton<K>(f, g, Hd, na, nf);
 
   return;
 }
 
 //******************************************************************
+template <int K>
 void inwardAM(std::vector<double> &f, std::vector<double> &g,
               const DiracMatrix &Hd, const int nf, const int pinf)
 // Program to start the INWARD integration.
@@ -520,7 +594,7 @@ void inwardAM(std::vector<double> &f, std::vector<double> &g,
   // Generates last `AMO' points for P and Q [actually AMO+1?]
   const double f1 = std::sqrt(1.0 + en * alpha2 * 0.5);
   const double f2 = std::sqrt(-en * 0.5) * alpha;
-  for (int i = pinf; i >= (pinf - Param::AMO); i--) {
+  for (int i = pinf; i >= (pinf - K); i--) {
     const double rfac = std::pow(r[i], sigma) * std::exp(-lambda * r[i]);
     double ps = 1.0;
     double qs = 0.0;
@@ -545,11 +619,12 @@ void inwardAM(std::vector<double> &f, std::vector<double> &g,
     g[i] = rfac * (f1 * qs - f2 * ps);
   }
 
-  if ((pinf - Param::AMO - 1) >= nf)
-    adamsMoulton(f, g, Hd, pinf - Param::AMO - 1, nf);
+  if ((pinf - K - 1) >= nf)
+    adamsMoulton<K>(f, g, Hd, pinf - K - 1, nf);
 }
 
 //******************************************************************************
+template <int K>
 void adamsMoulton(std::vector<double> &f, std::vector<double> &g,
                   const DiracMatrix &Hd, const int ni, const int nf)
 // program finishes the INWARD/OUTWARD integrations (ADAMS-MOULTON)
@@ -565,24 +640,24 @@ void adamsMoulton(std::vector<double> &f, std::vector<double> &g,
                         : 0.0;
 
   // create arrays for wf derivatives + Adams-Moulton coeficients
-  const auto amDdu = inc * Hd.pgr->du() * Param::AMcoef.AMd;
-  std::array<double, Param::AMO> df, dg;
-  std::array<double, Param::AMO> am;
-  const auto ri0 = ni - inc * Param::AMO;
-  for (auto i = 0, ri = ri0; i < Param::AMO; i++, ri += inc) {
+  const auto amDdu = inc * Hd.pgr->du() * Param::AMcoefs<K>.AMd;
+  std::array<double, K> df, dg;
+  std::array<double, K> am;
+  const auto ri0 = ni - inc * K;
+  for (auto i = 0, ri = ri0; i < K; i++, ri += inc) {
     df[i] = Hd.dfdu(f, g, ri) + Xscl * Hd.dfdu_X(ri);
     dg[i] = Hd.dgdu(f, g, ri) + Xscl * Hd.dgdu_X(ri);
-    am[i] = amDdu * Param::AMcoef.AMa[i];
+    am[i] = amDdu * Param::AMcoefs<K>.AMa[i];
   }
 
   // integrates the function from ni to the c.t.p
-  const double a0 = amDdu * Param::AMcoef.AMaa;
+  const double a0 = amDdu * Param::AMcoefs<K>.AMaa;
   const auto a02 = a0 * a0;
   for (int i = 0, ri = ni; i < nosteps; i++, ri += inc) {
     const auto [a, b, c, d] = Hd.abcd(ri);
     const double det_inv = 1.0 / (1.0 - a02 * (b * c - a * d));
-    double sf = f[ri - inc] + qip::inner_product(am, df);
-    double sg = g[ri - inc] + qip::inner_product(am, dg);
+    double sf = f[ri - inc] + am_sum(am, df, std::make_index_sequence<K>{});
+    double sg = g[ri - inc] + am_sum(am, dg, std::make_index_sequence<K>{});
 
     if (Hd.VxFa) {
       // XXX nb: issue is that 'f' is not normalised, but VxFa is!
@@ -599,17 +674,42 @@ void adamsMoulton(std::vector<double> &f, std::vector<double> &g,
     f[ri] = (sf - a0 * (d * sf - b * sg)) * det_inv;
     g[ri] = (sg - a0 * (-c * sf + a * sg)) * det_inv;
     // Shift the derivative along
-    for (int l = 0; l < (Param::AMO - 1); l++) {
+    for (std::size_t l = 0; l < (K - 1); l++) {
       df[l] = df[l + 1];
       dg[l] = dg[l + 1];
     }
-    // gets new 'last' derivative
-    df.back() = Hd.dfdu(f, g, ri) + Xscl * Hd.dfdu_X(ri);
-    dg.back() = Hd.dgdu(f, g, ri) + Xscl * Hd.dgdu_X(ri);
+    // gets new 'last' derivative (same as Hd.dfdu, re-using a,b,c,d)
+    df.back() = a * f[ri] + b * g[ri] + Xscl * Hd.dfdu_X(ri);
+    dg.back() = c * f[ri] + d * g[ri] + Xscl * Hd.dgdu_X(ri);
   }
 
 } // END adamsmoulton
 
+template void outwardAM<5>(std::vector<double> &, std::vector<double> &,
+                           const DiracMatrix &, const int);
+template void outwardAM<6>(std::vector<double> &, std::vector<double> &,
+                           const DiracMatrix &, const int);
+template void outwardAM<7>(std::vector<double> &, std::vector<double> &,
+                           const DiracMatrix &, const int);
+template void outwardAM<8>(std::vector<double> &, std::vector<double> &,
+                           const DiracMatrix &, const int);
+template void inwardAM<5>(std::vector<double> &, std::vector<double> &,
+                          const DiracMatrix &, const int, const int);
+template void inwardAM<6>(std::vector<double> &, std::vector<double> &,
+                          const DiracMatrix &, const int, const int);
+template void inwardAM<7>(std::vector<double> &, std::vector<double> &,
+                          const DiracMatrix &, const int, const int);
+template void inwardAM<8>(std::vector<double> &, std::vector<double> &,
+                          const DiracMatrix &, const int, const int);
+template void adamsMoulton<5>(std::vector<double> &, std::vector<double> &,
+                              const DiracMatrix &, const int, const int);
+template void adamsMoulton<6>(std::vector<double> &, std::vector<double> &,
+                              const DiracMatrix &, const int, const int);
+template void adamsMoulton<7>(std::vector<double> &, std::vector<double> &,
+                              const DiracMatrix &, const int, const int);
+template void adamsMoulton<8>(std::vector<double> &, std::vector<double> &,
+                              const DiracMatrix &, const int, const int);
+
 //******************************************************************************
 //******************************************************************************
 DiracMatrix::DiracMatrix(const Grid &in_grid, const std::vector<double> &in_v,
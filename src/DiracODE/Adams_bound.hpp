@@ -1,5 +1,7 @@
 #pragma once
 #include "Adams_coefs.hpp"
+#include <limits>
+#include <type_traits>
 #include <utility>
 #include <vector>
 class DiracSpinor;
@@ -17,12 +19,28 @@ fine-structure constant
 */
 namespace DiracODE {
 
+//******************************************************************************
+//! @brief Sets order of the Adams-Moulton method used by all DiracODE solvers
+/*! @details
+Order must be between 5 and 8 (values outside are clamped); default is
+Adams::Param::AMO. Lower order is faster, higher order is more accurate for a
+given grid. Each order has its own (compile-time) implementation. Global
+setting: set once (e.g., from input) before solving - not while solving.
+*/
+void set_AM_order(int order);
+
+//! Order of the Adams-Moulton method currently used (see set_AM_order)
+int get_AM_order();
+
 //******************************************************************************
 //! @brief Solves bound-state problem for local potential (en < 0)
 /*! @details
 \f[ (H_0 + v - \epsilon_a)F_a = 0\f]
 en0 is initial energy guess (must be reasonably good).
 log_eps: log10(eps); eps is convergence target for energy.
+Number of trial solutions (in+out integrations) used is stored in Fa.its().
+If compiled with IOPROFILER, each trial is also logged by the profiler, per
+orbital (as "boundState_trial_<orbital>").
 */
 void boundState(DiracSpinor &Fa, const double en0, const std::vector<double> &v,
                 const std::vector<double> &H_mag, const double alpha,
@@ -86,6 +104,7 @@ homogeneous equation  (H-en)Fa = 0 [reg @ origin, and infinity, respectively].
 cases they can be re-used)
   - These Spinors are solved internally and over-written, they don't need to be
 solved first (i.e., they are out parameters, not in/out parameters)
+  - To solve for many sources with the same (kappa, en, v), use InhomogSolver
 */
 void solve_inhomog(DiracSpinor &Fa, DiracSpinor &Fzero, DiracSpinor &Finf,
                    const double en, const std::vector<double> &v,
@@ -97,8 +116,9 @@ namespace Adams {
 //******************************************************************************
 // Parameters used for Adams-Moulton mehtod:
 namespace Param {
-constexpr int AMO = 7;            // Adams-Moulton (between 5 and 8)
-constexpr AdamsCoefs<AMO> AMcoef; // Adamns-Moulton coeficients [defined .h]
+constexpr int AMO = 7; // Default Adams-Moulton order (between 5 and 8)
+// Adamns-Moulton coeficients, for order K [defined .h]
+template <int K> constexpr AdamsCoefs<K> AMcoefs{};
 constexpr double cALR = 550;      // 'assymptotically large r [kinda..]' (=800)
 constexpr int max_its = 99;       // Max # attempts at converging [sove bs] (30)
 constexpr double lfrac_de = 0.12; // 'large' energy variations (0.1 => 10%)
@@ -122,6 +142,21 @@ static_assert(Param::AMO >= 5 && Param::AMO <= 8,
 
 } // namespace Param
 
+//! Calls f(std::integral_constant<int, K>{}), K = current order (get_AM_order).
+//! Picks the compile-time (order K) version of the integration routines.
+template <typename Function> auto AM_order_switch(Function &&f) {
+  switch (get_AM_order()) {
+  case 5:
+    return f(std::integral_constant<int, 5>{});
+  case 6:
+    return f(std::integral_constant<int, 6>{});
+  case 8:
+    return f(std::integral_constant<int, 8>{});
+  default:
+    return f(std::integral_constant<int, 7>{});
+  }
+}
+
 //******************************************************************************
 class DiracMatrix {
   // Notation:
@@ -165,6 +200,15 @@ struct TrackEnGuess {
   // Upper and lower energy window before correct # nodes
   double high_en = 0.0;
   double low_en = 0.0;
+  // Previous trial with correct # nodes: energy, PT energy correction, and
+  // ctp/pinf it used. For secant correction to PT step
+  double en_pt = 0.0;
+  double de_pt = 0.0;
+  int ctp_pt = -1;
+  int pinf_pt = -1;
+  // Bracket from PT trials (sign of PT correction): root in (pt_low, pt_high)
+  double pt_low = -std::numeric_limits<double>::max();
+  double pt_high = 0.0;
 };
 
 // -----------------------------------------------------------------------------
@@ -174,7 +218,9 @@ int findPracticalInfinity(const double en, const std::vector<double> &v,
 int findClassicalTurningPoint(const double en, const std::vector<double> &v,
                               const int pinf, const int d_ctp);
 
+// f_in, g_in: workspace for inward solution (num_points); re-used by caller
 void trialDiracSolution(std::vector<double> &f, std::vector<double> &g,
+                        std::vector<double> &f_in, std::vector<double> &g_in,
                         std::vector<double> &dg, const double en, const int ka,
                         const std::vector<double> &v,
                         const std::vector<double> &H_mag, const Grid &gr,
@@ -190,18 +236,34 @@ int countNodes(const std::vector<double> &f, const int maxi);
 void largeEnergyChange(double *en, TrackEnGuess *sofar, double frac_de,
                        bool toomany_nodes);
 
+// PT (Newton) energy step, with secant correction from previous PT trial
+// (stored/updated in sofar), kept inside the bracket
 double smallEnergyChangePT(const double en, const double anorm,
                            const std::vector<double> &f,
                            const std::vector<double> &dg, const int ctp,
-                           const int d_ctp, const double alpha,
-                           const TrackEnGuess &sofar);
+                           const int d_ctp, const int pinf, const double alpha,
+                           TrackEnGuess *sofar);
+
+// Integration routines: order given by get_AM_order(). The <K> versions
+// are for a fixed order K (5 to 8); the first use the appropriate <K> version
+void outwardAM(std::vector<double> &f, std::vector<double> &g,
+               const DiracMatrix &Hd, const int final);
+
+void inwardAM(std::vector<double> &f, std::vector<double> &g,
+              const DiracMatrix &Hd, const int ctp, const int pinf);
+
+void adamsMoulton(std::vector<double> &f, std::vector<double> &g,
+                  const DiracMatrix &Hd, const int ni, const int nf);
 
+template <int K>
 void outwardAM(std::vector<double> &f, std::vector<double> &g,
                const DiracMatrix &Hd, const int final);
 
+template <int K>
 void inwardAM(std::vector<double> &f, std::vector<double> &g,
               const DiracMatrix &Hd, const int ctp, const int pinf);
 
+template <int K>
 void adamsMoulton(std::vector<double> &f, std::vector<double> &g,
                   const DiracMatrix &Hd, const int ni, const int nf);
 
@@ -1,4 +1,5 @@
 #pragma once
 #include "DiracODE/Adams_Greens.hpp"
+#include "DiracODE/Adams_batch.hpp"
 #include "DiracODE/Adams_bound.hpp"
 #include "DiracODE/Adams_continuum.hpp"
@@ -63,6 +63,22 @@ bool DiracODE(std::ostream &obuff) {
                              worst_F->eps(), 0.0, 1.0e-14);
   }
 
+  { // Energy search (PT + secant): from a close guess, few trials needed
+    int max_its = 0;
+    double max_eps = 0.0;
+    for (const auto &Fa : orbitals) {
+      auto Fb = DiracSpinor(Fa.n, Fa.k, grid);
+      DiracODE::boundState(Fb, Fa.en() * (1.0 + 1.0e-6), v_nuc, {},
+                           PhysConst::alpha, 15);
+      max_its = std::max(max_its, Fb.its());
+      max_eps = std::max(max_eps, std::abs((Fb.en() - Fa.en()) / Fa.en()));
+    }
+    pass &= qip::check_value(&obuff, "boundState: its (close guess)", max_its,
+                             0, 4);
+    pass &= qip::check_value(&obuff, "boundState: en (close guess)", max_eps,
+                             0.0, 1.0e-14);
+  }
+
   { // Check orthogonality of orbitals:
     const auto [eps, worst] = DiracSpinor::check_ortho(orbitals, orbitals);
     pass &= qip::check_value(&obuff, "orth " + worst, eps, 0.0, 1.0e-10);
@@ -91,6 +107,24 @@ bool DiracODE(std::ostream &obuff) {
                          eps, 0.0, 1.0e-10);
   }
 
+  { // Each Adams-Moulton order (set_AM_order): energy vs. exact
+    const auto order0 = DiracODE::get_AM_order();
+    for (int order = 5; order <= 8; ++order) {
+      DiracODE::set_AM_order(order);
+      double eps = 0.0;
+      for (const auto &[n, k, en] : AtomData::listOfStates_nk("5spd")) {
+        auto Fa = DiracSpinor(n, k, grid);
+        DiracODE::boundState(Fa, -(Zeff * Zeff) / (2.0 * n * n), v_nuc, {},
+                             PhysConst::alpha, 15);
+        const auto exact = AtomData::diracen(Zeff, n, k, PhysConst::alpha);
+        eps = std::max(eps, std::abs((Fa.en() - exact) / exact));
+      }
+      pass &= qip::check_value(&obuff, "en, AM order " + std::to_string(order),
+                               eps, 0.0, 1.0e-8);
+    }
+    DiracODE::set_AM_order(order0);
+  }
+
   { // Check radial integrals (r, r^2, 1/r, 1/r^2)
 
     // Define four radial operators. Designed to test wavefunction at low,
@@ -191,6 +225,141 @@ bool DiracODE(std::ostream &obuff) {
                              1.0e-11);
   }
 
+  { // InhomogSolver: re-used homogeneous solutions, vs. solve_inhomog
+    // (H + v - e)Fb = -vp*Fa, for several sources of each kappa
+    std::vector<double> vp;
+    for (const auto r : grid->r()) {
+      vp.push_back(-0.3 / (r * r * r * r + 1.0));
+    }
+    const auto v_tot = qip::add(v_nuc, vp);
+
+    DiracODE::InhomogSolver solver(grid, PhysConst::alpha);
+    double max_eps = 0.0;
+    int num_updates = 0;
+    for (const int k : {-1, 1, -2, 2}) {
+      const auto en = -0.8 * Zeff * Zeff / 8.0;
+      std::vector<DiracSpinor> sources;
+      for (int n = AtomData::l_k(k) + 1; n <= 4; ++n) {
+        auto Fa = DiracSpinor(n, k, grid);
+        DiracODE::boundState(Fa, -(Zeff * Zeff) / (2.0 * n * n), v_tot, {},
+                             PhysConst::alpha, 15);
+        sources.push_back(-1.0 * (vp * Fa));
+      }
+      std::vector<DiracSpinor> Fbs;
+      for (const auto &source : sources) {
+        num_updates += solver.update(k, en, v_nuc, {});
+        Fbs.push_back(solver.solve(source));
+      }
+      const auto Fbs_batch = solver.solve(sources);
+      for (auto i = 0ul; i < sources.size(); ++i) {
+        const auto Fb0 = DiracODE::solve_inhomog(k, en, v_nuc, {},
+                                                 PhysConst::alpha, sources[i]);
+        const auto eps = std::max((Fbs[i] - Fb0) * (Fbs[i] - Fb0),
+                                  (Fbs_batch[i] - Fb0) * (Fbs_batch[i] - Fb0)) /
+                         (Fb0 * Fb0);
+        max_eps = std::max(max_eps, eps);
+      }
+    }
+    pass &= qip::check_value(&obuff, "InhomogSolver: value", max_eps, 0.0,
+                             1.0e-20);
+    // Homogeneous solutions only solved once per kappa
+    pass &= qip::check(&obuff, "InhomogSolver: updates", num_updates, 4);
+  }
+
+  { // Batched (multi-lane) homogeneous solutions, vs. one at a time
+    // 11 systems: uses 8 and 4 lanes (with padding). Different energies, so
+    // lanes have different pinf (ranges)
+    std::vector<int> kappas{-1, 1, -2, 2, -3, 3, -4, 4, -5, 5, -6};
+    std::vector<double> ens;
+    for (auto i = 0ul; i < kappas.size(); ++i) {
+      ens.push_back(-0.1 * Zeff * Zeff / double(i + 1));
+    }
+    const auto x0s = DiracODE::regularAtOrigin(kappas, ens, v_nuc, {},
+                                               PhysConst::alpha, grid);
+    const auto xIs = DiracODE::regularAtInfinity(kappas, ens, v_nuc, {},
+                                                 PhysConst::alpha, grid);
+    double max_eps = 0.0;
+    bool max_pt_ok = true;
+    for (auto i = 0ul; i < kappas.size(); ++i) {
+      auto x0 = DiracSpinor(0, kappas[i], grid);
+      auto xI = DiracSpinor(0, kappas[i], grid);
+      DiracODE::regularAtOrigin(x0, ens[i], v_nuc, {}, PhysConst::alpha);
+      DiracODE::regularAtInfinity(xI, ens[i], v_nuc, {}, PhysConst::alpha);
+      max_eps = std::max({max_eps, (x0 - x0s[i]) * (x0 - x0s[i]) / (x0 * x0),
+                          (xI - xIs[i]) * (xI - xIs[i]) / (xI * xI)});
+      max_pt_ok &= x0.max_pt() == x0s[i].max_pt();
+      max_pt_ok &= xI.max_pt() == xIs[i].max_pt();
+    }
+    // Same operations, in same order: should be identical
+    pass &= qip::check_value(&obuff, "Batched regular@0,inf", max_eps, 0.0,
+                             1.0e-24);
+    pass &= qip::check(&obuff, "Batched regular@0,inf: pinf", max_pt_ok, true);
+  }
+
+  { // Non-local solver: V = lambda*|chi><chi|, chi bound state of v_nuc
+    // [1 + G0 V]F = G0 S has exact solution (Sherman-Morrison):
+    //   F = G0 S - lambda * G0 chi <chi|G0 S> / (1 + lambda <chi|G0 chi>)
+    // Eigenstate of (H0 + V) is chi, with en = e_chi + lambda. nb: energy
+    // only to ~1e-6, since Green's method (G0) and ODE discretisation differ
+    const double lambda = 0.05;
+    std::vector<double> vp;
+    for (const auto r : grid->r()) {
+      vp.push_back(0.1 / (r * r * r * r + 1.0));
+    }
+    const auto v_tot = qip::add(v_nuc, vp);
+
+    DiracODE::InhomogSolver G0(grid, PhysConst::alpha);
+    double max_eps_solve = 0.0, max_eps_en = 0.0, max_eps_F = 0.0;
+    bool wrong_state_flagged = true;
+    for (const int k : {-1, 1, -2}) {
+      const auto &chi = *std::find_if(
+          cbegin(orbitals), cend(orbitals),
+          [k](const auto &F) { return F.k == k && F.n == 3; });
+      const auto V = [&chi, lambda](const DiracSpinor &F) {
+        return (lambda * (chi * F)) * chi;
+      };
+
+      // Linear solve, for source S (arbitrary, not an eigenstate)
+      const auto en = 0.9 * chi.en();
+      G0.update(k, en, v_nuc, {});
+      const auto S = vp * chi;
+      auto F = DiracSpinor(chi.n, k, grid);
+      DiracODE::solve_nonlocal(F, S, G0, V);
+      const auto G0S = G0.solve(S);
+      const auto G0chi = G0.solve(chi);
+      const auto F0 =
+          G0S - (lambda * (chi * G0S) / (1.0 + lambda * (chi * G0chi))) * G0chi;
+      max_eps_solve = std::max(max_eps_solve, (F - F0) * (F - F0) / (F0 * F0));
+
+      // Eigenvalue problem, starting from state of different local potential
+      auto Fa = DiracSpinor(chi.n, k, grid);
+      DiracODE::boundState(Fa, chi.en(), v_tot, {}, PhysConst::alpha, 15);
+      DiracODE::boundState_nonlocal(Fa, Fa.en(), v_nuc, {}, PhysConst::alpha,
+                                    V);
+      const auto en_exact = chi.en() + lambda;
+      max_eps_en =
+          std::max(max_eps_en, std::abs((Fa.en() - en_exact) / en_exact));
+      max_eps_F = std::max(max_eps_F, std::abs(1.0 - std::abs(Fa * chi)));
+
+      // Starting guess is really the n=3 state: converges to it, but has the
+      // wrong number of nodes for n=4, so must be flagged as failed (eps=1)
+      auto Fw = DiracSpinor(chi.n + 1, k, grid);
+      Fw.set_f() = Fa.f();
+      Fw.set_g() = Fa.g();
+      DiracODE::boundState_nonlocal(Fw, Fa.en(), v_nuc, {}, PhysConst::alpha,
+                                    V);
+      wrong_state_flagged &= Fa.eps() < 1.0 && Fw.eps() == 1.0;
+    }
+    pass &= qip::check_value(&obuff, "Non-local: solve", max_eps_solve, 0.0,
+                             1.0e-18);
+    pass &= qip::check_value(&obuff, "Non-local: energy", max_eps_en, 0.0,
+                             1.0e-6);
+    pass &= qip::check_value(&obuff, "Non-local: orbital", max_eps_F, 0.0,
+                             1.0e-10);
+    pass &= qip::check(&obuff, "Non-local: wrong state", wrong_state_flagged,
+                       true);
+  }
+
   { // Test DiracODE HartreeFock method:
     // Solve: (Fa and Fb should be equal)
     // (H + v + vp - e)Fa = 0
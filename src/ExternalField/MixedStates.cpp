@@ -55,6 +55,9 @@ void solveMixedState(DiracSpinor &dF, const DiracSpinor &Fa, const double omega,
   auto dF0 = dF;
 
   for (int its = 0; true; its++) {
+    // nb: local exchange approx. must be re-formed from current dF each
+    // iteration: if held fixed (to re-use homogeneous solutions), iterations
+    // can diverge (e.g., for valence states)
     const auto vx = vex_approx(dF, core);
     const auto v = qip::add(vl, vx);
     auto rhs = (vx * dF) - vexFa(dF, core) - hFa;
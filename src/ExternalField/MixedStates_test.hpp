@@ -76,6 +76,26 @@ bool MixedStates(std::ostream &obuff) {
         best.eps, 0.0, 6e-7);
   }
 
+  {
+    // Starting from an existing solution (as in TDHF, or when omega changes)
+    // should converge to same solution as starting from scratch
+    const auto &Fv = *wf.getState(6, -1);
+    const auto &Fm = *wf.getState(6, 1);
+    const auto vl = wf.get_Vlocal(Fm.l());
+    const auto hFv = hE1.reduced_rhs(Fm.k, Fv);
+    DiracSpinor dF_prev{0, Fm.k, wf.rgrid};
+    double max_dev = 0.0;
+    for (const auto w : {0.0, 0.01, 0.02}) {
+      const auto dF = ExternalField::solveMixedState(Fm.k, Fv, w, vl, wf.alpha,
+                                                     wf.core, hFv, 1.0e-11);
+      ExternalField::solveMixedState(dF_prev, Fv, w, vl, wf.alpha, wf.core,
+                                     hFv, 1.0e-11);
+      const auto dev = std::sqrt((dF - dF_prev) * (dF - dF_prev) / (dF * dF));
+      max_dev = std::max(dev, max_dev);
+    }
+    passQ &= qip::check_value(&obuff, "MS: E1 restart", max_dev, 0.0, 1.0e-9);
+  }
+
   // Since we have trouble with TDHF and HFS, do it again more thoroughly here.
   // Note: This makes it seem the problem is in solve_core, NOT in solve dPsi
   // This should be easier to fix!
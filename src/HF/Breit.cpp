@@ -1,9 +1,13 @@
 #include "HF/Breit.hpp"
 #include "Angular/Wigner369j.hpp"
 #include "Coulomb/CoulombIntegrals.hpp"
+#include "IO/SafeProfiler.hpp"
 #include "Maths/Grid.hpp"
 #include <iostream>
 #include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
 
 namespace HF {
 
@@ -24,7 +28,12 @@ void Breit::BkbaFb(DiracSpinor *BFb, const DiracSpinor &Fa,
   if (m_scale == 0.0)
     return;
 
-  const hidden::Breit_Bk_ba Bkba(Fb, Fa); // every k
+  // Use stored b^k (if {b,a} in table), otherwise calculate (every k)
+  std::optional<hidden::Breit_Bk_ba> tBkba{};
+  const auto *pBkba = m_table.get(Fb, Fa);
+  if (pBkba == nullptr)
+    pBkba = &tBkba.emplace(Fb, Fa);
+  const auto &Bkba = *pBkba;
   const auto ka = Fa.k;
   const auto kb = Fb.k;
 
@@ -71,43 +80,36 @@ DiracSpinor Breit::dVbrX_Fa(int kappa, int K, const DiracSpinor &Fa,
   // const hidden::Breit_Bk_ba Bkba(Fa, Fb);     // every k
   // const hidden::Breit_Bk_ba BkYBa(Fa, Ybeta); // every k
   // Only create these if at least one angular factor is non-zero
-  std::unique_ptr<hidden::Breit_Bk_ba> Bkba{nullptr};
+  // {a,b} may already be stored (if both are core states)
+  const hidden::Breit_Bk_ba *Bkba = m_table.get(Fa, Fb);
+  std::unique_ptr<hidden::Breit_Bk_ba> tBkba{nullptr};
   std::unique_ptr<hidden::Breit_Bk_ba> BkYBa{nullptr};
 
   const auto kn = dVFa.k;
   const auto ka = Fa.k;
   const auto kb = Fb.k;
   const auto kB = Xbeta.k;
-  const auto tjn = dVFa.twoj();
   const auto tja = Fa.twoj();
   const auto tjb = Fb.twoj();
   const auto tjB = Xbeta.twoj();
 
-  // (-1)^{jB-ja}
-  const auto s_Bb = Angular::neg1pow_2(tjB - tja);
+  // Angular factors (cached, for this K only): N parts are given by kb -> -kb
+  const auto &angX = m_angX.get_l(K, kn, ka, kb, kB);
+  const auto &angY = m_angY.get_l(K, kn, ka, kb, kB);
+  const auto &angX_N = m_angX.get_l(K, kn, ka, -kb, kB);
+  const auto &angY_N = m_angY.get_l(K, kn, ka, -kb, kB);
 
   const auto kmax = std::max({tja, tjb, tjB}) + K; // ?
   for (auto k = 0; k <= kmax; ++k) {
 
-    const auto s_Kk = Angular::neg1pow(K + k);
-
-    const auto Ckab = Angular::Ck_kk(k, ka, kb);
-    const auto Ckab_N = Angular::Ck_kk(k, ka, -kb);
-    const auto CknB = Angular::Ck_kk(k, kn, kB);
-    const auto sjX = Angular::sixj_2(tja, tjn, 2 * K, tjB, tjb, 2 * k);
-
-    const auto CkaB = Angular::Ck_kk(k, ka, kB);
-    const auto Cknb = Angular::Ck_kk(k, kn, kb);
-    const auto Cknb_N = Angular::Ck_kk(k, kn, -kb);
-    const auto sjY = Angular::sixj_2(tja, tjn, 2 * K, tjb, tjB, 2 * k);
-
-    const auto cangX = s_Bb * s_Kk * Ckab * CknB * sjX;
-    const auto cangY = s_Bb * s_Kk * CkaB * Cknb * sjY;
-    const auto cangX_N = s_Bb * s_Kk * Ckab_N * CknB * sjX;
-    const auto cangY_N = s_Bb * s_Kk * CkaB * Cknb_N * sjY;
+    const auto cangX = angX(k, K);
+    const auto cangY = angY(k, K);
+    const auto cangX_N = angX_N(k, K);
+    const auto cangY_N = angY_N(k, K);
 
     if (!Bkba && (cangX != 0.0 || cangX_N != 0.0)) {
-      Bkba = std::make_unique<hidden::Breit_Bk_ba>(Fa, Fb); // every k
+      tBkba = std::make_unique<hidden::Breit_Bk_ba>(Fa, Fb); // every k
+      Bkba = tBkba.get();
     }
 
     if (!BkYBa && (cangY != 0.0 || cangY_N != 0.0)) {
@@ -133,6 +135,42 @@ DiracSpinor Breit::dVbrX_Fa(int kappa, int K, const DiracSpinor &Fa,
   return dVFa;
 }
 
+//******************************************************************************
+double Breit::cangX(int k, int K, int kn, int ka, int kb, int kB) {
+  // (-1)^{jB-ja+K+k} C^k_ab C^k_nB {ja, jn, K \ jB, jb, k}
+  const auto tja = Angular::twoj_k(ka);
+  const auto tjb = Angular::twoj_k(kb);
+  const auto tjB = Angular::twoj_k(kB);
+  const auto tjn = Angular::twoj_k(kn);
+  const auto s_Bb = Angular::neg1pow_2(tjB - tja);
+  const auto s_Kk = Angular::neg1pow(K + k);
+  const auto Ckab = Angular::Ck_kk(k, ka, kb);
+  const auto CknB = Angular::Ck_kk(k, kn, kB);
+  const auto sjX = Angular::sixj_2(tja, tjn, 2 * K, tjB, tjb, 2 * k);
+  return s_Bb * s_Kk * Ckab * CknB * sjX;
+}
+
+double Breit::cangY(int k, int K, int kn, int ka, int kb, int kB) {
+  // (-1)^{jB-ja+K+k} C^k_aB C^k_nb {ja, jn, K \ jb, jB, k}
+  const auto tja = Angular::twoj_k(ka);
+  const auto tjb = Angular::twoj_k(kb);
+  const auto tjB = Angular::twoj_k(kB);
+  const auto tjn = Angular::twoj_k(kn);
+  const auto s_Bb = Angular::neg1pow_2(tjB - tja);
+  const auto s_Kk = Angular::neg1pow(K + k);
+  const auto CkaB = Angular::Ck_kk(k, ka, kB);
+  const auto Cknb = Angular::Ck_kk(k, kn, kb);
+  const auto sjY = Angular::sixj_2(tja, tjn, 2 * K, tjb, tjB, 2 * k);
+  return s_Bb * s_Kk * CkaB * Cknb * sjY;
+}
+
+//******************************************************************************
+void Breit::update_table() {
+  if (m_scale == 0.0)
+    return;
+  m_table.update(*p_core);
+}
+
 //******************************************************************************
 DiracSpinor Breit::dVbrD_Fa(int kappa, int K, const DiracSpinor &Fa,
                             const DiracSpinor &Fb, const DiracSpinor &Xbeta,
@@ -295,6 +333,141 @@ double Breit::Pk(int k) const {
   return double(k * (k + 1)) / double(2 * (2 * k + 1));
 }
 
+//******************************************************************************
+//******************************************************************************
+namespace {
+// Checks if two orbitals are identical (not just same {n,kappa})
+bool identical(const DiracSpinor &Fa, const DiracSpinor &Fb) {
+  return Fa.n == Fb.n && Fa.k == Fb.k && Fa.min_pt() == Fb.min_pt() &&
+         Fa.max_pt() == Fb.max_pt() && Fa.f() == Fb.f() && Fa.g() == Fb.g();
+}
+
+// Frees the b^k/g^k functions that are not allowed by selection rules (these
+// are all zero, and are never used, see MOPk_ij_Fc and Nk_ij_Fc)
+void release_unused(hidden::Breit_Bk_ba *Bk, const DiracSpinor &Fb,
+                    const DiracSpinor &Fa) {
+  for (auto k = 0ul; k <= Bk->max_k; ++k) {
+    const auto ik = int(k);
+    const auto bk_used = Angular::Ck_kk_SR(ik - 1, Fb.k, Fa.k) ||
+                         Angular::Ck_kk_SR(ik + 1, Fb.k, Fa.k);
+    const auto gk_used = bk_used || Angular::Ck_kk_SR(ik, -Fb.k, Fa.k);
+    if (!bk_used) {
+      std::vector<double>().swap(Bk->bk_0[k]);
+      std::vector<double>().swap(Bk->bk_inf[k]);
+    }
+    if (!gk_used) {
+      std::vector<double>().swap(Bk->gk_0[k]);
+      std::vector<double>().swap(Bk->gk_inf[k]);
+    }
+  }
+}
+} // namespace
+
+//******************************************************************************
+BreitTable::BreitTable() = default;
+BreitTable::BreitTable(const std::vector<DiracSpinor> &orbs) { update(orbs); }
+BreitTable::BreitTable(BreitTable &&) = default;
+BreitTable &BreitTable::operator=(BreitTable &&) = default;
+BreitTable::~BreitTable() = default;
+
+//******************************************************************************
+std::size_t BreitTable::update(const std::vector<DiracSpinor> &orbs) {
+  [[maybe_unused]] auto sp = IO::Profile::safeProfiler(__func__);
+  const auto num_orbs = orbs.size();
+
+  // Find which orbitals are new/changed: if set of orbitals is different
+  // (different number), re-calculate all
+  std::vector<bool> changed(num_orbs, true);
+  if (m_orbs.size() == num_orbs) {
+    for (auto i = 0ul; i < num_orbs; ++i) {
+      changed[i] = !identical(orbs[i], m_orbs[i]);
+    }
+  } else {
+    m_Bk.clear();
+    m_Bk.resize(num_orbs * num_orbs);
+  }
+
+  // List of {b,a} pairs to (re)calculate:
+  std::vector<std::pair<std::size_t, std::size_t>> ba_list;
+  for (auto ib = 0ul; ib < num_orbs; ++ib) {
+    for (auto ia = 0ul; ia < num_orbs; ++ia) {
+      if (changed[ib] || changed[ia])
+        ba_list.emplace_back(ib, ia);
+    }
+  }
+
+#pragma omp parallel for schedule(dynamic)
+  for (auto i = 0ul; i < ba_list.size(); ++i) {
+    const auto [ib, ia] = ba_list[i];
+    auto Bk = std::make_unique<hidden::Breit_Bk_ba>(orbs[ib], orbs[ia]);
+    release_unused(Bk.get(), orbs[ib], orbs[ia]);
+    m_Bk[ib * num_orbs + ia] = std::move(Bk);
+  }
+
+  m_orbs = orbs;
+  m_position.clear();
+  m_address.clear();
+  m_stamp.clear();
+  for (auto i = 0ul; i < num_orbs; ++i) {
+    m_address.push_back(&orbs[i]);
+    m_stamp.push_back(stamp(orbs[i]));
+    const auto nk = std::size_t(orbs[i].nk_index());
+    if (nk >= m_position.size())
+      m_position.resize(nk + 1, -1);
+    m_position[nk] = int(i);
+  }
+
+  return ba_list.size();
+}
+
+//******************************************************************************
+int BreitTable::position(const DiracSpinor &Fa) const {
+  const auto nk = std::size_t(Fa.nk_index());
+  if (nk >= m_position.size())
+    return -1;
+  // nb: orbitals were checked to be identical in update(); here, only check
+  // it is the same one (by address), and not changed since (by stamp), so
+  // lookup is O(1)
+  const auto i = m_position[nk];
+  if (i < 0 || &Fa != m_address[std::size_t(i)] ||
+      !(stamp(Fa) == m_stamp[std::size_t(i)]))
+    return -1;
+  return i;
+}
+
+BreitTable::Stamp BreitTable::stamp(const DiracSpinor &Fa) {
+  // f, g sampled at (roughly) the middle of the orbital
+  const auto i = (Fa.min_pt() + Fa.max_pt()) / 2;
+  return {Fa.en(), Fa.f(i), Fa.g(i), Fa.min_pt(), Fa.max_pt()};
+}
+
+//******************************************************************************
+const hidden::Breit_Bk_ba *BreitTable::get(const DiracSpinor &Fb,
+                                           const DiracSpinor &Fa) const {
+  const auto ib = position(Fb);
+  if (ib < 0)
+    return nullptr;
+  const auto ia = position(Fa);
+  if (ia < 0)
+    return nullptr;
+  return m_Bk[std::size_t(ib) * m_orbs.size() + std::size_t(ia)].get();
+}
+
+//******************************************************************************
+std::size_t BreitTable::bytes() const {
+  auto total = 0ul;
+  for (const auto &Bk : m_Bk) {
+    if (!Bk)
+      continue;
+    for (auto k = 0ul; k <= Bk->max_k; ++k) {
+      total += (Bk->bk_0[k].capacity() + Bk->bk_inf[k].capacity() +
+                Bk->gk_0[k].capacity() + Bk->gk_inf[k].capacity()) *
+               sizeof(double);
+    }
+  }
+  return total;
+}
+
 //******************************************************************************
 namespace hidden {
 
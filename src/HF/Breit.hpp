@@ -1,5 +1,7 @@
 #pragma once
+#include "Angular/RecouplingCache.hpp"
 #include "Wavefunction/DiracSpinor.hpp"
+#include <memory>
 #include <utility>
 #include <vector>
 
@@ -9,13 +11,87 @@ namespace hidden {
 struct Breit_Bk_ba; // forward decl
 }
 
+//******************************************************************************
+//! Calculates + stores Breit b^k and g^k radial functions [hidden::Breit_Bk_ba]
+//! for every (ordered) pair of orbitals {b,a} in given set (e.g., the core)
+/*! @details
+Analogous to Coulomb::YkTable, but for the Breit integrals. update() may be
+called again if the orbitals change: only pairs that involve an orbital that
+has changed (or is new) are re-calculated.
+
+get() returns nullptr if either orbital is not in the table. Orbitals are
+checked to be identical to the stored ones only once, in update(). Lookups are
+then by {n,kappa} and by address: only the orbitals that were passed to
+update() (not copies) are found, so it is safe to call with orbitals that have
+same {n,kappa} but are not the same (e.g., valence states, or perturbed
+orbitals) - nullptr is returned. Each lookup also checks a cheap 'stamp' of the
+orbital (energy, range, and a sample of f and g): if an orbital was modified in
+place after update() (e.g., by HF iterations), nullptr is returned (rather than
+stale b^k), until update() is called again.
+
+Memory: Only the b^k,g^k functions that are allowed by angular selection rules
+are kept.
+*/
+class BreitTable {
+  // Copy of orbitals (to check for changes); position in this is index
+  std::vector<DiracSpinor> m_orbs{};
+  // Maps nk_index -> position of orbital in table (-1 if not in table)
+  std::vector<int> m_position{};
+  // Address of orbitals table was last updated with (for lookup)
+  std::vector<const DiracSpinor *> m_address{};
+  // Cheap (O(1)) summary of each orbital, to detect in-place changes
+  struct Stamp {
+    double en, f, g;
+    std::size_t min_pt, max_pt;
+    bool operator==(const Stamp &o) const {
+      return en == o.en && f == o.f && g == o.g && min_pt == o.min_pt &&
+             max_pt == o.max_pt;
+    }
+  };
+  std::vector<Stamp> m_stamp{};
+  // b^k/g^k for {b,a}, at [ib*num_orbs + ia]
+  std::vector<std::unique_ptr<hidden::Breit_Bk_ba>> m_Bk{};
+
+public:
+  BreitTable();
+  explicit BreitTable(const std::vector<DiracSpinor> &orbs);
+  BreitTable(BreitTable &&);
+  BreitTable &operator=(BreitTable &&);
+  ~BreitTable();
+
+  //! Calculates b^k/g^k for all pairs of orbitals. If called again, only
+  //! pairs involving new/changed orbitals are re-calculated. Returns number of
+  //! pairs calculated.
+  std::size_t update(const std::vector<DiracSpinor> &orbs);
+
+  //! Returns b^k/g^k functions for {Fb,Fa} [same as hidden::Breit_Bk_ba(Fb,
+  //! Fa)], or nullptr if not stored
+  const hidden::Breit_Bk_ba *get(const DiracSpinor &Fb,
+                                 const DiracSpinor &Fa) const;
+
+  //! Number of orbitals in table
+  std::size_t size() const { return m_orbs.size(); }
+
+  //! Memory used to store b^k/g^k functions (in bytes)
+  std::size_t bytes() const;
+
+private:
+  // Position in table of orbital, or -1 if not in table (or not the same
+  // orbital the table was updated with, or modified since)
+  int position(const DiracSpinor &Fa) const;
+  static Stamp stamp(const DiracSpinor &Fa);
+};
+
 //******************************************************************************
 //! Breit (Hartree-Fock Breit) interaction potential
 class Breit {
 public:
   //! Contains ptr to core: careful if updating core (e.g., in HF)
   Breit(const std::vector<DiracSpinor> &in_core, double in_scale = 1.0)
-      : p_core(&in_core), m_scale(in_scale) {}
+      : p_core(&in_core),
+        m_scale(in_scale),
+        m_angX(DiracSpinor::max_tj(in_core) + 6, &Breit::cangX),
+        m_angY(DiracSpinor::max_tj(in_core) + 6, &Breit::cangY) {}
   // nb: During HF, must update orbitals each time
 
   //! () operator: returns VbrFa(Fa)
@@ -35,9 +111,22 @@ public:
                        const DiracSpinor &Fb, const DiracSpinor &Xbeta,
                        const DiracSpinor &Ybeta) const;
 
+  //! Calculates (or updates, if core has changed) the b^k/g^k functions for all
+  //! pairs of core orbitals [see BreitTable]. These are then used instead of
+  //! being re-calculated on every call (e.g., by TDHF). Not thread-safe. Must be
+  //! called again if core orbitals are modified.
+  void update_table();
+
+  //! Stored b^k/g^k for core pairs (empty unless update_table() called)
+  const BreitTable &table() const { return m_table; }
+
 private:
   const std::vector<DiracSpinor> *const p_core;
   const double m_scale;
+  BreitTable m_table{};
+  // Angular factors for dVbrX_Fa: {k,K}, {kn,ka,kb,kB}. Filled as required,
+  // only for the K used (see RecouplingCache::get_l)
+  Angular::RecouplingCache m_angX, m_angY;
 
   // Calculates \sum_k B^k_ba F_b (single core contr. to V_brFa)
   void BkbaFb(DiracSpinor *BFb, const DiracSpinor &Fa,
@@ -56,6 +145,9 @@ private:
   double Nkba(int k, int kb, int ka) const;
   std::pair<double, double> Ok(int k) const;
   double Pk(int k) const;
+  // Exchange RPA angular factors (for dVbrX_Fa); N parts are given by -kb
+  static double cangX(int k, int K, int kn, int ka, int kb, int kB);
+  static double cangY(int k, int K, int kn, int ka, int kb, int kB);
 
 public:
   Breit &operator=(const Breit &) = delete;
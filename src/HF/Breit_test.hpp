@@ -1,6 +1,8 @@
 #pragma once
 #include "DiracOperator/DiracOperator.hpp"
 #include "ExternalField/TDHF.hpp"
+#include "HF/Breit.hpp"
+#include "HF/HartreeFock.hpp"
 #include "Wavefunction/Wavefunction.hpp"
 #include "qip/Check.hpp"
 #include "qip/Maths.hpp"
@@ -203,6 +205,44 @@ bool Breit(std::ostream &obuff) {
         qip::check_value(&obuff, "PNC(RPA) " + at2->first, eps2, 0.0, 2.0e-4);
   }
 
+  //****************************************************************************
+  { // Stored b^k (BreitTable) for core pairs: same as calculating from scratch
+    const auto VBr = wf.getHF()->get_Breit();
+    const HF::Breit VBr_noTable(wf.core, x_Breit);
+    double max_del = 0.0;
+    for (const auto &Fc : wf.core) {
+      const auto dF = (*VBr)(Fc) - VBr_noTable(Fc);
+      max_del = std::max(max_del, std::abs(dF * dF));
+    }
+    pass &= qip::check_value(&obuff, "BreitTable VbrFa", max_del, 0.0, 0.0);
+    pass &= qip::check(&obuff, "BreitTable size", VBr->table().size(),
+                       wf.core.size());
+    // core unchanged, so update should re-calculate nothing
+    auto table = HF::BreitTable(wf.core);
+    pass &= qip::check(&obuff, "BreitTable update", table.update(wf.core), 0ul);
+    // Only the orbitals table was updated with are found, not other orbitals
+    // with same {n,kappa} (e.g., a modified copy)
+    const auto &F0 = wf.core.front();
+    const auto F0_copy = 1.01 * F0;
+    pass &= qip::check(&obuff, "BreitTable get", table.get(F0, F0) != nullptr,
+                       true);
+    pass &= qip::check(&obuff, "BreitTable get (copy)",
+                       table.get(F0_copy, F0) == nullptr &&
+                           table.get(F0, F0_copy) == nullptr,
+                       true);
+    // Orbital modified in place after table built: must not return stale b^k
+    auto core = wf.core;
+    auto table2 = HF::BreitTable(core);
+    const auto found_before = table2.get(core[0], core[1]) != nullptr;
+    core[0] *= 1.01;
+    const auto found_after = table2.get(core[0], core[1]) != nullptr ||
+                             table2.get(core[1], core[0]) != nullptr;
+    table2.update(core);
+    const auto found_updated = table2.get(core[0], core[1]) != nullptr;
+    pass &= qip::check(&obuff, "BreitTable get (modified)",
+                       found_before && !found_after && found_updated, true);
+  }
+
   return pass;
 }
 } // namespace UnitTest
@@ -112,8 +112,12 @@ const std::vector<double> &HartreeFock::solve_core() {
   // Frozen core Breit:
   // Once core HF done, core "Frozen", Breit operator created
   // (Temporary VBr used in HF routine)
-  if (m_include_Breit)
-    m_VBr = std::make_unique<HF::Breit>(*p_core, m_x_Breit);
+  if (m_include_Breit) {
+    auto VBr = std::make_unique<HF::Breit>(*p_core, m_x_Breit);
+    // Core is now fixed: store b^k for core pairs (re-used, e.g., in TDHF)
+    VBr->update_table();
+    m_VBr = std::move(VBr);
+  }
 
   return m_vdir;
 }
@@ -352,15 +356,25 @@ void HartreeFock::solveValence(std::vector<DiracSpinor> *valence,
   auto do_refine = (m_method == Method::HartreeFock && !p_core->empty());
 
   std::vector<EpsIts> eis(Nval);
+  // If refined, approx (local vex) solution only needs to be a starting guess
+  const auto eps_approx = do_refine ? std::max(m_eps_HF, 1.0e-6) : m_eps_HF;
 
 #pragma omp parallel for
   for (std::size_t i = 0; i < Nval; i++) {
     auto &Fa = (*valence)[i];
-    eis[i] = hf_valence_approx(Fa, m_eps_HF);
+    eis[i] = hf_valence_approx(Fa, eps_approx);
     if (do_refine)
       eis[i] = hf_valence_refine(Fa);
   }
 
+  // eps=1 from refine: solution has wrong nodes (different state)
+  for (std::size_t i = 0; i < Nval; i++) {
+    if (eis[i].eps >= 1.0) {
+      std::cout << "\n⚠️  WARNING: HF failed for valence state "
+                << (*valence)[i].symbol() << " (converged to wrong state)\n";
+    }
+  }
+
   double eps_worst = 0.0, eps_best = 10.0;
   std::size_t i_worst = 0, i_best = 0;
   for (std::size_t i = 0; i < Nval; i++) {
@@ -406,6 +420,10 @@ void HartreeFock::solveBrueckner(std::vector<DiracSpinor> *valence,
       }
       std::cout << "\n";
     }
+    if (eis.eps >= 1.0) {
+      std::cout << "\n⚠️  WARNING: Brueckner orbital failed for " << Fv.symbol()
+                << " (converged to wrong state)\n";
+    }
   }
 }
 
@@ -487,8 +505,8 @@ double HartreeFock::calculateCoreEnergy() const
     for (const auto &Fb : *p_core) {
       const auto tjb = Fb.twoj();
       const double xtjbp1 = (tjb + 1) * Fb.occ_frac();
-      const auto &v0bb = *m_Yab.get(0, Fb, Fb); // XXX may be null
-      const auto R0fg2 = Fa * (v0bb * Fa);
+      const auto v0bb = m_Yab.get(0, Fb, Fb); // XXX may be null
+      const auto R0fg2 = Coulomb::Rk_abcd(Fa, Fa, v0bb);
       e2 += xtjap1 * xtjbp1 * R0fg2;
       // take advantage of symmetry for third term:
       if (Fb > Fa)
@@ -505,7 +523,7 @@ double HartreeFock::calculateCoreEnergy() const
         const auto vabk = m_Yab.get(k, Fa, Fb);
         if (vabk == nullptr)
           continue;
-        const auto R0fg3 = Fa * (*vabk * Fb); // XXX may be null
+        const auto R0fg3 = Coulomb::Rk_abcd(Fa, Fb, vabk);
         e3 += y * xtjap1 * xtjbp1 * Labk * (R0fg3);
       }
     }
@@ -540,7 +558,7 @@ void HartreeFock::form_vdir(std::vector<double> &vdir, bool re_scale) const
   const double sf = re_scale ? (1.0 - 1.0 / Ncore) : 1.0;
   for (const auto &Fb : (*p_core)) {
     const double f_sf = sf * (Fb.twoj() + 1) * Fb.occ_frac();
-    const auto &v0bb = *m_Yab.get(0, Fb, Fb); // xxx may be null
+    const auto v0bb = m_Yab.get(0, Fb, Fb); // xxx may be null
     for (std::size_t i = 0; i < rgrid->num_points(); i++) {
       vdir[i] += v0bb[i] * f_sf;
     }
@@ -548,9 +566,10 @@ void HartreeFock::form_vdir(std::vector<double> &vdir, bool re_scale) const
 }
 
 //******************************************************************************
-const std::vector<double> &
+std::vector<double>
 HartreeFock::get_vdir_single(const DiracSpinor &Fa) const {
-  return *m_Yab.get(0, Fa, Fa);
+  const auto v0aa = m_Yab.get(0, Fa, Fa);
+  return {v0aa, v0aa + rgrid->num_points()};
 }
 //----------
 std::vector<double> HartreeFock::calc_vdir_single(const DiracSpinor &Fa) {
@@ -651,7 +670,7 @@ void HartreeFock::form_approx_vex_core_a(const DiracSpinor &Fa,
         if (vabk == nullptr)
           continue;
         for (std::size_t i = 0; i < irmax; i++) {
-          vex_a[i] += Labk * (*vabk)[i] * v_Fab[i];
+          vex_a[i] += Labk * vabk[i] * v_Fab[i];
         } // r
       }   // k
     }     // b
@@ -674,7 +693,7 @@ void HartreeFock::form_approx_vex_core_a(const DiracSpinor &Fa,
       for (std::size_t i = 0; i < irmax; i++) {
         // nb: If I don't 'cut' here, or fails w/ f states... ?? XX
         // Of course, cutting is fine. But WHY FAIL??
-        vex_a[i] += -Labk * (*vaak)[i] * x_tjap1;
+        vex_a[i] += -Labk * vaak[i] * x_tjap1;
       }
     } // k
   }   // if a in core
@@ -784,7 +803,7 @@ void HartreeFock::vex_psia_core(const DiracSpinor &Fa, DiracSpinor &VxFa) const
       if (vabk == nullptr)
         continue;
       for (auto i = 0u; i < Fb.max_pt(); i++) {
-        const auto v = -x_tjbp1 * Labk * (*vabk)[i];
+        const auto v = -x_tjbp1 * Labk * vabk[i];
         VxFa.set_f(i) += v * Fb.f(i);
         VxFa.set_g(i) += v * Fb.g(i);
       } // r
@@ -858,8 +877,7 @@ void HartreeFock::hf_orbital(DiracSpinor &Fa, double en,
 {
   [[maybe_unused]] auto sp = IO::Profile::safeProfiler(__func__);
   // pull these outside? But make sure thread safe!
-  DiracSpinor Gzero(Fa.n, Fa.k, Fa.rgrid);
-  DiracSpinor Ginf(Fa.n, Fa.k, Fa.rgrid);
+  DiracODE::InhomogSolver solver(Fa.rgrid, m_alpha);
   DiracSpinor VxFh(Fa.n, Fa.k, Fa.rgrid);
   DiracSpinor dFa(Fa.n, Fa.k, Fa.rgrid);
   const auto eps_target = 1.0e-17; // m_eps_HF;
@@ -868,11 +886,12 @@ void HartreeFock::hf_orbital(DiracSpinor &Fa, double en,
   // Note: vx_phi includes VBr*Fa [if Breit].
   // VBr used in the 'small energy correction' portion
 
-  const auto alpha = m_alpha;
-  DiracODE::solve_inhomog(Fa, Gzero, Ginf, en, vl, H_mag, alpha, -1.0 * vx_phi);
+  // Homogeneous solutions (at initial en) are solved once, and re-used below
+  solver.update(Fa.k, en, vl, H_mag);
+  solver.solve(Fa, -1.0 * vx_phi);
 
   // make small adjustments to energy to normalise Fa:
-  DiracODE::Adams::GreenSolution(dFa, Ginf, Gzero, alpha, Fa);
+  solver.solve(dFa, Fa);
   // should dFa = dEa * dFa, but makes it worse?
   // nb: after first it, becomes correct.
   auto dEa = 0.5 * (Fa * Fa - 1.0) / (Fa * dFa);
@@ -885,7 +904,7 @@ void HartreeFock::hf_orbital(DiracSpinor &Fa, double en,
     VxFh = v0 * dFa + vexFa(dFa, static_core, k_max);
     if (VBr)
       VxFh += (*VBr)(dFa);
-    DiracODE::Adams::GreenSolution(dFa, Ginf, Gzero, alpha, dEa * Fa - VxFh);
+    solver.solve(dFa, dEa * Fa - VxFh);
 
     const auto delta_Norm = Fa * Fa - 1.0;
     const auto de0 = dEa;
@@ -901,62 +920,6 @@ void HartreeFock::hf_orbital(DiracSpinor &Fa, double en,
   if (tries == 0 || tries == m_max_hf_its)
     Fa.normalise(); //? Not needed
 }
-//******************************************************************************
-void HartreeFock::brueckner_orbital(DiracSpinor &Fa, double en,
-                                    const std::vector<double> &vl,
-                                    const std::vector<double> &H_mag,
-                                    const DiracSpinor &VxF,
-                                    const MBPT::CorrelationPotential &Sigma,
-                                    const std::vector<DiracSpinor> &static_core,
-                                    const HF::Breit *const VBr) const
-// ..................
-{
-  [[maybe_unused]] auto sp = IO::Profile::safeProfiler(__func__);
-  // pull these outside? But make sure thread safe!
-  DiracSpinor Gzero(Fa.n, Fa.k, Fa.rgrid);
-  DiracSpinor Ginf(Fa.n, Fa.k, Fa.rgrid);
-  DiracSpinor dFa(Fa.n, Fa.k, Fa.rgrid);
-  const auto eps_target = 1.0e-16; // m_eps_HF;
-
-  const auto SigmaF = Sigma(Fa);
-
-  // nb: VxF includes Breit. VBr used for energy correction
-
-  const auto alpha = m_alpha;
-  DiracODE::solve_inhomog(Fa, Gzero, Ginf, en, vl, H_mag, alpha,
-                          -1.0 * VxF - SigmaF);
-
-  // make small adjustments to energy to normalise Fa:
-  DiracODE::Adams::GreenSolution(dFa, Ginf, Gzero, alpha, Fa);
-  // should dFa = dEa * dFa, but makes it worse?
-  // nb: after first it, becomes correct.
-  auto dEa = 0.5 * (Fa * Fa - 1.0) / (Fa * dFa);
-  auto eps = std::abs(dEa / en);
-  int tries = 0;
-  for (; tries <= m_max_hf_its; ++tries) {
-    if (eps < eps_target)
-      break;
-    {
-      auto VxF_tilde = vexFa(dFa, static_core);
-      if (VBr)
-        VxF_tilde += (*VBr)(dFa);
-      const auto SigmaF_tilde = Sigma(dFa);
-      DiracODE::Adams::GreenSolution(dFa, Ginf, Gzero, alpha,
-                                     dEa * Fa - VxF_tilde - SigmaF_tilde);
-    }
-    const auto de0 = dEa;
-    dEa *= 0.5 * (Fa * Fa - 1.0) / (Fa * dFa);
-    eps = std::abs(dEa / en);
-    en += dEa;
-    dFa.set_max_pt() = Fa.max_pt();
-    Fa -= (dEa / de0) * dFa;
-  }
-  Fa.set_en() = en;
-  Fa.set_eps() = eps;
-  Fa.set_its() = tries;
-  Fa.normalise();
-}
-
 //******************************************************************************
 // const std::vector<double> tmp_empty_vector{};
 std::vector<double> HartreeFock::get_Hrad_el(int l) const {
@@ -977,65 +940,26 @@ EpsIts HartreeFock::hf_valence_refine(DiracSpinor &Fa) {
   if (p_core->empty())
     return {0, 0};
 
-  const auto eps_target = m_eps_HF;
-
-  const auto damper = rampedDamp(0.8, 0.3, 5, 25);
-  double extra_damp = 0.0;
-
   const auto &vrad_el = get_Hrad_el(Fa.l());
   const auto &Hmag = get_Hrad_mag(Fa.l());
   const auto vl = qip::add(*p_vnuc, m_vdir, vrad_el);
 
-  const auto Fzero = Fa;
-  const auto vexFzero = vex_approx(Fa, *p_core) * Fa;
-
-  auto prev_en = Fa.en();
-  double best_eps = 1.0;
-  auto VxFa = DiracSpinor(Fa.n, Fa.k, rgrid);
-  int it = 0;
-  double eps = 1.0;
-  int worse_count = 0;
-  for (; it <= m_max_hf_its; ++it) {
-    const auto a_damp = damper(it) + extra_damp;
-
-    VxFa = calc_vexFa(Fa);
-    if (m_VBr) { // Breit
-      VxFa += (*m_VBr)(Fa);
-    }
-    const auto oldphi = Fa;
-    const auto en = Fzero.en() + (Fzero * VxFa - Fa * vexFzero) / (Fa * Fzero);
-    hf_orbital(Fa, en, vl, Hmag, VxFa, (*p_core));
-    eps = std::abs((prev_en - Fa.en()) / Fa.en());
-    prev_en = Fa.en();
-
-    if (it > 20 && eps > 1.5 * best_eps) {
-      ++worse_count;
-      extra_damp = extra_damp > 0 ? 0 : 0.1;
-    } else {
-      worse_count = 0;
-    }
-    const bool converged = (eps <= eps_target && it > 0);
-    if (converged || worse_count > 2)
-      break;
-
-    if (eps < best_eps)
-      best_eps = eps;
-
-    if constexpr (print_each_eps) {
-      std::cout << __LINE__ << "| " << it << " " << eps << " " << Fa.en() << " "
-                << en - Fzero.en() << " " << Fa * Fa << "\n";
-    }
-
-    Fa = (1.0 - a_damp) * Fa + a_damp * oldphi;
-    Fa.normalise();
-
-  } // End HF its
+  // With frozen core, Vex (and Breit) are linear in Fa: solve the non-local
+  // equation directly. Fa (from hf_valence_approx) is the starting guess
+  const auto Vx = [this](const DiracSpinor &F) {
+    auto VxF = calc_vexFa(F);
+    if (m_VBr) // Breit
+      VxF += (*m_VBr)(F);
+    return VxF;
+  };
+  DiracODE::boundState_nonlocal(Fa, Fa.en(), vl, Hmag, m_alpha, Vx, m_eps_HF,
+                                m_max_hf_its);
 
   if constexpr (print_final_eps) {
-    printf("refine: %2i %2i | %3i eps=%6.1e  en=%11.8f\n", Fa.n, Fa.k, it, eps,
-           Fa.en());
+    printf("refine: %2i %2i | %3i eps=%6.1e  en=%11.8f\n", Fa.n, Fa.k,
+           Fa.its(), Fa.eps(), Fa.en());
   }
-  return {eps, it};
+  return {Fa.eps(), Fa.its()};
 }
 
 //******************************************************************************
@@ -1045,72 +969,27 @@ EpsIts HartreeFock::hf_Brueckner(DiracSpinor &Fa,
   if (p_core->empty())
     return {0, 0};
 
-  const auto eps_target = m_eps_HF;
-  const auto max_br_its = m_max_hf_its;
-
-  // auto damper = rampedDamp(0.33, 0.05, 1, 15);
-  auto damper = rampedDamp(0.6, 0.3, 1, 15);
-
   const auto &vrad_el = get_Hrad_el(Fa.l());
   const auto &Hmag = get_Hrad_mag(Fa.l());
   const auto vl = qip::add(*p_vnuc, m_vdir, vrad_el);
 
-  const auto Fzero = Fa;
-  auto vexFzero = calc_vexFa(Fa);
-  if (m_VBr) { // Breit
-    vexFzero += (*m_VBr)(Fa);
-  }
-
-  auto prev_en = Fa.en();
-  double best_eps = 1.0;
-  int it = 0;
-  double eps = 1.0;
-  int worse_count = 0;
-  for (; it <= max_br_its; ++it) {
-    const auto a_damp = damper(it);
-
-    auto VxFa = calc_vexFa(Fa);
-    if (m_VBr) { // Breit
-      VxFa += (*m_VBr)(Fa);
-    }
-    const auto SigmaFa = Sigma(Fa);
-    const auto oldphi = Fa;
-
-    const auto en_new =
-        Fzero.en() + (Fzero * (VxFa + SigmaFa) - Fa * vexFzero) / (Fa * Fzero);
-    const auto en = (Fa.en() + 1.0 * en_new) / 2.0;
-
-    brueckner_orbital(Fa, en, vl, Hmag, VxFa, Sigma, (*p_core), m_VBr.get());
-
-    eps = std::abs((prev_en - Fa.en()) / Fa.en());
-    prev_en = Fa.en();
-
-    if (it > 20 && eps > 2.0 * best_eps) {
-      ++worse_count;
-    } else {
-      worse_count = 0;
-    }
-    const bool converged = (eps <= eps_target && it > 0);
-    if (converged || worse_count > 3)
-      break;
-
-    if (eps < best_eps)
-      best_eps = eps;
-
-    if constexpr (print_each_eps) {
-      std::cout << __LINE__ << "| " << it << " " << eps << " " << Fa.en() << " "
-                << en - Fzero.en() << " " << Fa * Fa << "\n";
-    }
-
-    Fa = (1.0 - a_damp) * Fa + a_damp * oldphi;
-    Fa.normalise();
-  } // End HF its
+  // Vex (+ Breit) + Sigma are all linear in Fa: solve the non-local equation
+  // directly. Starting guess is HF orbital, with Sigma to first-order in energy
+  const auto VxSigma = [this, &Sigma](const DiracSpinor &F) {
+    auto VF = calc_vexFa(F) + Sigma(F);
+    if (m_VBr) // Breit
+      VF += (*m_VBr)(F);
+    return VF;
+  };
+  const auto en0 = Fa.en() + Fa * Sigma(Fa);
+  DiracODE::boundState_nonlocal(Fa, en0, vl, Hmag, m_alpha, VxSigma, m_eps_HF,
+                                m_max_hf_its);
 
   if constexpr (print_final_eps) {
-    printf("Br2: %2i %2i | %3i eps=%6.1e  en=%11.8f\n", Fa.n, Fa.k, it, eps,
-           Fa.en());
+    printf("Br2: %2i %2i | %3i eps=%6.1e  en=%11.8f\n", Fa.n, Fa.k, Fa.its(),
+           Fa.eps(), Fa.en());
   }
-  return {eps, it};
+  return {Fa.eps(), Fa.its()};
 }
 
 //******************************************************************************
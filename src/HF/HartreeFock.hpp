@@ -123,7 +123,7 @@ public:
 
   //! @brief Single-electron contribution to Vdir (does not include x*[2j+1]).
   //! Note: Fa MUST be a core state, otherwise UB
-  const std::vector<double> &get_vdir_single(const DiracSpinor &Fa) const;
+  std::vector<double> get_vdir_single(const DiracSpinor &Fa) const;
   //! @brief Calculates single-electron contribution to Vdir (does not include
   //! x*[2j+1]). Fa may be any state - calculated on the fly
   static std::vector<double> calc_vdir_single(const DiracSpinor &Fa);
@@ -196,14 +196,6 @@ private:
                   const std::vector<double> &v0 = {},
                   const HF::Breit *const VBr = nullptr) const;
 
-  void brueckner_orbital(DiracSpinor &Fa, double en,
-                         const std::vector<double> &vl,
-                         const std::vector<double> &H_mag,
-                         const DiracSpinor &VxF,
-                         const MBPT::CorrelationPotential &Sigma,
-                         const std::vector<DiracSpinor> &static_core,
-                         const HF::Breit *const VBr = nullptr) const;
-
   // Calc's Vex*Fa, for Fa in the core
   void vex_psia_core(const DiracSpinor &Fa, DiracSpinor &vexFa) const;
   // Forms direct potential
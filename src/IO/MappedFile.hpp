@@ -0,0 +1,76 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <utility>
+// POSIX:
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace IO {
+
+//******************************************************************************
+/*!
+@brief Read-only memory-mapped file (RAII wrapper around POSIX mmap).
+@details
+The file is mapped as shared + read-only, so that several processes that map
+the same file share the same physical pages (the page cache), and nothing is
+read from disk until it is actually accessed. Move-only; unmaps on destruction.
+*/
+class MappedFile {
+  const std::byte *m_data = nullptr;
+  std::size_t m_size = 0;
+
+public:
+  MappedFile() = default;
+  //! Maps given file. Check is_open() to see if succeeded
+  explicit MappedFile(const std::string &fname) {
+    const auto fd = ::open(fname.c_str(), O_RDONLY);
+    if (fd < 0)
+      return;
+    struct stat st;
+    if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+      const auto size = static_cast<std::size_t>(st.st_size);
+      void *ptr = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+      if (ptr != MAP_FAILED) {
+        m_data = static_cast<const std::byte *>(ptr);
+        m_size = size;
+      }
+    }
+    // nb: mapping remains valid after file is closed
+    ::close(fd);
+  }
+
+  ~MappedFile() { unmap(); }
+
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+  MappedFile(MappedFile &&other) noexcept
+      : m_data(std::exchange(other.m_data, nullptr)),
+        m_size(std::exchange(other.m_size, 0)) {}
+  MappedFile &operator=(MappedFile &&other) noexcept {
+    if (this != &other) {
+      unmap();
+      m_data = std::exchange(other.m_data, nullptr);
+      m_size = std::exchange(other.m_size, 0);
+    }
+    return *this;
+  }
+
+  bool is_open() const { return m_data != nullptr; }
+  //! Pointer to start of mapped memory
+  const std::byte *data() const { return m_data; }
+  //! Size (in bytes) of mapped file
+  std::size_t size() const { return m_size; }
+
+private:
+  void unmap() {
+    if (m_data != nullptr)
+      ::munmap(const_cast<std::byte *>(m_data), m_size);
+    m_data = nullptr;
+    m_size = 0;
+  }
+};
+
+} // namespace IO
@@ -88,7 +88,7 @@ std::size_t CorrelationPotential::getSigmaIndex(int n, int kappa) const {
   // nb: will return  index = m_nk.size() if kappa not found
 }
 
-const GMatrix *CorrelationPotential::getSigma(int n, int kappa) const {
+const PackedGMatrix *CorrelationPotential::getSigma(int n, int kappa) const {
   const auto is = getSigmaIndex(n, kappa);
   return (is < m_Sigma_kappa.size()) ? &m_Sigma_kappa[is] : nullptr;
 }
@@ -221,6 +221,41 @@ DiracSpinor CorrelationPotential::act_G_Fv(const GMatrix &Gmat,
   return SigmaFv;
 }
 
+//------------------------------------------------------------------------------
+DiracSpinor CorrelationPotential::act_G_Fv(const PackedGMatrix &Gmat,
+                                           const DiracSpinor &Fv) const {
+  [[maybe_unused]] auto sp = IO::Profile::safeProfiler(__func__);
+  // As above, but uses symmetry of G (symmetric matrix-vector product)
+  // (S|v>)_i = sum_j G_ij v_j drdu_j du
+
+  const auto &gr = *(Fv.rgrid);
+  auto SigmaFv = DiracSpinor(0, Fv.k, Fv.rgrid);
+  const auto include_G = Gmat.m_include_G;
+
+  // v_j * dr_j, on sub-grid
+  std::vector<double> vf(m_subgrid_points), vg;
+  if (include_G)
+    vg.resize(m_subgrid_points);
+  for (auto j = 0ul; j < m_subgrid_points; ++j) {
+    const auto sj = ri_subToFull(j);
+    const auto dr = gr.drdu()[sj] * gr.du() * double(m_stride);
+    vf[j] = Fv.f(sj) * dr;
+    if (include_G)
+      vg[j] = Fv.g(sj) * dr;
+  }
+
+  std::vector<double> f(m_subgrid_points), g(vg.size());
+  Gmat.mult(vf, vg, &f, &g);
+
+  // Interpolate from sub-grid to full grid
+  SigmaFv.set_f() = Interpolator::interpolate(m_subgrid_r, f, gr.r());
+  if (include_G) {
+    SigmaFv.set_g() = Interpolator::interpolate(m_subgrid_r, g, gr.r());
+  }
+
+  return SigmaFv;
+}
+
 //******************************************************************************
 double CorrelationPotential::act_G_Fv_2(const DiracSpinor &Fa,
                                         const GMatrix &Gmat,
@@ -384,8 +419,13 @@ bool CorrelationPotential::read_write(const std::string &fname,
   }
 
   // Check if include FG/GG written. Note: doesn't matter if mis-match?!
-  auto incl_g = rw == IO::FRW::write ? m_include_G : 0;
+  // (format flag): 0/1: full matrices, without/with G [old files]
+  //                2/3: packed symmetric (ff, gg, fg), without/with G
+  constexpr int packed_flag = 2;
+  auto incl_g = rw == IO::FRW::write ? int(m_include_G) + packed_flag : 0;
   rw_binary(iofs, rw, incl_g);
+  const bool packedQ = incl_g >= packed_flag;
+  const bool file_G = incl_g % packed_flag == 1;
 
   if (rw == IO::FRW::read) {
     m_nk.resize(num_kappas);
@@ -394,18 +434,53 @@ bool CorrelationPotential::read_write(const std::string &fname,
     rw_binary(iofs, rw, n, k, en);
   }
 
-  // Read/Write G matrices
-  for (auto &Gk : m_Sigma_kappa) {
+  // Reads/writes packed G matrix (format 2/3)
+  const auto rw_packed = [&](PackedGMatrix &G) {
+    for (auto &x : G.ff.data())
+      rw_binary(iofs, rw, x);
+    if (G.m_include_G) {
+      for (auto &x : G.gg.data())
+        rw_binary(iofs, rw, x);
+      for (auto i = 0ul; i < G.G_size * G.G_size; ++i)
+        rw_binary(iofs, rw, G.fg.m->data[i]);
+    }
+  };
+  // Reads full G matrix (old format 0/1)
+  const auto read_full = [&](GMatrix &G) {
     for (auto i = 0ul; i < m_subgrid_points; ++i) {
       for (auto j = 0ul; j < m_subgrid_points; ++j) {
-        rw_binary(iofs, rw, Gk.ff[i][j]);
-        if (incl_g) {
-          rw_binary(iofs, rw, Gk.fg[i][j]);
-          rw_binary(iofs, rw, Gk.gf[i][j]);
-          rw_binary(iofs, rw, Gk.gg[i][j]);
+        rw_binary(iofs, rw, G.ff[i][j]);
+        if (G.m_include_G) {
+          rw_binary(iofs, rw, G.fg[i][j]);
+          rw_binary(iofs, rw, G.gf[i][j]);
+          rw_binary(iofs, rw, G.gg[i][j]);
         }
       }
     }
+  };
+
+  // Read/Write G matrices
+  if (rw == IO::FRW::write) {
+    for (auto &Gk : m_Sigma_kappa) {
+      rw_packed(Gk);
+    }
+  } else {
+    for (auto &Gk : m_Sigma_kappa) {
+      // nb: file may or may not include G, regardless of m_include_G
+      PackedGMatrix Gfile(m_subgrid_points, file_G);
+      if (packedQ) {
+        rw_packed(Gfile);
+      } else {
+        GMatrix Gfull(m_subgrid_points, file_G);
+        read_full(Gfull);
+        Gfile = PackedGMatrix(Gfull);
+      }
+      Gk.ff = Gfile.ff;
+      if (m_include_G && file_G) {
+        Gk.gg = Gfile.gg;
+        Gk.fg = Gfile.fg;
+      }
+    }
   }
   std::cout << "done.\n";
   if (rw == IO::FRW::read) {
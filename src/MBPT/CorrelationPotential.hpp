@@ -35,6 +35,8 @@ struct Sigma_params {
   double w_ratio{1.5};
   bool screenCoulomb{false};
   bool holeParticle{false};
+  // Mixed-precision (single + refinement) Green's function inversion
+  bool mixedPrecision{false};
 
   std::vector<double> fk{}; // this for Goldstone too..
 };
@@ -104,7 +106,7 @@ public:
     assert(false && "Cannot call formSigma on copied CorrelationPotential!");
   };
 
-  const GMatrix *getSigma(int n, int kappa) const;
+  const PackedGMatrix *getSigma(int n, int kappa) const;
 
   //! returns Spinor: Sigma|Fv>
   //! @details If Sigma for kappa_v doesn't exist, returns |0>. m_Sigma_kappa
@@ -161,6 +163,8 @@ public:
 
   // Acts Gmatirx (G) matrix onto Fv. Interpolates from sub-grid
   DiracSpinor act_G_Fv(const GMatrix &Gmat, const DiracSpinor &Fv) const;
+  // As above, for packed (symmetric) G matrix (e.g., Sigma)
+  DiracSpinor act_G_Fv(const PackedGMatrix &Gmat, const DiracSpinor &Fv) const;
   double act_G_Fv_2(const DiracSpinor &Fa, const GMatrix &Gmat,
                     const DiracSpinor &Fb) const;
 
@@ -208,7 +212,8 @@ protected:
   std::vector<double> m_subgrid_r{};
 
   // m_Sigma_kappa: holds Sigma matrix for each partial-wave, kappa
-  std::vector<GMatrix> m_Sigma_kappa{};
+  // Sigma is symmetric: stored packed (~half the memory of full GMatrix)
+  std::vector<PackedGMatrix> m_Sigma_kappa{};
   // Lambda (fitting factors) for each kappa
   std::vector<double> m_lambda_kappa{};
   std::vector<AtomData::DiracSEnken> m_nk{};
@@ -1,4 +1,10 @@
 #pragma once
+#include "Angular/Wigner369j.hpp"
+#include "Coulomb/CoulombIntegrals.hpp"
+#include "IO/FRW_fileReadWrite.hpp"
+#include "MBPT/CorrelationPotential.hpp"
+#include "MBPT/FeynmanSigma.hpp"
+#include "MBPT/GreenMatrix.hpp"
 #include "Wavefunction/BSplineBasis.hpp"
 #include "Wavefunction/DiracSpinor.hpp"
 #include "Wavefunction/Wavefunction.hpp"
@@ -6,10 +12,30 @@
 #include "qip/Maths.hpp"
 #include "qip/Vector.hpp"
 #include <algorithm>
+#include <cstdio>
+#include <fstream>
 #include <string>
 
 namespace UnitTest {
 
+namespace helper {
+
+// Re-writes a Sigma file written in packed format (ff, [gg, fg]) in the old
+// format (full matrices: ff, [fg, gf, gg]), as written by older versions. ff
+// is scaled by x; if G included, G parts are filled with junk
+inline void write_old_Sigma(const std::string &packed_fname,
+                            const std::string &old_fname, bool include_G,
+                            double x);
+
+// Second-order energy shift, <v|Sigma|v>, calculated from scratch (each Q^k,
+// P^k directly from the orbitals, no tables/caches). holes, excited: as in
+// CorrelationPotential
+inline double SOEnergyShift_direct(const DiracSpinor &v,
+                                   const std::vector<DiracSpinor> &holes,
+                                   const std::vector<DiracSpinor> &excited);
+
+} // namespace helper
+
 //******************************************************************************
 //! Unit tests for second-order MBPT energy correction
 bool MBPT2(std::ostream &obuff) {
@@ -61,6 +87,33 @@ bool MBPT2(std::ostream &obuff) {
       pass &= qip::check_value(&obuff, "MBPT(2) 'small' Cs 6s", ok, 1, 0);
     }
   }
+
+  { // SOEnergyShift vs. from-scratch calculation, where the valence state
+    // {n,kappa} is also in the basis (can't be confused with basis state)
+    Wavefunction wf({1000, 1.0e-6, 100.0, 0.33 * 100.0, "loglinear", -1.0},
+                    {"Na", -1, "Fermi", -1.0, -1.0}, 1.0);
+    wf.solve_core("HartreeFock", 0.0, "[Ne]");
+    wf.solve_valence("3sp");
+    wf.formBasis({"15spd", 25, 7, 0.0, 1.0e-6, 40.0, false});
+    wf.formSigma(1, false);
+    const auto Sigma = wf.getSigma();
+
+    std::vector<DiracSpinor> holes, excited;
+    for (const auto &Fn : wf.basis) {
+      const bool inCore = std::find(cbegin(wf.core), cend(wf.core), Fn) !=
+                          cend(wf.core);
+      (inCore ? holes : excited).push_back(Fn);
+    }
+
+    double eps = 0.0;
+    for (const auto &Fv : wf.valence) {
+      const auto de = Sigma->SOEnergyShift(Fv, Fv);
+      const auto de0 = helper::SOEnergyShift_direct(Fv, holes, excited);
+      eps = std::max(eps, std::abs((de - de0) / de0));
+    }
+    pass &= qip::check_value(&obuff, "MBPT(2) vs. direct (v in basis)", eps,
+                             0.0, 1.0e-10);
+  }
   return pass;
 }
 
@@ -106,6 +159,41 @@ bool Sigma2(std::ostream &obuff) {
 
     auto [eps, at] = qip::compare_eps(dzuba_g, de);
     pass &= qip::check_value(&obuff, "Sigma2 Cs (spdfg)", eps, 0.0, 0.05);
+
+    { // Sigma file: packed format round-trip, and old format (full matrices,
+      // without/with G) can still be read
+      const std::string fname = "tmp_unit_test_Sigma";
+      MBPT::CorrelationPotential Sigma0 = *wf.getSigma();
+      Sigma0.read_write(fname + ".sig2", IO::FRW::write);
+      helper::write_old_Sigma(fname + ".sig2", fname + "_0.sig2", false, 1.0);
+      helper::write_old_Sigma(fname + ".sig2", fname + "_1.sig2", true, 2.0);
+
+      // Reads Sigma from file (into wf), returns largest |dF|^2, with
+      // dF = Sigma|v> - x*Sigma0|v>
+      const auto read_compare = [&](const std::string &in_fname, double x) {
+        wf.formSigma(3, true, 1.0e-4, 30.0, 14, false, false, {}, {}, in_fname,
+                     "false");
+        const auto &Sigma = *wf.getSigma();
+        double del = 0.0;
+        for (const auto &Fv : wf.valence) {
+          const auto dF = Sigma(Fv) - x * Sigma0(Fv);
+          del = std::max(del, dF * dF);
+        }
+        return del;
+      };
+
+      pass &= qip::check_value(&obuff, "Sigma file (packed) read/write",
+                               read_compare(fname, 1.0), 0.0, 0.0);
+      // nb: ff scaled by x=2 in with-G file, to check it is actually read
+      // (and that G parts are skipped correctly)
+      pass &= qip::check_value(&obuff, "Sigma file (old, no G)",
+                               read_compare(fname + "_0", 1.0), 0.0, 0.0);
+      pass &= qip::check_value(&obuff, "Sigma file (old, with G)",
+                               read_compare(fname + "_1", 2.0), 0.0, 0.0);
+      for (const auto &ext : {".sig2", "_0.sig2", "_1.sig2"}) {
+        std::remove((fname + ext).c_str());
+      }
+    }
   }
   //
 
@@ -150,6 +238,37 @@ bool Sigma2(std::ostream &obuff) {
 bool SigmaAO(std::ostream &obuff) {
   bool pass = true;
 
+  { // Batched HF Green's function (all Im{en} at once) vs. one-at-a-time
+    Wavefunction wf({2000, 1.0e-6, 120.0, 0.33 * 120.0, "loglinear", -1.0},
+                    {"Na", -1, "Fermi", -1.0, -1.0}, 1.0);
+    wf.solve_core("HartreeFock", 0.0, "[Ne]");
+    wf.formBasis({"20spd", 30, 7, 0.0, 1.0e-6, 40.0, false});
+
+    const std::vector<double> en_im{0.01, 0.1, 1.0, 10.0};
+    const double en_re = -0.2;
+    for (const bool mixed : {false, true}) {
+      MBPT::Sigma_params sigp{MBPT::Method::Feynman, 2, false, 2};
+      sigp.mixedPrecision = mixed;
+      const MBPT::FeynmanSigma Sigma(wf.getHF(), wf.basis, sigp,
+                                     {1.0e-4, 30.0, 10}, "false");
+      double eps = 0.0;
+      for (int kappa : {-1, 1, -2}) {
+        const auto Gs = Sigma.Green(kappa, en_re, en_im);
+        for (auto i = 0ul; i < en_im.size(); ++i) {
+          const auto G = Sigma.Green(kappa, {en_re, en_im[i]});
+          const auto [re, im] = G.max_el();
+          const auto [dre, dim] = (Gs[i] - G).max_el();
+          eps = std::max(eps, std::max(std::abs(dre), std::abs(dim)) /
+                                  std::max(std::abs(re), std::abs(im)));
+        }
+      }
+      pass &= qip::check_value(&obuff,
+                               mixed ? "Green_hf batch (mixed)"
+                                     : "Green_hf batch",
+                               eps, 0.0, mixed ? 1.0e-6 : 1.0e-9);
+    }
+  }
+
   { // Compare Dzuba, All-order sigma
     auto dzuba_i =
         std::vector{-0.14332871, -0.05844404, -0.09244689, -0.08985968,
@@ -208,3 +327,99 @@ bool CorrelationPotential(std::ostream &obuff) {
 }
 
 } // namespace UnitTest
+
+//******************************************************************************
+inline void UnitTest::helper::write_old_Sigma(const std::string &packed_fname,
+                                              const std::string &old_fname,
+                                              bool include_G, double x) {
+  using namespace IO::FRW;
+  std::fstream in, out;
+  open_binary(in, packed_fname, read);
+  open_binary(out, old_fname, write);
+  // Copies header values (same in both formats)
+  const auto copy = [&](auto &... value) {
+    rw_binary(in, read, value...);
+    rw_binary(out, write, value...);
+  };
+
+  double r0, rmax, b;
+  std::size_t num_points, subgrid_points, imin, stride, num_kappas;
+  std::string basis_config;
+  copy(r0, rmax, b, num_points);
+  copy(basis_config);
+  copy(subgrid_points, imin, stride);
+  for (auto i = 0ul; i < subgrid_points; ++i) {
+    double r;
+    copy(r);
+  }
+  copy(num_kappas);
+  // format flag: 2/3 (packed, without/with G) -> 0/1 (full)
+  int flag;
+  rw_binary(in, read, flag);
+  const bool packed_G = flag == 3;
+  int old_flag = include_G ? 1 : 0;
+  rw_binary(out, write, old_flag);
+  for (auto i = 0ul; i < num_kappas; ++i) {
+    int n, k;
+    double en;
+    copy(n, k, en);
+  }
+
+  for (auto ik = 0ul; ik < num_kappas; ++ik) {
+    MBPT::PackedGMatrix G(subgrid_points, packed_G);
+    for (auto &v : G.ff.data())
+      rw_binary(in, read, v);
+    if (packed_G) {
+      for (auto &v : G.gg.data())
+        rw_binary(in, read, v);
+      for (auto i = 0ul; i < subgrid_points * subgrid_points; ++i)
+        rw_binary(in, read, G.fg.m->data[i]);
+    }
+    const auto ff = G.unpack().ff;
+    for (auto i = 0ul; i < subgrid_points; ++i) {
+      for (auto j = 0ul; j < subgrid_points; ++j) {
+        auto ff_ij = x * ff[i][j];
+        rw_binary(out, write, ff_ij);
+        if (include_G) {
+          double junk = 1.0e3 * double(i + 1) - double(j);
+          rw_binary(out, write, junk, junk, junk);
+        }
+      }
+    }
+  }
+}
+
+//******************************************************************************
+inline double
+UnitTest::helper::SOEnergyShift_direct(const DiracSpinor &v,
+                                       const std::vector<DiracSpinor> &holes,
+                                       const std::vector<DiracSpinor> &excited) {
+  double de = 0.0;
+  for (const auto &a : holes) {
+    for (const auto &n : excited) {
+      const auto [kmin, kmax] = Coulomb::k_minmax(n, a);
+      for (int k = kmin; k <= kmax; ++k) {
+        if (Angular::Ck_kk(k, a.k, n.k) == 0.0)
+          continue;
+        const auto f_kkjj = (2 * k + 1) * v.twojp1();
+        for (const auto &m : excited) {
+          const auto Qk = Coulomb::Qk_abcd(v, a, m, n, k);
+          if (Qk == 0.0)
+            continue;
+          const auto Pk = Coulomb::Pk_abcd(v, a, m, n, k);
+          const auto dele = v.en() + a.en() - m.en() - n.en();
+          de += ((1.0 / dele / f_kkjj) * (Qk + Pk)) * Qk;
+        }
+        for (const auto &b : holes) {
+          const auto Qk = Coulomb::Qk_abcd(v, n, b, a, k);
+          if (Qk == 0.0)
+            continue;
+          const auto Pk = Coulomb::Pk_abcd(v, n, b, a, k);
+          const auto dele = v.en() + n.en() - b.en() - a.en();
+          de += ((1.0 / dele / f_kkjj) * (Qk + Pk)) * Qk;
+        }
+      }
+    }
+  }
+  return de;
+}
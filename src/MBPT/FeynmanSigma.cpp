@@ -13,6 +13,7 @@
 #include "Maths/LinAlg_MatrixVector.hpp"
 #include "qip/Vector.hpp"
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <numeric>
 #include <optional>
@@ -40,6 +41,7 @@ FeynmanSigma::FeynmanSigma(const HF::HartreeFock *const in_hf,
     : CorrelationPotential(in_hf, basis, sigp, subgridp),
       m_screen_Coulomb(sigp.screenCoulomb),
       m_holeParticle(sigp.holeParticle),
+      m_mixed_precision(sigp.mixedPrecision),
       m_omre(sigp.real_omega),
       m_w0(sigp.w0),
       m_w_ratio(sigp.w_ratio),
@@ -97,7 +99,8 @@ void FeynmanSigma::formSigma(int kappa, double en, int n) {
   }
 
   m_nk.emplace_back(n, kappa, en);
-  auto &Sigma = m_Sigma_kappa.emplace_back(m_subgrid_points, m_include_G);
+  auto &Sigma_packed =
+      m_Sigma_kappa.emplace_back(m_subgrid_points, m_include_G);
 
   // if v.kappa > basis, then Ck angular factor won't exist!
   if (Angular::twoj_k(kappa) > m_yeh.Ck().max_tj()) {
@@ -107,6 +110,7 @@ void FeynmanSigma::formSigma(int kappa, double en, int n) {
 
   printf("k=%2i at en=%8.5f.. ", kappa, en);
   std::cout << std::flush;
+  GMatrix Sigma(m_subgrid_points, m_include_G);
 
   // find lowest excited state, output <v|S|v> energy shift:
   const auto find_kappa = [kappa, n](const auto &a) {
@@ -155,6 +159,8 @@ void FeynmanSigma::formSigma(int kappa, double en, int n) {
   }
 
   Sigma += Gmat_X;
+  // Sigma is symmetric: stored packed
+  Sigma_packed = PackedGMatrix(Sigma);
 
   std::cout << "\n";
 }
@@ -164,6 +170,10 @@ void FeynmanSigma::prep_Feynman() {
 
   // Extand 6j and Ck
   m_6j.fill(2 * m_maxk); //?
+  m_Lkl = Angular::RecouplingCache(
+      m_maxk, [this](int k, int l, int ka, int kb, int kc, int kd) {
+        return Lkl_abcd(k, l, ka, kb, kc, kd);
+      });
   // m_yeh.extend_Ck(m_maxk); // XXX Check max k OK in Ck tables!?
 
   if (m_screen_Coulomb)
@@ -430,6 +440,12 @@ ComplexGMatrix FeynmanSigma::Green(int kappa, ComplexDouble en, States states,
                                      : Green_hf_basis(kappa, en);
 }
 
+std::vector<ComplexGMatrix>
+FeynmanSigma::Green(int kappa, double en_re,
+                    const std::vector<double> &en_im) const {
+  return Green_hf_batch(kappa, en_re, en_im);
+}
+
 //******************************************************************************
 ComplexGMatrix FeynmanSigma::G_single(const DiracSpinor &ket,
                                       const DiracSpinor &bra,
@@ -504,6 +520,26 @@ ComplexGMatrix FeynmanSigma::Green_ex(int kappa, ComplexDouble en,
   return Gk;
 }
 
+//------------------------------------------------------------------------------
+std::vector<ComplexGMatrix>
+FeynmanSigma::Green_ex_batch(int kappa, double en_re,
+                             const std::vector<double> &en_im, GrMethod method,
+                             const DiracSpinor *Fc_hp, int k_hp) const {
+  if (method == GrMethod::basis) {
+    std::vector<ComplexGMatrix> Gs;
+    Gs.reserve(en_im.size());
+    for (const auto w : en_im) {
+      Gs.push_back(Green_hf_basis(kappa, {en_re, w}, true));
+    }
+    return Gs;
+  }
+  auto Gs = Green_hf_batch(kappa, en_re, en_im, Fc_hp, k_hp);
+  for (auto &Gk : Gs) {
+    makeGOrthogCore(&Gk, kappa);
+  }
+  return Gs;
+}
+
 //------------------------------------------------------------------------------
 void FeynmanSigma::makeGOrthogCore(ComplexGMatrix *Gk, int kappa) const {
   // Force Gk to be orthogonal to the core states
@@ -543,9 +579,9 @@ ComplexGMatrix FeynmanSigma::Green_hf_basis(int kappa, ComplexDouble en,
 }
 
 //------------------------------------------------------------------------------
-ComplexGMatrix FeynmanSigma::Green_hf(int kappa, ComplexDouble en,
-                                      const DiracSpinor *Fc_hp,
-                                      int k_hp) const {
+std::pair<GMatrix, GMatrix>
+FeynmanSigma::Green_hf_G0Vx(int kappa, double en_re, const DiracSpinor *Fc_hp,
+                            int k_hp, const HomogSolns *x0xI) const {
   [[maybe_unused]] auto sp = IO::Profile::safeProfiler(__func__);
 
   /*
@@ -569,8 +605,15 @@ works better for k=0 (and k>=5 ?)
     qip::compose(std::minus{}, &vl, y0cc);
   }
 
-  DiracODE::regularAtOrigin(x0, en.re(), vl, Hmag, alpha);
-  DiracODE::regularAtInfinity(xI, en.re(), vl, Hmag, alpha);
+  if (x0xI != nullptr) {
+    // Already solved for (see homog_kappa): only valid if vl not modified
+    assert(x0xI->first.k == kappa && !(Fc_hp != nullptr && k_hp != 0));
+    x0 = x0xI->first;
+    xI = x0xI->second;
+  } else {
+    DiracODE::regularAtOrigin(x0, en_re, vl, Hmag, alpha);
+    DiracODE::regularAtInfinity(xI, en_re, vl, Hmag, alpha);
+  }
 
   // Evaluate Wronskian at ~65% of the way to pinf. Should be inependent of r
   const auto pp = std::size_t(0.65 * double(xI.max_pt()));
@@ -578,7 +621,7 @@ works better for k=0 (and k>=5 ?)
   const auto w = -1.0 * (xI.f(pp) * x0.g(pp) - x0.f(pp) * xI.g(pp)) / alpha;
 
   // Get G0 (Green's function, without exchange):
-  const auto g0 = MakeGreensG0(x0, xI, w);
+  auto g0 = MakeGreensG0(x0, xI, w);
   auto Vx = get_Vx_kappa(kappa);
 
   if (Fc_hp != nullptr && k_hp == 0) {
@@ -587,6 +630,17 @@ works better for k=0 (and k>=5 ?)
     Vx += calculate_Vhp(*Fc_hp);
   }
 
+  return {std::move(g0), std::move(Vx)};
+}
+
+//------------------------------------------------------------------------------
+ComplexGMatrix FeynmanSigma::Green_hf(int kappa, ComplexDouble en,
+                                      const DiracSpinor *Fc_hp,
+                                      int k_hp) const {
+  [[maybe_unused]] auto sp = IO::Profile::safeProfiler(__func__);
+
+  const auto [g0, Vx] = Green_hf_G0Vx(kappa, en.re(), Fc_hp, k_hp);
+
   const ComplexDouble one{1.0, 0.0}; // to convert real to complex
 
   // Include exchange, and imaginary energy part:
@@ -602,10 +656,58 @@ works better for k=0 (and k>=5 ?)
   // G(e) = [1 + i*Im{e}*G0 - G0*Vx]^{-1} * G0
   // Note: differential dr is included in Vx (via Q)
   ComplexDouble iw{0.0, en.im()};
-  return ((iw * g0).mult_elements_by(*m_drj) - one * (g0 * Vx))
-             .plusIdent(1.0)
-             .invert() *
-         (one * g0);
+  auto X = (iw * g0).mult_elements_by(*m_drj) - one * (g0 * Vx);
+  X.plusIdent(1.0);
+  if (m_mixed_precision) {
+    // Solve X*G = G0 directly, in mixed precision
+    ComplexGMatrix G(m_subgrid_points, m_include_G);
+    G.set_from(LinAlg::solve_mixed(X.contiguous(), (one * g0).contiguous()));
+    return G;
+  }
+  return X.invert() * (one * g0);
+}
+
+//------------------------------------------------------------------------------
+std::vector<ComplexGMatrix>
+FeynmanSigma::Green_hf_batch(int kappa, double en_re,
+                             const std::vector<double> &en_im,
+                             const DiracSpinor *Fc_hp, int k_hp,
+                             const HomogSolns *x0xI) const {
+  [[maybe_unused]] auto sp = IO::Profile::safeProfiler(__func__);
+  // G(e) = [1 + i*Im{e}*G0 - G0*Vx]^{-1} * G0, as in Green_hf(). G0 and Vx
+  // depend only on Re{e}: calculated once, for all Im{e}. The [..] matrices
+  // are formed + inverted as contiguous (full) matrices, together (or, if
+  // m_mixed_precision, X*G = G0 is solved directly for each).
+
+  const auto [g0, Vx] = Green_hf_G0Vx(kappa, en_re, Fc_hp, k_hp, x0xI);
+
+  const ComplexDouble one{1.0, 0.0};
+  const auto g0c = one * g0;
+  const auto g0z = g0c.contiguous();
+  const auto g0drz = mult_elements(g0c, *m_drj).contiguous();
+  auto g0Vxz = (one * (g0 * Vx)).contiguous();
+  g0Vxz *= -1.0;
+
+  std::vector<LinAlg::ZSqMatrix> Xs(en_im.size(), g0Vxz);
+  for (auto i = 0ul; i < en_im.size(); ++i) {
+    Xs[i].axpy({0.0, en_im[i]}, g0drz).plusIdent(1.0);
+  }
+
+  std::vector<ComplexGMatrix> Gs(en_im.size(),
+                                 ComplexGMatrix(m_subgrid_points, m_include_G));
+  if (m_mixed_precision) {
+#pragma omp parallel for
+    for (auto i = 0ul; i < Xs.size(); ++i) {
+      Gs[i].set_from(LinAlg::solve_mixed(Xs[i], g0z));
+    }
+    return Gs;
+  }
+
+  LinAlg::invert_batch(&Xs);
+  for (auto i = 0ul; i < Xs.size(); ++i) {
+    Gs[i].set_from(Xs[i] * g0z);
+  }
+  return Gs;
 }
 
 //------------------------------------------------------------------------------
@@ -616,7 +718,14 @@ ComplexGMatrix FeynmanSigma::GreenAtComplex(const ComplexGMatrix &Gr,
   // G(w) =  G(re(w)+im(w)) ;  Gr = G(re(w)), G = G(w),   im(w) = wi
   // G = Gr * [1 + i*wi*Gr]^-1 = Gr * iX
   const ComplexDouble iw{0.0, om_imag};
-  return ((iw * Gr).mult_elements_by(*m_drj).plusIdent(1.0).invert()) * Gr;
+  auto X = (iw * Gr).mult_elements_by(*m_drj).plusIdent(1.0);
+  if (m_mixed_precision) {
+    // Solve X*G = Gr directly, in mixed precision
+    ComplexGMatrix G(m_subgrid_points, m_include_G);
+    G.set_from(LinAlg::solve_mixed(X.contiguous(), Gr.contiguous()));
+    return G;
+  }
+  return X.invert() * Gr;
 }
 
 //------------------------------------------------------------------------------
@@ -712,16 +821,84 @@ std::vector<std::vector<ComplexGMatrix>>
 FeynmanSigma::make_pi_wk(int max_k, GrMethod pol_method, double omre,
                          const Grid &wgrid) const {
   [[maybe_unused]] auto sp = IO::Profile::safeProfiler(__func__);
+  // pi_k(w) = i * sum_{a,n} c_ang * [G_n(ea - w) + G_n(ea + w)] * |a><a|
+  // (see Polarisation_k). G_n(ea -/+ w) is independent of k (except k=0 vs.
+  // k!=0, with hole-particle), so it is calculated once for each {a,n}, and
+  // for all w at once (Green_ex_batch), then added to each pi_k(w).
+  // The G_n are calculated in parallel, but summed into pi_k(w) in the fixed
+  // order of {a,n} (omp ordered), so result doesn't depend on thread timing
 
   const auto num_ks = std::size_t(max_k + 1);
-  std::vector<std::vector<ComplexGMatrix>> pi_wk(wgrid.num_points());
+  const auto &core = p_hf->get_core();
+  const auto &ws = wgrid.r();
+  auto minus_ws = ws;
+  for (auto &w : minus_ws) {
+    w = -w;
+  }
 
-#pragma omp parallel for
-  for (auto iw = 0ul; iw < wgrid.num_points(); ++iw) {
-    const auto omega = ComplexDouble{omre, wgrid.r()[iw]};
-    pi_wk[iw].reserve(num_ks);
+  // List of {a,n} pairs that contribute to at least one k
+  std::vector<std::pair<std::size_t, int>> an_list;
+  for (auto ia = 0ul; ia < core.size(); ++ia) {
+    if (core[ia].n < m_min_core_n)
+      continue;
+    for (int in = 0; in <= m_max_kappaindex; ++in) {
+      const auto kn = Angular::kappaFromIndex(in);
+      for (int k = 0; k <= max_k; ++k) {
+        if (Angular::Ck_kk(k, core[ia].k, kn) != 0.0) {
+          an_list.emplace_back(ia, in);
+          break;
+        }
+      }
+    }
+  }
+
+  std::vector<std::vector<ComplexGMatrix>> pi_wk(
+      wgrid.num_points(),
+      std::vector<ComplexGMatrix>(
+          num_ks, ComplexGMatrix(m_subgrid_points, m_include_G)));
+
+#pragma omp parallel for schedule(dynamic) ordered
+  for (auto i = 0ul; i < an_list.size(); ++i) {
+    const auto [ia, in] = an_list[i];
+    const auto &a = core[ia];
+    const auto &pa = m_Pa[ia]; // |a><a|
+    const auto kn = Angular::kappaFromIndex(in);
+    const auto *Fa_hp = m_holeParticle ? &a : nullptr;
+
+    // [G_n(ea - w) + G_n(ea + w)] * |a><a|, for each w; {k=0, k!=0}
+    std::array<std::vector<ComplexGMatrix>, 2> gpa;
     for (auto k = 0ul; k < num_ks; ++k) {
-      pi_wk[iw].push_back(Polarisation_k(int(k), omega, pol_method));
+      if (Angular::Ck_kk(int(k), a.k, kn) == 0.0)
+        continue;
+      auto &gs = gpa[m_holeParticle && k == 0 ? 0 : 1];
+      if (gs.empty()) {
+        gs = Green_ex_batch(kn, a.en() - omre, minus_ws, pol_method, Fa_hp,
+                            int(k));
+        const auto gs_plus = Green_ex_batch(kn, a.en() + omre, ws, pol_method,
+                                            Fa_hp, int(k));
+        for (auto iw = 0ul; iw < gs.size(); ++iw) {
+          (gs[iw] += gs_plus[iw]).mult_elements_by(pa);
+        }
+      }
+    }
+
+#pragma omp ordered
+    for (auto k = 0ul; k < num_ks; ++k) {
+      const auto ck_an = Angular::Ck_kk(int(k), a.k, kn);
+      if (ck_an == 0.0)
+        continue;
+      const double c_ang = ck_an * ck_an / double(2 * k + 1);
+      const auto &gs = gpa[m_holeParticle && k == 0 ? 0 : 1];
+      for (auto iw = 0ul; iw < gs.size(); ++iw) {
+        pi_wk[iw][k].axpy(c_ang, gs[iw]);
+      }
+    }
+  }
+
+  const auto Iunit = ComplexDouble{0.0, 1.0};
+  for (auto &pi_k : pi_wk) {
+    for (auto &pi : pi_k) {
+      pi *= Iunit;
     }
   }
   return pi_wk;
@@ -763,6 +940,79 @@ FeynmanSigma::form_QPQ_wk(int max_k, GrMethod pol_method, double omre,
   return qpq;
 }
 
+//******************************************************************************
+std::vector<FeynmanSigma::HomogSolns>
+FeynmanSigma::homog_kappa(int max_kappa_index, double en_re) const {
+  [[maybe_unused]] auto sp = IO::Profile::safeProfiler(__func__);
+  // Kappas are grouped by local potential (depends on l only via radiative
+  // potential; usually all the same), and each group solved together
+  const auto alpha = p_hf->get_alpha();
+  const auto num_kappas = std::size_t(max_kappa_index + 1);
+  struct Group {
+    std::vector<double> vl, Hmag;
+    std::vector<std::size_t> iks{};
+  };
+  std::vector<Group> groups;
+  for (auto ik = 0ul; ik < num_kappas; ++ik) {
+    const auto l = Angular::l_k(Angular::kappaFromIndex(int(ik)));
+    auto vl = p_hf->get_vlocal(l);
+    auto Hmag = p_hf->get_Hrad_mag(l);
+    auto group = std::find_if(groups.begin(), groups.end(), [&](const auto &g) {
+      return g.vl == vl && g.Hmag == Hmag;
+    });
+    if (group == groups.end()) {
+      groups.push_back(Group{std::move(vl), std::move(Hmag), {}});
+      group = std::prev(groups.end());
+    }
+    group->iks.push_back(ik);
+  }
+
+  std::vector<HomogSolns> x0xI;
+  x0xI.reserve(num_kappas);
+  for (auto ik = 0ul; ik < num_kappas; ++ik) {
+    const auto kappa = Angular::kappaFromIndex(int(ik));
+    x0xI.emplace_back(DiracSpinor(0, kappa, p_gr), DiracSpinor(0, kappa, p_gr));
+  }
+
+  // Each group is split into batches of (at most) 8 kappas - the widest
+  // batch of SIMD lanes in DiracODE - and x0, xI solved separately; these
+  // independent solves are shared between threads
+  constexpr std::size_t max_lanes = 8;
+  struct Batch {
+    const Group *group;
+    std::size_t i0, i1;
+    bool outward;
+  };
+  std::vector<Batch> batches;
+  for (const auto &group : groups) {
+    for (auto i0 = 0ul; i0 < group.iks.size(); i0 += max_lanes) {
+      const auto i1 = std::min(i0 + max_lanes, group.iks.size());
+      batches.push_back({&group, i0, i1, true});
+      batches.push_back({&group, i0, i1, false});
+    }
+  }
+
+#pragma omp parallel for schedule(dynamic)
+  for (auto ib = 0ul; ib < batches.size(); ++ib) {
+    const auto &[group, i0, i1, outward] = batches[ib];
+    std::vector<int> kappas;
+    for (auto i = i0; i < i1; ++i) {
+      kappas.push_back(Angular::kappaFromIndex(int(group->iks[i])));
+    }
+    const std::vector<double> ens(kappas.size(), en_re);
+    const auto xs =
+        outward ? DiracODE::regularAtOrigin(kappas, ens, group->vl,
+                                            group->Hmag, alpha, p_gr)
+                : DiracODE::regularAtInfinity(kappas, ens, group->vl,
+                                              group->Hmag, alpha, p_gr);
+    for (auto i = i0; i < i1; ++i) {
+      auto &x0xI_k = x0xI[group->iks[i]];
+      (outward ? x0xI_k.first : x0xI_k.second) = xs[i - i0];
+    }
+  }
+  return x0xI;
+}
+
 //******************************************************************************
 std::vector<std::vector<ComplexGMatrix>>
 FeynmanSigma::form_Greens_kapw(int max_kappa_index, GrMethod method,
@@ -771,10 +1021,19 @@ FeynmanSigma::form_Greens_kapw(int max_kappa_index, GrMethod method,
   // nb: en_re = en_v + omre
 
   const auto num_kappas = std::size_t(max_kappa_index + 1);
+  // Homogeneous solutions, all kappas at once (batched DE solve)
+  const auto x0xI = method == GrMethod::Green
+                        ? homog_kappa(max_kappa_index, en_re)
+                        : std::vector<HomogSolns>{};
   std::vector<std::vector<ComplexGMatrix>> gs(num_kappas);
 #pragma omp parallel for
   for (auto ik = 0ul; ik < num_kappas; ++ik) {
     const auto kappa = Angular::kappaFromIndex(int(ik));
+    if (method == GrMethod::Green) {
+      // All w at once (w-independent parts calculated once)
+      gs[ik] = Green_hf_batch(kappa, en_re, wgrid.r(), nullptr, 0, &x0xI[ik]);
+      continue;
+    }
     gs[ik].reserve(wgrid.num_points());
     for (auto iw = 0ul; iw < wgrid.num_points(); iw++) {
       ComplexDouble evpw{en_re, wgrid.r()[iw]};
@@ -820,14 +1079,18 @@ GMatrix FeynmanSigma::FeynmanDirect(int kv, double env, int in_k) const {
     // I, since dw is on imag. grid; 2 from symmetric +/- w
     const auto dw = I * weight * wgrid.drdu()[iw];
 
+    // Work-space, re-used for each k
+    // \sum_B c_B (g_B * QPQ) = (\sum_B c_B g_B) * QPQ [element-wise]
+    ComplexGMatrix sum_gB(m_subgrid_points, m_include_G);
+
     for (auto k = 0ul; int(k) <= max_k; k++) {
 
       // For testing only:
       if (in_k >= 0 && in_k != int(k))
         continue;
 
-      const auto qpq_dw = dw * m_qpq_wk[iw][k];
-
+      sum_gB.zero();
+      bool any_B = false;
       for (auto iB = 0ul; iB < num_kappas; ++iB) {
         const auto kB = Angular::kappaFromIndex(int(iB));
         const auto ck_vB = Angular::Ck_kk(int(k), kv, kB);
@@ -835,15 +1098,21 @@ GMatrix FeynmanSigma::FeynmanDirect(int kv, double env, int in_k) const {
           continue;
 
         const auto c_ang = ck_vB * ck_vB / double(Angular::twoj_k(kv) + 1);
-        const auto C_gB_QPQ_dw =
-            c_ang * (mult_elements(gBs[iB][iw], qpq_dw)).get_real();
+        sum_gB.axpy(c_ang, gBs[iB][iw]);
+        any_B = true;
+      } // beta
+      if (!any_B)
+        continue;
+
+      sum_gB.mult_elements_by(m_qpq_wk[iw][k]);
+      sum_gB *= dw;
+      const auto C_gB_QPQ_dw = sum_gB.get_real();
 
 #pragma omp critical(sum_sigma_d)
-        { Sigma += C_gB_QPQ_dw; }
+      { Sigma += C_gB_QPQ_dw; }
 
-      } // k
-    }   // omega
-  }     // beta
+    } // k
+  }   // omega
 
   // Extra 2 from symmetric + / -w
   Sigma *= (2.0 * sw * wgrid.du() / (2 * M_PI));
@@ -950,7 +1219,7 @@ GMatrix FeynmanSigma::FeynmanEx_w1w2(int kv, double en_r) const {
                   Green(kG, ev_p_w2, States::both, m_Green_method);
               const auto gqgqg_p =
                   sumkl_gqgqg(gA, gB_p, gG_p, kv, kA, kB, kG, max_k);
-              Sc_i += (dw1 * dw2) * (gqgqg_p);
+              Sc_i.axpy(dw1 * dw2, gqgqg_p);
             }
 
             // nb: I thought these should be Sc_i -= ...
@@ -969,7 +1238,7 @@ GMatrix FeynmanSigma::FeynmanEx_w1w2(int kv, double en_r) const {
               const auto gqgqg_m =
                   sumkl_gqgqg(gA, gB_m, gG_m, kv, kA, kB, kG, max_k);
               // -ve for 'm', since we go wrong direction around w2 contour??
-              Sc_i += (dw1 * (-dw2)) * (gqgqg_m);
+              Sc_i.axpy(dw1 * (-dw2), gqgqg_m);
             }
 
             // im(gqgqg_m) is small, but real part is v. large
@@ -1073,7 +1342,7 @@ GMatrix FeynmanSigma::FeynmanEx_1(int kv, double env) const {
           const auto gqpg =
               sumkl_GQPGQ(gA, gxBm, gxBp, pa, kv, kA, kB, Fa.k, qpqw_k);
 
-          Sx_k[tid] += dw1 * gqpg;
+          Sx_k[tid].axpy(dw1, gqpg);
 
         } // alpha
       }   // a
@@ -1114,24 +1383,25 @@ GMatrix FeynmanSigma::sumkl_gqgqg(const ComplexGMatrix &gA,
 
   auto gqgqg = GMatrix(m_subgrid_points, m_include_G);
 
-  for (int k = 0; k <= kmax; k++) { // k (k1)
+  assert(kmax <= m_Lkl.max_k());
+  // Only loop over non-zero angular factors (ordered by k, then l)
+  const auto &Lkl_terms = m_Lkl.get(kv, kB, kA, kG).nonzero();
+  for (const auto &[k, l, Lkl] : Lkl_terms) {
+    if (k > kmax)
+      break;
+    if (l > kmax)
+      continue;
     const auto &qk = get_qk(k);
-
-    for (int l = 0; l <= kmax; l++) { // l (k2)
-      const auto &ql = get_qk(l);
-
-      // tensor_5_product adds the real part of below to result
-      // Sum_ij [ factor * a1j * bij * cj2 * (d_1i * e_i2) ]
-      const auto Lkl = Lkl_abcd(k, l, kv, kB, kA, kG);
-      if (Lkl != 0.0) {
-        const auto s = Angular::neg1pow(k + l);
-        // const auto sLkl = ComplexDouble{s * Lkl, 0.0};
-        // // XXX extra factor of i ??: - pretty sure this is wrong
-        const auto sLkl = ComplexDouble{0.0, s * Lkl};
-        tensor_5_product(&gqgqg, sLkl, qk, gB, gG, gA, ql);
-      }
-    } // l
-  }   // k
+    const auto &ql = get_qk(l);
+
+    // tensor_5_product adds the real part of below to result
+    // Sum_ij [ factor * a1j * bij * cj2 * (d_1i * e_i2) ]
+    const auto s = Angular::neg1pow(k + l);
+    // const auto sLkl = ComplexDouble{s * Lkl, 0.0};
+    // // XXX extra factor of i ??: - pretty sure this is wrong
+    const auto sLkl = ComplexDouble{0.0, s * Lkl};
+    tensor_5_product(&gqgqg, sLkl, qk, gB, gG, gA, ql);
+  }
 
   return gqgqg;
 }
@@ -1150,35 +1420,37 @@ GMatrix FeynmanSigma::sumkl_GQPGQ(
 
   const auto kmax = std::min(m_maxk, m_k_cut);
 
+  const auto &L1_kl = m_Lkl.get(kv, kB, kA, ka);
+  const auto &L2_kl = m_Lkl.get(kv, ka, kA, kB);
+
   for (auto k = 0; k <= kmax; ++k) {
+    // Only non-zero angular factors (skip k entirely if none)
+    const auto L1_terms = L1_kl.nonzero(k);
+    const auto L2_terms = L2_kl.nonzero(k);
+    if (L1_terms.empty() && L2_terms.empty())
+      continue;
+
     // qk -> qk - 2i * QPxQ
     const auto &tqk = get_qk(k);
     // Screen q^k(w1) {not checked}
     const auto qk =
         qpqw_k != nullptr ? tqk - 2.0 * I * (*qpqw_k)[std::size_t(k)] : tqk;
 
-    for (auto l = 0; l <= kmax; ++l) {
-      const auto &ql = get_qk(l);
-
-      const auto s0 = Angular::neg1pow(k + l);
-
-      const auto L1 = Lkl_abcd(k, l, kv, kB, kA, ka);
-      const auto L2 = Lkl_abcd(k, l, kv, ka, kA, kB);
-
-      const auto ic1 = ComplexDouble(s0 * L1, 0.0);
-      const auto ic2 = ComplexDouble(s0 * L2, 0.0);
-
-      // tensor_5_product adds the real part of below to result
-      // Sum_ij [ factor * a1j * bij * cj2 * (d_1i * e_i2) ]
-
-      if (L1 != 0.0)
-        tensor_5_product(&sum_GQPG, ic1, qk, gxBp, pa, gA, ql);
-
-      if (L2 != 0.0)
-        tensor_5_product(&sum_GQPG, ic2, qk, pa, gxBm, gA, ql);
-
-    } // l
-  }   // k
+    // tensor_5_product adds the real part of below to result
+    // Sum_ij [ factor * a1j * bij * cj2 * (d_1i * e_i2) ]
+    for (const auto &[k1, l, L1] : L1_terms) {
+      if (l > kmax)
+        break;
+      const auto ic1 = ComplexDouble(Angular::neg1pow(k1 + l) * L1, 0.0);
+      tensor_5_product(&sum_GQPG, ic1, qk, gxBp, pa, gA, get_qk(l));
+    }
+    for (const auto &[k2, l, L2] : L2_terms) {
+      if (l > kmax)
+        break;
+      const auto ic2 = ComplexDouble(Angular::neg1pow(k2 + l) * L2, 0.0);
+      tensor_5_product(&sum_GQPG, ic2, qk, pa, gxBm, gA, get_qk(l));
+    }
+  } // k
 
   return sum_GQPG;
 }
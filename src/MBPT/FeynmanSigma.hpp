@@ -1,8 +1,10 @@
 #pragma once
+#include "Angular/RecouplingCache.hpp"
 #include "CorrelationPotential.hpp"
 #include "Maths/Grid.hpp"
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 // class Grid;
 namespace HF {
@@ -65,6 +67,9 @@ public:
   [[nodiscard]] ComplexGMatrix Green(int kappa, ComplexDouble en,
                                      States states = States::both,
                                      GrMethod method = GrMethod::Green) const;
+  //! HF Greens function, G_kappa(en_re + i*en_im), for each en_im (batched)
+  [[nodiscard]] std::vector<ComplexGMatrix>
+  Green(int kappa, double en_re, const std::vector<double> &en_im) const;
 
   // Make this private?
   //! Takes Gr = G(e_r) and e_i, returns G(e_r + i e_i). nb: Must be FULL green
@@ -100,6 +105,9 @@ public:
                                         const ComplexDouble f) const;
 
 private:
+  // Homogeneous solutions of DE: {regular at 0, regular at infinity}
+  using HomogSolns = std::pair<DiracSpinor, DiracSpinor>;
+
   // Calculates initial data needed for Feynman (|a><a|, w grids etc)
   void prep_Feynman();
   // Calculates + stores the (radial) q^k matrix, for each k (includes dri*drj)
@@ -122,6 +130,11 @@ private:
                                         GrMethod method = GrMethod::Green,
                                         const DiracSpinor *Fc_hp = nullptr,
                                         int k_hp = 0) const;
+  // G_ex(en_re + i*en_im) for each en_im; see Green_hf_batch
+  [[nodiscard]] std::vector<ComplexGMatrix>
+  Green_ex_batch(int kappa, double en_re, const std::vector<double> &en_im,
+                 GrMethod method, const DiracSpinor *Fc_hp = nullptr,
+                 int k_hp = 0) const;
 
   // Force Gk to be orthogonal to the core states
   void makeGOrthogCore(ComplexGMatrix *Gk, int kappa) const;
@@ -132,6 +145,23 @@ private:
   [[nodiscard]] ComplexGMatrix Green_hf(int kappa, ComplexDouble en,
                                         const DiracSpinor *Fc_hp = nullptr,
                                         int k_hp = 0) const;
+  // HF Green function, G(en_re + i*en_im), for each en_im (e.g., on w grid).
+  // Parts that depend only on en_re (G0, Vx) are calculated once, and the
+  // matrices are inverted together (LinAlg::invert_batch)
+  // x0xI: (optional) homogeneous solutions at en_re, see homog_kappa
+  [[nodiscard]] std::vector<ComplexGMatrix>
+  Green_hf_batch(int kappa, double en_re, const std::vector<double> &en_im,
+                 const DiracSpinor *Fc_hp = nullptr, int k_hp = 0,
+                 const HomogSolns *x0xI = nullptr) const;
+  // G0 (no exchange) and Vx (incl. hole-particle) for HF Green function,
+  // G(en) = [1 + i*Im{en}*G0 - G0*Vx]^{-1} * G0; G0 depends only on Re{en}
+  [[nodiscard]] std::pair<GMatrix, GMatrix>
+  Green_hf_G0Vx(int kappa, double en_re, const DiracSpinor *Fc_hp, int k_hp,
+                const HomogSolns *x0xI = nullptr) const;
+  // Homogeneous solutions {x0, xI} (regular at 0, infinity) at en_re, for
+  // each kappa up to max_kappa_index. Solved together (batched DiracODE)
+  [[nodiscard]] std::vector<HomogSolns> homog_kappa(int max_kappa_index,
+                                                    double en_re) const;
 
   // Calculate HF Greens function (complex en), using basis expansion
   [[nodiscard]] ComplexGMatrix Green_hf_basis(int kappa, ComplexDouble en,
@@ -185,6 +215,8 @@ private:
 private:
   const bool m_screen_Coulomb;
   const bool m_holeParticle;
+  // Use mixed-precision solve (LinAlg::solve_mixed) for G at complex energy
+  const bool m_mixed_precision;
 
   const double m_omre;
   const double m_w0;
@@ -210,6 +242,9 @@ private:
 
   std::vector<std::vector<ComplexGMatrix>> m_qpq_wk{};
 
+  // Angular factors for exchange, Lkl_abcd(k,l,a,b,c,d); filled as required
+  Angular::RecouplingCache m_Lkl{};
+
   int m_k_cut = 10; // XXX Make input?
 
   const bool m_print_each_k = false;
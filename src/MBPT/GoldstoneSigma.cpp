@@ -64,7 +64,8 @@ void GoldstoneSigma::formSigma(int kappa, double en, int n) {
   }
 
   m_nk.emplace_back(n, kappa, en);
-  auto &Sigma = m_Sigma_kappa.emplace_back(m_subgrid_points, m_include_G);
+  auto &Sigma_packed =
+      m_Sigma_kappa.emplace_back(m_subgrid_points, m_include_G);
 
   // if v.kappa > basis, then Ck angular factor won't exist!
   if (Angular::twoj_k(kappa) > m_yeh.Ck().max_tj()) {
@@ -74,6 +75,7 @@ void GoldstoneSigma::formSigma(int kappa, double en, int n) {
 
   printf("k=%2i at en=%8.5f.. ", kappa, en);
   std::cout << std::flush;
+  GMatrix Sigma(m_subgrid_points, m_include_G);
   // this->fill_Sigma_k(&Sigma, kappa, en);
 
   // auto Gmat_D = Sigma; // copy
@@ -95,6 +97,8 @@ void GoldstoneSigma::formSigma(int kappa, double en, int n) {
   }
 
   Sigma += Gmat_X;
+  // Sigma is symmetric: stored packed
+  Sigma_packed = PackedGMatrix(Sigma);
 
   std::cout << "\n";
 }
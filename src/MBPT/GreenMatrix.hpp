@@ -1,7 +1,12 @@
 #pragma once
 #include "Maths/LinAlg_MatrixVector.hpp"
+#include <algorithm>
+#include <cassert>
+#include <complex>
 #include <iostream>
 #include <type_traits>
+#include <utility>
+#include <vector>
 namespace MBPT {
 
 //******************************************************************************
@@ -80,10 +85,54 @@ public:
                   "Can only call ffc from Complex GMatrix!");
     return ff.get_copy(i, j);
   }
-  gsl_complex &ffc2(std::size_t i, std::size_t j) const {
+
+  //! Copies the full operator into a single contiguous matrix, [ff fg; gf gg]
+  //! (just ff, if G not included). Complex GMatrix only
+  [[nodiscard]] LinAlg::ZSqMatrix contiguous() const {
     static_assert(std::is_same<T, LinAlg::ComplexSqMatrix>::value,
-                  "Can only call ffc from Complex GMatrix!");
-    return ff[i][j]; // pointer? reference? None! KILL
+                  "Can only call contiguous from Complex GMatrix!");
+    LinAlg::ZSqMatrix z(size + G_size);
+    const auto copy_block = [&z](const T &block, std::size_t i0,
+                                 std::size_t j0) {
+      for (std::size_t i = 0; i < block.n; ++i) {
+        const auto *row = block[i];
+        std::transform(row, row + block.n, z[i0 + i] + j0,
+                       [](const gsl_complex &x) {
+                         return std::complex<double>{GSL_REAL(x), GSL_IMAG(x)};
+                       });
+      }
+    };
+    copy_block(ff, 0, 0);
+    if (m_include_G) {
+      copy_block(fg, 0, size);
+      copy_block(gf, size, 0);
+      copy_block(gg, size, size);
+    }
+    return z;
+  }
+
+  //! Sets from a contiguous matrix, [ff fg; gf gg]: inverse of contiguous().
+  //! Complex GMatrix only
+  GreenMatrix<T> &set_from(const LinAlg::ZSqMatrix &z) {
+    static_assert(std::is_same<T, LinAlg::ComplexSqMatrix>::value,
+                  "Can only call set_from from Complex GMatrix!");
+    assert(z.n() == size + G_size);
+    const auto copy_block = [&z](T *block, std::size_t i0, std::size_t j0) {
+      for (std::size_t i = 0; i < block->n; ++i) {
+        const auto *row = z[i0 + i] + j0;
+        std::transform(row, row + block->n, (*block)[i],
+                       [](const std::complex<double> &x) {
+                         return gsl_complex_rect(x.real(), x.imag());
+                       });
+      }
+    };
+    copy_block(&ff, 0, 0);
+    if (m_include_G) {
+      copy_block(&fg, 0, size);
+      copy_block(&gf, size, 0);
+      copy_block(&gg, size, size);
+    }
+    return *this;
   }
 
   //! Can add/subtract matrices (in place)
@@ -155,17 +204,40 @@ public:
     }
   }
 
+  //! In place: G -> G + x*B
+  template <typename Scalar>
+  GreenMatrix<T> &axpy(const Scalar &x, const GreenMatrix<T> &b) {
+    ff.axpy(x, b.ff);
+    if (m_include_G) {
+      fg.axpy(x, b.fg);
+      gf.axpy(x, b.gf);
+      gg.axpy(x, b.gg);
+    }
+    return *this;
+  }
+
   //! Matrix multplication (in place): Gij -> \sum_k Gik*Bkj
+  //! @details Products formed in (thread-local) scratch matrices, which are
+  //! then swapped in (moved), so no allocations. Safe for b = *this.
   GreenMatrix<T> &operator*=(const GreenMatrix<T> &b) {
+    using Pool = LinAlg::ScratchPool<T>;
     if (m_include_G) {
-      auto tmp = ff;
-      ff = ff * b.ff + fg * b.gf;
-      fg = tmp * b.fg + fg * b.gg; // ff
-      tmp = gf;
-      gf = gf * b.ff + gg * b.gf;
-      gg = tmp * b.fg + gg * b.gg; // gf
+      auto t_ff = Pool::get(size);
+      auto t_fg = Pool::get(size);
+      auto t_gf = Pool::get(size);
+      auto t_gg = Pool::get(size);
+      t_ff->gemm(1.0, ff, b.ff, 0.0).gemm(1.0, fg, b.gf, 1.0);
+      t_fg->gemm(1.0, ff, b.fg, 0.0).gemm(1.0, fg, b.gg, 1.0);
+      t_gf->gemm(1.0, gf, b.ff, 0.0).gemm(1.0, gg, b.gf, 1.0);
+      t_gg->gemm(1.0, gf, b.fg, 0.0).gemm(1.0, gg, b.gg, 1.0);
+      ff = std::move(*t_ff);
+      fg = std::move(*t_fg);
+      gf = std::move(*t_gf);
+      gg = std::move(*t_gg);
     } else {
-      ff = ff * b.ff;
+      auto t_ff = Pool::get(size);
+      t_ff->gemm(1.0, ff, b.ff, 0.0);
+      ff = std::move(*t_ff);
     }
     return *this;
   }
@@ -175,27 +247,27 @@ public:
   }
 
   //! Inversion (in place)
+  //! @details Block inversion; temporaries are (thread-local) scratch
+  //! matrices, so no allocations beyond those of T::invert()
   GreenMatrix<T> &invert() {
     ff.invert();
     if (m_include_G) {
-      // std::cout << "\n XXX \n Warning: Inversion not tesed!\n";
-      const auto &ai = ff; // already inverted
-      const auto &b = fg;
-      const auto &c = gf;
-      const auto &d = gg;
-      const auto cai = c * ai;
-      const auto dmcaib = (d - cai * b).invert();
-      const auto aib_dmcaib = ai * b * dmcaib;
-      ff += aib_dmcaib * cai;
-      if constexpr (std::is_same<T, LinAlg::ComplexSqMatrix>::value) {
-        const auto neg_one = LinAlg::ComplexDouble{-1.0, 0.0};
-        fg = neg_one * aib_dmcaib;
-        gf = neg_one * dmcaib * cai;
-      } else {
-        fg = -1.0 * aib_dmcaib;
-        gf = -1.0 * dmcaib * cai;
-      }
-      gg = dmcaib;
+      // [a b; c d]^-1, with ai = a^-1 (already inverted), and
+      // X = (d - c*ai*b)^-1:
+      // ff = ai + ai*b*X*c*ai, fg = -ai*b*X, gf = -X*c*ai, gg = X
+      using Pool = LinAlg::ScratchPool<T>;
+      auto cai = Pool::get(size);
+      auto aib = Pool::get(size);
+      auto aibX = Pool::get(size);
+      cai->gemm(1.0, gf, ff, 0.0);
+      aib->gemm(1.0, ff, fg, 0.0);
+      // gg -> X = (d - cai*b)^-1
+      gg.gemm(-1.0, *cai, fg, 1.0).invert();
+      aibX->gemm(1.0, *aib, gg, 0.0);
+      ff.gemm(1.0, *aibX, *cai, 1.0);
+      fg = std::move(*aibX);
+      fg *= -1.0;
+      gf.gemm(-1.0, gg, *cai, 0.0);
     }
     return *this;
   }
@@ -299,4 +371,87 @@ using GMatrix = GreenMatrix<LinAlg::SqMatrix>;
 using ComplexGMatrix = GreenMatrix<LinAlg::ComplexSqMatrix>;
 using ComplexDouble = LinAlg::ComplexDouble;
 
+//******************************************************************************
+/*!
+@brief Packed storage for real, symmetric (Hermitian) GMatrix operators, such
+as Sigma: ff and gg are symmetric, and gf = fg^T.
+@details ff and gg are stored packed (see LinAlg::SymPackedMatrix), fg in
+full, and gf not at all: 2N^2 + N values rather than 4N^2 (N(N+1)/2 rather than
+N^2 without G). Constructing from a GMatrix symmetrises it:
+ff -> (ff + ff^T)/2, fg -> (fg + gf^T)/2, etc.
+*/
+class PackedGMatrix {
+public:
+  bool m_include_G{false};
+  std::size_t size{0};
+  std::size_t G_size{0};
+
+public:
+  LinAlg::SymPackedMatrix ff{}, gg{};
+  //! gf = fg^T is not stored
+  LinAlg::SqMatrix fg{};
+
+public:
+  PackedGMatrix() {}
+  //! Zero matrix
+  PackedGMatrix(std::size_t in_size, bool in_include_G)
+      : m_include_G(in_include_G),
+        size(in_size),
+        G_size(m_include_G ? size : 0),
+        ff(size),
+        gg(G_size),
+        fg(G_size) {
+    if (m_include_G)
+      fg.zero();
+  }
+  //! Packs (symmetrised) GMatrix
+  explicit PackedGMatrix(const GMatrix &g)
+      : m_include_G(g.m_include_G),
+        size(g.size),
+        G_size(g.G_size),
+        ff(g.ff),
+        gg(m_include_G ? LinAlg::SymPackedMatrix(g.gg)
+                       : LinAlg::SymPackedMatrix(0)),
+        fg(G_size) {
+    for (std::size_t i = 0; i < G_size; ++i) {
+      for (std::size_t j = 0; j < G_size; ++j) {
+        fg[i][j] = 0.5 * (g.fg[i][j] + g.gf[j][i]);
+      }
+    }
+  }
+
+  //! Returns full GMatrix
+  [[nodiscard]] GMatrix unpack() const {
+    GMatrix g(size, m_include_G);
+    g.ff = ff.unpack();
+    if (m_include_G) {
+      g.gg = gg.unpack();
+      g.fg = fg;
+      g.gf = fg.transpose();
+    }
+    return g;
+  }
+
+  //! Matrix-vector product: {f, g} = G * {xf, xg}, i.e.,
+  //! f = ff*xf + fg*xg, g = gf*xf + gg*xg (g, xg only used if include_G).
+  //! Vectors must have 'size' elements; f,g are overwritten
+  void mult(const std::vector<double> &xf, const std::vector<double> &xg,
+            std::vector<double> *f, std::vector<double> *g) const {
+    ff.spmv(1.0, xf.data(), 0.0, f->data());
+    if (m_include_G) {
+      gg.spmv(1.0, xg.data(), 0.0, g->data());
+      // fg*xg -> f, and gf*xf = fg^T*xf -> g, in one (row-wise) pass
+      for (std::size_t i = 0; i < G_size; ++i) {
+        const auto *fg_i = fg[i];
+        double fi = 0.0;
+        for (std::size_t j = 0; j < G_size; ++j) {
+          fi += fg_i[j] * xg[j];
+          (*g)[j] += fg_i[j] * xf[i];
+        }
+        (*f)[i] += fi;
+      }
+    }
+  }
+};
+
 } // namespace MBPT
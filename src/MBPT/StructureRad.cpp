@@ -1,4 +1,5 @@
 #include "StructureRad.hpp"
+#include "Angular/Wigner369j.hpp"
 #include "Coulomb/CoulombIntegrals.hpp"
 #include "DiracOperator/TensorOperator.hpp"
 #include "ExternalField/TDHF.hpp"
@@ -35,6 +36,14 @@ StructureRad::StructureRad(const std::vector<DiracSpinor> &basis,
   mY.calculate(mCore);
   mY.calculate(mCore, mExcited);
   mY.calculate(mExcited);
+
+  const auto sixj_u = [](int k, int u, int ka, int kb, int kc, int kd) {
+    const auto sj =
+        Angular::sixj_2(Angular::twoj_k(ka), Angular::twoj_k(kb), 2 * k,
+                        Angular::twoj_k(kc), Angular::twoj_k(kd), 2 * u);
+    return Angular::neg1pow(u) * sj / (2 * u + 1);
+  };
+  mSixJu = Angular::RecouplingCache(DiracSpinor::max_tj(basis), sixj_u);
 }
 
 //******************************************************************************
@@ -249,6 +258,8 @@ double StructureRad::t2(const int k, const DiracSpinor &w, const DiracSpinor &r,
   double t = 0.0;
 
   const auto s = Angular::neg1pow_2(w.twoj() - c.twoj() + 2 * k);
+  // (-1)^u {w,v,k \ r,c,u} / [u], for each u
+  const auto &sj_u = mSixJu.get(w.k, v.k, r.k, c.k);
 
   for (const auto &a : mCore) {
     for (const auto &n : mExcited) {
@@ -261,21 +272,17 @@ double StructureRad::t2(const int k, const DiracSpinor &w, const DiracSpinor &r,
       const auto maxU = std::min(maxU1, maxU2);
       for (int u = minU; u <= maxU; ++u) {
 
-        const auto sj =
-            mY.SixJ().get(w.twoj(), v.twoj(), 2 * k, r.twoj(), c.twoj(), 2 * u);
-        if (Angular::zeroQ(sj))
+        const auto x = sj_u(k, u);
+        if (Angular::zeroQ(x))
           continue;
 
-        const auto su = Angular::neg1pow(u);
-        const auto f = (2 * u + 1);
-
         const auto wu1 = mY.Wk(u, w, a, c, n);
         if (Angular::zeroQ(wu1))
           continue;
 
         const auto wu2 = mY.Wk(u, v, a, r, n);
 
-        t += su * sj * wu1 * wu2 * inv_e_rnav / f;
+        t += x * wu1 * wu2 * inv_e_rnav;
       }
     }
   }
@@ -289,6 +296,8 @@ double StructureRad::t3(const int k, const DiracSpinor &w, const DiracSpinor &r,
   double t = 0.0;
 
   const auto s = Angular::neg1pow_2(w.twoj() - c.twoj() + 2 * k);
+  // (-1)^u {w,v,k \ r,c,u} / [u], for each u
+  const auto &sj_u = mSixJu.get(w.k, v.k, r.k, c.k);
 
   for (const auto &a : mCore) {
     for (const auto &n : mExcited) {
@@ -301,21 +310,17 @@ double StructureRad::t3(const int k, const DiracSpinor &w, const DiracSpinor &r,
       const auto maxU = std::min(maxU1, maxU2);
       for (int u = minU; u <= maxU; ++u) {
 
-        const auto sj =
-            mY.SixJ().get(w.twoj(), v.twoj(), 2 * k, r.twoj(), c.twoj(), 2 * u);
-        if (Angular::zeroQ(sj))
+        const auto x = sj_u(k, u);
+        if (Angular::zeroQ(x))
           continue;
 
-        const auto su = Angular::neg1pow(u);
-        const auto f = (2 * u + 1);
-
         const auto wu1 = mY.Wk(u, w, n, c, a);
         if (Angular::zeroQ(wu1))
           continue;
 
         const auto wu2 = mY.Wk(u, v, n, r, a);
 
-        t += su * sj * wu1 * wu2 * inv_e_nwac / f;
+        t += x * wu1 * wu2 * inv_e_nwac;
       }
     }
   }
@@ -375,6 +380,8 @@ double StructureRad::c1(const int k, const DiracSpinor &w, const DiracSpinor &a,
   double t = 0.0;
 
   const auto s = Angular::neg1pow_2(w.twoj() - c.twoj() + 2 * k);
+  // (-1)^u {w,v,k \ c,a,u} / [u], for each u
+  const auto &sj_u = mSixJu.get(w.k, v.k, c.k, a.k);
 
   for (const auto &b : mCore) {
     for (const auto &n : mExcited) {
@@ -389,12 +396,8 @@ double StructureRad::c1(const int k, const DiracSpinor &w, const DiracSpinor &a,
       const auto maxU = std::min(maxU1, maxU2);
       for (int u = minU; u <= maxU; ++u) {
 
-        const auto su = Angular::neg1pow(u);
-        const auto f = 2 * u + 1;
-
-        const auto sj =
-            mY.SixJ().get(w.twoj(), v.twoj(), 2 * k, c.twoj(), a.twoj(), 2 * u);
-        if (Angular::zeroQ(sj))
+        const auto x = sj_u(k, u);
+        if (Angular::zeroQ(x))
           continue;
 
         const auto wu1 = mY.Wk(u, w, n, a, b);
@@ -403,7 +406,7 @@ double StructureRad::c1(const int k, const DiracSpinor &w, const DiracSpinor &a,
 
         const auto wu2 = mY.Wk(u, v, n, c, b);
 
-        t += su * sj * wu1 * wu2 * invde / f;
+        t += x * wu1 * wu2 * invde;
       }
     }
   }
@@ -465,6 +468,8 @@ double StructureRad::d1(const int k, const DiracSpinor &w, const DiracSpinor &r,
   double t = 0.0;
 
   const auto s = Angular::neg1pow_2(w.twoj() - m.twoj() + 2 * k);
+  // (-1)^u {w,v,k \ m,r,u} / [u], for each u
+  const auto &sj_u = mSixJu.get(w.k, v.k, m.k, r.k);
 
   for (const auto &a : mCore) {
     for (const auto &n : mExcited) {
@@ -479,12 +484,8 @@ double StructureRad::d1(const int k, const DiracSpinor &w, const DiracSpinor &r,
       const auto maxU = std::min(maxU1, maxU2);
       for (int u = minU; u <= maxU; ++u) {
 
-        const auto su = Angular::neg1pow(u);
-        const auto f = 2 * u + 1;
-
-        const auto sj =
-            mY.SixJ().get(w.twoj(), v.twoj(), 2 * k, m.twoj(), r.twoj(), 2 * u);
-        if (Angular::zeroQ(sj))
+        const auto x = sj_u(k, u);
+        if (Angular::zeroQ(x))
           continue;
 
         const auto wu1 = mY.Wk(u, w, a, r, n);
@@ -493,7 +494,7 @@ double StructureRad::d1(const int k, const DiracSpinor &w, const DiracSpinor &r,
 
         const auto wu2 = mY.Wk(u, v, a, m, n);
 
-        t += su * sj * wu1 * wu2 * invde / f;
+        t += x * wu1 * wu2 * invde;
       }
     }
   }
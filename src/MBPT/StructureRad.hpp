@@ -1,4 +1,5 @@
 #pragma once
+#include "Angular/RecouplingCache.hpp"
 #include "Coulomb/Coulomb.hpp"
 #include "IO/FRW_fileReadWrite.hpp"
 #include "Wavefunction/DiracSpinor.hpp"
@@ -64,6 +65,8 @@ private:
   Coulomb::YkTable mY{};
   // nb: it seems conter-intuative, but this copy makes it FASTER!
   std::vector<DiracSpinor> mCore{}, mExcited{};
+  // (-1)^u {ja,jb,k \ jc,jd,u} / [u]: used in t2, t3, c1, d1. {k,u},{abcd}
+  Angular::RecouplingCache mSixJu{};
 
 public:
   //! Returns sum of Top+Bottom (SR) diagrams, reduced ME: <w||T+B||v>. Returns
@@ -2,17 +2,104 @@
 #include "IO/SafeProfiler.hpp"
 #include <algorithm>
 #include <array>
+#include <cassert>
 #include <cmath>
+#include <cstdlib>
 #include <gsl/gsl_eigen.h>
 #include <gsl/gsl_linalg.h>
 #include <gsl/gsl_math.h>
 #include <iostream>
+#include <limits>
 #include <tuple>
 #include <utility>
 #include <vector>
 
+#ifdef USELAPACK
+// LAPACK routines (Fortran interface). Only used if compiled with USELAPACK.
+// nb: LAPACK is column-major, while GSL (SqMatrix) is row-major. Complex
+// matrices are passed as interleaved {re, im} doubles (same layout as GSL).
+// Fortran CHARACTER arguments have a hidden length argument, passed by value
+// at the end of the argument list (gfortran ABI); these are always 1 here.
+extern "C" {
+void dgetrf_(const int *m, const int *n, double *a, const int *lda, int *ipiv,
+             int *info);
+void dgetri_(const int *n, double *a, const int *lda, const int *ipiv,
+             double *work, const int *lwork, int *info);
+void zgetrf_(const int *m, const int *n, double *a, const int *lda, int *ipiv,
+             int *info);
+void zgetri_(const int *n, double *a, const int *lda, const int *ipiv,
+             double *work, const int *lwork, int *info);
+void cgetrf_(const int *m, const int *n, float *a, const int *lda, int *ipiv,
+             int *info);
+void cgetrs_(const char *trans, const int *n, const int *nrhs, const float *a,
+             const int *lda, const int *ipiv, float *b, const int *ldb,
+             int *info, std::size_t trans_len);
+void dsyevd_(const char *jobz, const char *uplo, const int *n, double *a,
+             const int *lda, double *w, double *work, const int *lwork,
+             int *iwork, const int *liwork, int *info, std::size_t jobz_len,
+             std::size_t uplo_len);
+void dsygvd_(const int *itype, const char *jobz, const char *uplo,
+             const int *n, double *a, const int *lda, double *b,
+             const int *ldb, double *w, double *work, const int *lwork,
+             int *iwork, const int *liwork, int *info, std::size_t jobz_len,
+             std::size_t uplo_len);
+}
+#endif
+
 namespace LinAlg {
 
+#ifdef USELAPACK
+namespace {
+//! Prints error and aborts if LAPACK returned non-zero info (GSL's default
+//! error handler does the same)
+void check_lapack_info(int info, const char *routine) {
+  if (info != 0) {
+    std::cerr << "\nFAIL in LinAlg: " << routine << " returned info=" << info
+              << "\n";
+    std::abort();
+  }
+}
+
+// LU-inverts n*n matrix, in place, using xgetrf + xgetri. 'data' has leading
+// dimension lda, and 'width' doubles per element (1 for real, 2 for complex).
+// Since inv(A^T) = inv(A)^T, the row-major/column-major mismatch doesn't matter
+template <typename Getrf, typename Getri>
+void lapack_invert(std::size_t n, std::size_t lda, double *data,
+                   std::size_t width, Getrf getrf, Getri getri) {
+  const auto n_i = int(n);
+  const auto lda_i = int(lda);
+  std::vector<int> ipiv(n);
+  int info = 0;
+  getrf(&n_i, &n_i, data, &lda_i, ipiv.data(), &info);
+  check_lapack_info(info, "xgetrf");
+  // Query optimal workspace size (returned in work[0])
+  int lwork = -1;
+  std::vector<double> work(width);
+  getri(&n_i, data, &lda_i, ipiv.data(), work.data(), &lwork, &info);
+  lwork = std::max(int(work[0]), 1);
+  work.resize(std::size_t(lwork) * width);
+  getri(&n_i, data, &lda_i, ipiv.data(), work.data(), &lwork, &info);
+  check_lapack_info(info, "xgetri");
+}
+
+// Rows of evec are the (B-normalised) eigenvectors; normalise them to unit
+// magnitude, for consistency with GSL.
+void normalise_rows(SqMatrix *evec) {
+  for (auto i = 0ul; i < evec->n; ++i) {
+    auto *row = (*evec)[i];
+    double norm2 = 0.0;
+    for (auto j = 0ul; j < evec->n; ++j) {
+      norm2 += row[j] * row[j];
+    }
+    const auto inv_norm = 1.0 / std::sqrt(norm2);
+    for (auto j = 0ul; j < evec->n; ++j) {
+      row[j] *= inv_norm;
+    }
+  }
+}
+} // namespace
+#endif
+
 //******************************************************************************
 // class SqMatrix:
 //******************************************************************************
@@ -39,8 +126,22 @@ SqMatrix::SqMatrix(const SqMatrix &matrix) // copy constructor
 
 SqMatrix &SqMatrix::operator=(const SqMatrix &other) // copy assignment
 {
-  if (this != &other && other.n == this->n && this->n != 0)
+  if (this != &other && other.n == this->n && this->n != 0) {
+    if (m == nullptr) // if 'this' was moved from
+      m = gsl_matrix_alloc(n, n);
     gsl_matrix_memcpy(m, other.m);
+  }
+  return *this;
+}
+
+SqMatrix::SqMatrix(SqMatrix &&other) noexcept : n(other.n), m(other.m) {
+  other.m = nullptr;
+}
+
+SqMatrix &SqMatrix::operator=(SqMatrix &&other) noexcept {
+  // n is const, so can only swap buffers if same size
+  if (other.n == this->n)
+    std::swap(m, other.m);
   return *this;
 }
 
@@ -82,8 +183,14 @@ Vector SqMatrix::get_col(std::size_t j) const {
 }
 
 void SqMatrix::enforce_symmetric() {
-  *this += this->transpose();
-  (*this) *= 0.5;
+  // in place, no need for transpose copy
+  for (auto i = 0ul; i < n; ++i) {
+    for (auto j = i + 1; j < n; ++j) {
+      const auto avg = 0.5 * ((*this)[i][j] + (*this)[j][i]);
+      (*this)[i][j] = avg;
+      (*this)[j][i] = avg;
+    }
+  }
 }
 
 double SqMatrix::check_symmetric() const {
@@ -130,6 +237,11 @@ SqMatrix SqMatrix::transpose() const {
   return mTr;
 }
 
+SqMatrix &SqMatrix::transpose_in_place() {
+  gsl_matrix_transpose(m);
+  return *this;
+}
+
 double SqMatrix::determinant() const {
   // expensive for this to not be destructive
   gsl_matrix *mLU = gsl_matrix_alloc(n, n);
@@ -147,16 +259,22 @@ SqMatrix &SqMatrix::invert() {
   [[maybe_unused]] auto sp = IO::Profile::safeProfiler(__func__);
   // note: this is destuctive: matrix will be inverted
   // uses LU decomposition
+#ifdef USELAPACK
+  // LAPACK inverts in-place, no copy required
+  lapack_invert(n, m->tda, m->data, 1, dgetrf_, dgetri_);
+#else
   gsl_permutation *permutn = gsl_permutation_alloc(n);
   int sLU = 0;
   // gsl_linalg_LU_decomp(m, permutn, &sLU);
   // gsl_linalg_LU_invx(m, permutn);
   // In-place inversion gsl_linalg_LU_invx added sometime after GSL v:2.1
   // Getafix only has 2.1 installed, so can't use this for now
-  auto mLU = *this; // copy!
-  gsl_linalg_LU_decomp(mLU.m, permutn, &sLU);
-  gsl_linalg_LU_invert(mLU.m, permutn, m);
+  auto mLU = ScratchPool<SqMatrix>::get(n); // re-used workspace
+  gsl_matrix_memcpy(mLU->m, m);
+  gsl_linalg_LU_decomp(mLU->m, permutn, &sLU);
+  gsl_linalg_LU_invert(mLU->m, permutn, m);
   gsl_permutation_free(permutn);
+#endif
   return *this;
 }
 
@@ -178,7 +296,7 @@ SqMatrix operator*(const SqMatrix &lhs, const SqMatrix &rhs) {
   return product;
 }
 
-SqMatrix &SqMatrix::operator+=(const SqMatrix rhs) {
+SqMatrix &SqMatrix::operator+=(const SqMatrix &rhs) {
   gsl_matrix_add(this->m, rhs.m);
   return *this;
 }
@@ -186,7 +304,7 @@ SqMatrix operator+(SqMatrix lhs, const SqMatrix &rhs) {
   lhs += rhs;
   return lhs;
 }
-SqMatrix &SqMatrix::operator-=(const SqMatrix rhs) {
+SqMatrix &SqMatrix::operator-=(const SqMatrix &rhs) {
   gsl_matrix_sub(this->m, rhs.m);
   return *this;
 }
@@ -211,6 +329,82 @@ SqMatrix SqMatrix::mult_elements(SqMatrix lhs, const SqMatrix &rhs) {
   return lhs;
 }
 
+SqMatrix &SqMatrix::gemm(double alpha, const SqMatrix &a, const SqMatrix &b,
+                         double beta) {
+  [[maybe_unused]] auto sp = IO::Profile::safeProfiler(__func__);
+  gsl_blas_dgemm(CblasNoTrans, CblasNoTrans, alpha, a.m, b.m, beta, m);
+  return *this;
+}
+
+SqMatrix &SqMatrix::axpy(double x, const SqMatrix &b) {
+  // nb: all matrices allocated here are contiguous (tda = n)
+  const auto n2 = n * n;
+  for (auto i = 0ul; i < n2; ++i) {
+    m->data[i] += x * b.m->data[i];
+  }
+  return *this;
+}
+
+//******************************************************************************
+// class SymPackedMatrix
+//******************************************************************************
+SymPackedMatrix::SymPackedMatrix(const SqMatrix &a)
+    : m_n(a.n), m_data(a.n * (a.n + 1) / 2) {
+  for (auto i = 0ul; i < m_n; ++i) {
+    for (auto j = 0ul; j <= i; ++j) {
+      m_data[index(i, j)] = 0.5 * (a[i][j] + a[j][i]);
+    }
+  }
+}
+
+SqMatrix SymPackedMatrix::unpack() const {
+  SqMatrix a(m_n);
+  for (auto i = 0ul; i < m_n; ++i) {
+    for (auto j = 0ul; j <= i; ++j) {
+      a[i][j] = a[j][i] = m_data[index(i, j)];
+    }
+  }
+  return a;
+}
+
+void SymPackedMatrix::spmv(double alpha, const double *x, double beta,
+                           double *y) const {
+  [[maybe_unused]] auto sp = IO::Profile::safeProfiler(__func__);
+  if (beta != 1.0) {
+    for (auto i = 0ul; i < m_n; ++i) {
+      y[i] = beta == 0.0 ? 0.0 : beta * y[i];
+    }
+  }
+  // Each stored element is used twice: once for the lower triangle (row i,
+  // contiguous), once for the upper (column i): Mij*xj -> yi, Mij*xi -> yj
+  const double *row = m_data.data();
+  for (auto i = 0ul; i < m_n; ++i) {
+    const auto axi = alpha * x[i];
+    double yi = 0.0;
+    for (auto j = 0ul; j < i; ++j) {
+      yi += row[j] * x[j];
+      y[j] += row[j] * axi;
+    }
+    yi += row[i] * x[i]; // diagonal
+    y[i] += alpha * yi;
+    row += i + 1;
+  }
+}
+
+SymPackedMatrix &SymPackedMatrix::operator+=(const SymPackedMatrix &rhs) {
+  for (auto i = 0ul; i < m_data.size(); ++i) {
+    m_data[i] += rhs.m_data[i];
+  }
+  return *this;
+}
+
+SymPackedMatrix &SymPackedMatrix::operator*=(double x) {
+  for (auto &el : m_data) {
+    el *= x;
+  }
+  return *this;
+}
+
 //******************************************************************************
 //******************************************************************************
 // class Vector
@@ -233,12 +427,28 @@ Vector::Vector(const Vector &other) : n(other.n), vec(gsl_vector_alloc(n)) {
 Vector &Vector::operator=(const Vector &other) {
   // copy assignment
   // Check dimensions?
-  if (this != &other)
+  if (this != &other) {
+    if (vec == nullptr) // if 'this' was moved from
+      vec = gsl_vector_alloc(n);
     gsl_vector_memcpy(vec, other.vec);
+  }
   return *this;
 }
 
-Vector::~Vector() { gsl_vector_free(vec); }
+Vector::Vector(Vector &&other) noexcept : n(other.n), vec(other.vec) {
+  other.vec = nullptr;
+}
+
+Vector &Vector::operator=(Vector &&other) noexcept {
+  if (other.n == this->n)
+    std::swap(vec, other.vec);
+  return *this;
+}
+
+Vector::~Vector() {
+  if (vec != nullptr)
+    gsl_vector_free(vec);
+}
 
 //------------------------------------------------------------------------------
 void Vector::clip_low(const double value) {
@@ -265,7 +475,7 @@ void Vector::print() const {
 double &Vector::operator[](int i) const { return (vec->data[i]); }
 double &Vector::operator[](std::size_t i) const { return (vec->data[i]); }
 
-Vector &Vector::operator+=(const Vector rhs) {
+Vector &Vector::operator+=(const Vector &rhs) {
   gsl_vector_add(vec, rhs.vec);
   return *this;
 }
@@ -273,7 +483,7 @@ Vector operator+(Vector lhs, const Vector &rhs) {
   lhs += rhs;
   return lhs;
 }
-Vector &Vector::operator-=(const Vector rhs) {
+Vector &Vector::operator-=(const Vector &rhs) {
   gsl_vector_sub(vec, rhs.vec);
   return *this;
 }
@@ -348,8 +558,23 @@ ComplexSqMatrix::ComplexSqMatrix(const ComplexSqMatrix &other)
 }
 
 ComplexSqMatrix &ComplexSqMatrix::operator=(const ComplexSqMatrix &other) {
-  if (this != &other && other.n == this->n && this->n != 0)
+  if (this != &other && other.n == this->n && this->n != 0) {
+    if (m == nullptr) // if 'this' was moved from
+      m = gsl_matrix_complex_alloc(n, n);
     gsl_matrix_complex_memcpy(m, other.m);
+  }
+  return *this;
+}
+
+ComplexSqMatrix::ComplexSqMatrix(ComplexSqMatrix &&other) noexcept
+    : n(other.n), m(other.m) {
+  other.m = nullptr;
+}
+
+ComplexSqMatrix &ComplexSqMatrix::operator=(ComplexSqMatrix &&other) noexcept {
+  // n is const, so can only swap buffers if same size
+  if (other.n == this->n)
+    std::swap(m, other.m);
   return *this;
 }
 
@@ -376,21 +601,31 @@ ComplexSqMatrix ComplexSqMatrix::transpose() const {
   gsl_matrix_complex_transpose_memcpy(mTr.m, this->m);
   return mTr;
 }
+// Transposes the matrix in place (no allocation)
+ComplexSqMatrix &ComplexSqMatrix::transpose_in_place() {
+  gsl_matrix_complex_transpose(m);
+  return *this;
+}
 // Inverts the matrix: nb: destructive
 ComplexSqMatrix &ComplexSqMatrix::invert() {
   [[maybe_unused]] auto sp = IO::Profile::safeProfiler(__func__);
   // note: this is destuctive: matrix will be inverted
   // uses LU decomposition
+#ifdef USELAPACK
+  lapack_invert(n, m->tda, m->data, 2, zgetrf_, zgetri_);
+#else
   gsl_permutation *permutn = gsl_permutation_alloc(n);
   int sLU = 0;
   // gsl_linalg_complex_LU_decomp(m, permutn, &sLU);
   // gsl_linalg_complex_LU_invx(m, permutn);
   // In-place inversion gsl_linalg_LU_invx added sometime after GSL v:2.1
   // Getafix only has 2.1 installed, so can't use this for now
-  auto mLU = *this;
-  gsl_linalg_complex_LU_decomp(mLU.m, permutn, &sLU);
-  gsl_linalg_complex_LU_invert(mLU.m, permutn, m);
+  auto mLU = ScratchPool<ComplexSqMatrix>::get(n); // re-used workspace
+  gsl_matrix_complex_memcpy(mLU->m, m);
+  gsl_linalg_complex_LU_decomp(mLU->m, permutn, &sLU);
+  gsl_linalg_complex_LU_invert(mLU->m, permutn, m);
   gsl_permutation_free(permutn);
+#endif
   return *this;
 }
 // Returns the inverce of matrix: not destructive
@@ -524,6 +759,459 @@ ComplexSqMatrix operator-(ComplexSqMatrix lhs, const ComplexSqMatrix &rhs) {
   return lhs -= rhs;
 }
 
+// In-place (fused) multiply: M -> alpha*A*B + beta*M
+ComplexSqMatrix &ComplexSqMatrix::gemm(const ComplexDouble &alpha,
+                                       const ComplexSqMatrix &a,
+                                       const ComplexSqMatrix &b,
+                                       const ComplexDouble &beta) {
+  [[maybe_unused]] auto sp = IO::Profile::safeProfiler(__func__);
+  gsl_blas_zgemm(CblasNoTrans, CblasNoTrans, alpha.val, a.m, b.m, beta.val, m);
+  return *this;
+}
+
+// In-place: M -> M + x*B
+ComplexSqMatrix &ComplexSqMatrix::axpy(const ComplexDouble &x,
+                                       const ComplexSqMatrix &b) {
+  // nb: data is stored as {re, im} pairs; contiguous (tda = n)
+  const auto [xr, xi] = x.unpack();
+  const auto n2 = n * n;
+  for (auto i = 0ul; i < n2; ++i) {
+    const auto br = b.m->data[2 * i];
+    const auto bi = b.m->data[2 * i + 1];
+    m->data[2 * i] += xr * br - xi * bi;
+    m->data[2 * i + 1] += xr * bi + xi * br;
+  }
+  return *this;
+}
+ComplexSqMatrix &ComplexSqMatrix::axpy(double x, const ComplexSqMatrix &b) {
+  const auto n2 = 2 * n * n;
+  for (auto i = 0ul; i < n2; ++i) {
+    m->data[i] += x * b.m->data[i];
+  }
+  return *this;
+}
+
+//******************************************************************************
+// class ZSqMatrix:
+//******************************************************************************
+namespace {
+// Complex multiply, without the (C99 Annex G) inf/nan checks done by
+// std::complex operator* (unless compiled with -ffast-math or
+// -fcx-limited-range), which prevent vectorisation
+template <typename T>
+inline std::complex<T> cmul(const std::complex<T> &a,
+                            const std::complex<T> &b) {
+  return {a.real() * b.real() - a.imag() * b.imag(),
+          a.real() * b.imag() + a.imag() * b.real()};
+}
+
+// Largest |Re| or |Im| of any element (NaN if any element is NaN)
+double max_abs(const ZSqMatrix &a) {
+  double max = 0.0;
+  const auto *data = a.data();
+  for (auto i = 0ul; i < a.n() * a.n(); ++i) {
+    const auto x = std::max(std::abs(data[i].real()), std::abs(data[i].imag()));
+    if (!(x <= max)) // nb: true if x is NaN
+      max = x;
+  }
+  return max;
+}
+
+// Infinity norm, max_i sum_j |a_ij| (as LAPACK zlange 'I')
+double norm_inf(const ZSqMatrix &a) {
+  double norm = 0.0;
+  for (auto i = 0ul; i < a.n(); ++i) {
+    double row = 0.0;
+    for (auto j = 0ul; j < a.n(); ++j) {
+      row += std::abs(a(i, j));
+    }
+    if (!(row <= norm)) // nb: true if row is NaN
+      norm = row;
+  }
+  return norm;
+}
+
+// Infinity norm of each column, max_i |Re a_ij| + |Im a_ij| (as izamax)
+std::vector<double> col_norms_inf(const ZSqMatrix &a) {
+  std::vector<double> norms(a.n(), 0.0);
+  for (auto i = 0ul; i < a.n(); ++i) {
+    for (auto j = 0ul; j < a.n(); ++j) {
+      const auto x = std::abs(a(i, j).real()) + std::abs(a(i, j).imag());
+      if (!(x <= norms[j]))
+        norms[j] = x;
+    }
+  }
+  return norms;
+}
+
+// GSL views of ZSqMatrix data (same layout as gsl_matrix_complex). n != 0
+gsl_matrix_complex_view gsl_view(ZSqMatrix *a) {
+  return gsl_matrix_complex_view_array(reinterpret_cast<double *>(a->data()),
+                                       a->n(), a->n());
+}
+gsl_matrix_complex_const_view gsl_view(const ZSqMatrix &a) {
+  return gsl_matrix_complex_const_view_array(
+      reinterpret_cast<const double *>(a.data()), a.n(), a.n());
+}
+
+// Re-usable workspace for LU-inverting (many) n*n ZSqMatrix's. Not thread
+// safe: use one per thread
+class ZInverter {
+  std::size_t m_n;
+#ifdef USELAPACK
+  std::vector<int> m_ipiv;
+  std::vector<std::complex<double>> m_work{};
+#else
+  std::unique_ptr<gsl_permutation, decltype(&gsl_permutation_free)> m_perm;
+  ZSqMatrix m_LU;
+#endif
+
+public:
+#ifdef USELAPACK
+  explicit ZInverter(std::size_t n) : m_n(n), m_ipiv(n) {
+    // Query optimal zgetri workspace size (returned in work[0]); a is unused
+    const auto n_i = int(n);
+    const auto lda = std::max(n_i, 1);
+    int lwork = -1;
+    int info = 0;
+    std::complex<double> query{};
+    zgetri_(&n_i, reinterpret_cast<double *>(&query), &lda, m_ipiv.data(),
+            reinterpret_cast<double *>(&query), &lwork, &info);
+    m_work.resize(std::max(std::size_t(query.real()), std::size_t{1}));
+  }
+#else
+  explicit ZInverter(std::size_t n)
+      : m_n(n),
+        m_perm(n != 0 ? gsl_permutation_alloc(n) : nullptr,
+               &gsl_permutation_free),
+        m_LU(n) {}
+#endif
+
+  void invert(ZSqMatrix *a) {
+    assert(a->n() == m_n && "All matrices in invert_batch must be same size");
+    if (m_n == 0)
+      return;
+#ifdef USELAPACK
+    // nb: inv(A^T) = inv(A)^T, so row/column-major mismatch doesn't matter
+    const auto n_i = int(m_n);
+    const auto lwork = int(m_work.size());
+    auto *data = reinterpret_cast<double *>(a->data());
+    int info = 0;
+    zgetrf_(&n_i, &n_i, data, &n_i, m_ipiv.data(), &info);
+    check_lapack_info(info, "zgetrf");
+    zgetri_(&n_i, data, &n_i, m_ipiv.data(),
+            reinterpret_cast<double *>(m_work.data()), &lwork, &info);
+    check_lapack_info(info, "zgetri");
+#else
+    // In-place LU inversion not available in older GSL; LU stored in m_LU
+    m_LU = *a; // no allocation (same size)
+    auto LU = gsl_view(&m_LU);
+    auto inv = gsl_view(a);
+    int sLU = 0;
+    gsl_linalg_complex_LU_decomp(&LU.matrix, m_perm.get(), &sLU);
+    gsl_linalg_complex_LU_invert(&LU.matrix, m_perm.get(), &inv.matrix);
+#endif
+  }
+};
+
+// Single-precision (complex<float>) LU factorisation, for mixed-precision
+// solves. With LAPACK, stored column-major (cgetrf); otherwise row-major
+class LUFloat {
+  using cfloat = std::complex<float>;
+  std::size_t m_n;
+  std::vector<cfloat> m_lu;
+  std::vector<int> m_ipiv;
+  std::vector<cfloat> m_rhs{}; // work-space (for solve)
+
+public:
+  explicit LUFloat(std::size_t n) : m_n(n), m_lu(n * n), m_ipiv(n) {}
+
+  // Returns false if A can't be factorised in single precision (elements too
+  // large for float, or A is singular)
+  bool factorise(const ZSqMatrix &a) {
+    assert(a.n() == m_n);
+    if (!(max_abs(a) < double(std::numeric_limits<float>::max())))
+      return false;
+    for (auto i = 0ul; i < m_n; ++i) {
+      for (auto j = 0ul; j < m_n; ++j) {
+        m_lu[index(i, j)] = {float(a(i, j).real()), float(a(i, j).imag())};
+      }
+    }
+#ifdef USELAPACK
+    const auto n_i = int(m_n);
+    int info = 0;
+    cgetrf_(&n_i, &n_i, reinterpret_cast<float *>(m_lu.data()), &n_i,
+            m_ipiv.data(), &info);
+    return info == 0;
+#else
+    // Right-looking LU, with partial pivoting (rows). Row operations act on
+    // contiguous data, so inner loops vectorise
+    const auto abs1 = [](const cfloat &x) {
+      return std::abs(x.real()) + std::abs(x.imag());
+    };
+    for (auto k = 0ul; k < m_n; ++k) {
+      auto p = k;
+      for (auto i = k + 1; i < m_n; ++i) {
+        if (abs1(m_lu[i * m_n + k]) > abs1(m_lu[p * m_n + k]))
+          p = i;
+      }
+      if (abs1(m_lu[p * m_n + k]) == 0.0f)
+        return false;
+      m_ipiv[k] = int(p);
+      if (p != k) {
+        std::swap_ranges(&m_lu[k * m_n], &m_lu[k * m_n] + m_n, &m_lu[p * m_n]);
+      }
+      const auto *row_k = &m_lu[k * m_n];
+      const auto inv_pivot = 1.0f / row_k[k];
+      for (auto i = k + 1; i < m_n; ++i) {
+        auto *row_i = &m_lu[i * m_n];
+        const auto l = cmul(row_i[k], inv_pivot);
+        row_i[k] = l;
+        for (auto j = k + 1; j < m_n; ++j) {
+          row_i[j] -= cmul(l, row_k[j]);
+        }
+      }
+    }
+    return true;
+#endif
+  }
+
+  // x -> LU^{-1} * x, in single precision (x is n*n)
+  void solve(ZSqMatrix *x) {
+    assert(x->n() == m_n);
+    m_rhs.resize(m_n * m_n);
+    for (auto i = 0ul; i < m_n; ++i) {
+      for (auto j = 0ul; j < m_n; ++j) {
+        const auto z = (*x)(i, j);
+        m_rhs[index(i, j)] = {float(z.real()), float(z.imag())};
+      }
+    }
+#ifdef USELAPACK
+    const auto n_i = int(m_n);
+    int info = 0;
+    cgetrs_("N", &n_i, &n_i, reinterpret_cast<const float *>(m_lu.data()),
+            &n_i, m_ipiv.data(), reinterpret_cast<float *>(m_rhs.data()), &n_i,
+            &info, 1);
+    check_lapack_info(info, "cgetrs");
+#else
+    // Apply row permutations, then forward (L, unit diagonal) and back (U)
+    // substitution, one whole row of x at a time
+    for (auto k = 0ul; k < m_n; ++k) {
+      const auto p = std::size_t(m_ipiv[k]);
+      if (p != k) {
+        std::swap_ranges(&m_rhs[k * m_n], &m_rhs[k * m_n] + m_n,
+                         &m_rhs[p * m_n]);
+      }
+    }
+    for (auto i = 0ul; i < m_n; ++i) {
+      auto *row_i = &m_rhs[i * m_n];
+      for (auto k = 0ul; k < i; ++k) {
+        const auto l = m_lu[i * m_n + k];
+        const auto *row_k = &m_rhs[k * m_n];
+        for (auto j = 0ul; j < m_n; ++j) {
+          row_i[j] -= cmul(l, row_k[j]);
+        }
+      }
+    }
+    for (auto i = m_n; i-- > 0;) {
+      auto *row_i = &m_rhs[i * m_n];
+      for (auto k = i + 1; k < m_n; ++k) {
+        const auto u = m_lu[i * m_n + k];
+        const auto *row_k = &m_rhs[k * m_n];
+        for (auto j = 0ul; j < m_n; ++j) {
+          row_i[j] -= cmul(u, row_k[j]);
+        }
+      }
+      const auto inv_u = 1.0f / m_lu[i * m_n + i];
+      for (auto j = 0ul; j < m_n; ++j) {
+        row_i[j] = cmul(row_i[j], inv_u);
+      }
+    }
+#endif
+    for (auto i = 0ul; i < m_n; ++i) {
+      for (auto j = 0ul; j < m_n; ++j) {
+        const auto z = m_rhs[index(i, j)];
+        (*x)(i, j) = {double(z.real()), double(z.imag())};
+      }
+    }
+  }
+
+private:
+  std::size_t index(std::size_t i, std::size_t j) const {
+#ifdef USELAPACK
+    return j * m_n + i;
+#else
+    return i * m_n + j;
+#endif
+  }
+};
+} // namespace
+
+ZSqMatrix::ZSqMatrix(const ComplexSqMatrix &a) : m_n(a.n), m_data(a.n * a.n) {
+  // nb: gsl_matrix_complex may have tda != n
+  auto *out = reinterpret_cast<double *>(m_data.data());
+  for (auto i = 0ul; i < m_n; ++i) {
+    const auto *row = a.m->data + 2 * i * a.m->tda;
+    std::copy(row, row + 2 * m_n, out + 2 * i * m_n);
+  }
+}
+
+ComplexSqMatrix ZSqMatrix::to_ComplexSqMatrix() const {
+  ComplexSqMatrix a(m_n);
+  const auto *in = reinterpret_cast<const double *>(m_data.data());
+  for (auto i = 0ul; i < m_n; ++i) {
+    const auto *row = in + 2 * i * m_n;
+    std::copy(row, row + 2 * m_n, a.m->data + 2 * i * a.m->tda);
+  }
+  return a;
+}
+
+ZSqMatrix &ZSqMatrix::zero() {
+  std::fill(m_data.begin(), m_data.end(), value_type{0.0, 0.0});
+  return *this;
+}
+
+ZSqMatrix &ZSqMatrix::plusIdent(const value_type &x) {
+  for (auto i = 0ul; i < m_n; ++i) {
+    m_data[i * m_n + i] += x;
+  }
+  return *this;
+}
+
+ZSqMatrix &ZSqMatrix::mult_elements_by(const ZSqMatrix &b) {
+  assert(b.m_n == m_n);
+  for (auto i = 0ul; i < m_data.size(); ++i) {
+    m_data[i] = cmul(m_data[i], b.m_data[i]);
+  }
+  return *this;
+}
+
+ZSqMatrix &ZSqMatrix::invert() {
+  [[maybe_unused]] auto sp = IO::Profile::safeProfiler(__func__);
+  ZInverter(m_n).invert(this);
+  return *this;
+}
+
+ZSqMatrix ZSqMatrix::inverse() const {
+  auto inverse = *this;
+  inverse.invert();
+  return inverse;
+}
+
+ZSqMatrix &ZSqMatrix::operator+=(const ZSqMatrix &rhs) {
+  assert(rhs.m_n == m_n);
+  for (auto i = 0ul; i < m_data.size(); ++i) {
+    m_data[i] += rhs.m_data[i];
+  }
+  return *this;
+}
+
+ZSqMatrix &ZSqMatrix::operator-=(const ZSqMatrix &rhs) {
+  assert(rhs.m_n == m_n);
+  for (auto i = 0ul; i < m_data.size(); ++i) {
+    m_data[i] -= rhs.m_data[i];
+  }
+  return *this;
+}
+
+ZSqMatrix &ZSqMatrix::operator*=(const value_type &x) {
+  for (auto &el : m_data) {
+    el = cmul(el, x);
+  }
+  return *this;
+}
+
+ZSqMatrix operator*(const ZSqMatrix &a, const ZSqMatrix &b) {
+  ZSqMatrix result(a.n());
+  result.gemm(1.0, a, b, 0.0);
+  return result;
+}
+
+ZSqMatrix &ZSqMatrix::gemm(const value_type &alpha, const ZSqMatrix &a,
+                           const ZSqMatrix &b, const value_type &beta) {
+  [[maybe_unused]] auto sp = IO::Profile::safeProfiler(__func__);
+  assert(a.m_n == m_n && b.m_n == m_n);
+  if (m_n == 0)
+    return *this;
+  const auto A = gsl_view(a);
+  const auto B = gsl_view(b);
+  auto C = gsl_view(this);
+  gsl_blas_zgemm(CblasNoTrans, CblasNoTrans,
+                 gsl_complex_rect(alpha.real(), alpha.imag()), &A.matrix,
+                 &B.matrix, gsl_complex_rect(beta.real(), beta.imag()),
+                 &C.matrix);
+  return *this;
+}
+
+ZSqMatrix &ZSqMatrix::axpy(const value_type &x, const ZSqMatrix &b) {
+  assert(b.m_n == m_n);
+  for (auto i = 0ul; i < m_data.size(); ++i) {
+    m_data[i] += cmul(x, b.m_data[i]);
+  }
+  return *this;
+}
+
+//******************************************************************************
+void invert_batch(std::vector<ZSqMatrix> *matrices) {
+  [[maybe_unused]] auto sp = IO::Profile::safeProfiler(__func__);
+  if (matrices->empty())
+    return;
+  const auto n = matrices->front().n();
+#pragma omp parallel
+  {
+    // Workspace allocated once per thread, and re-used for each matrix
+    ZInverter inverter(n);
+#pragma omp for
+    for (auto i = 0ul; i < matrices->size(); ++i) {
+      inverter.invert(&(*matrices)[i]);
+    }
+  }
+}
+
+//******************************************************************************
+ZSqMatrix solve_mixed(const ZSqMatrix &a, const ZSqMatrix &b, int max_iter,
+                      MixedSolveInfo *info) {
+  [[maybe_unused]] auto sp = IO::Profile::safeProfiler(__func__);
+  assert(a.n() == b.n());
+  const auto n = a.n();
+  // Convergence, for each column j (as LAPACK zcgesv):
+  // |r_j|_inf <= |x_j|_inf * |A|_inf * eps * sqrt(n)
+  const auto cte = norm_inf(a) * std::numeric_limits<double>::epsilon() *
+                   std::sqrt(double(n));
+
+  LUFloat lu(n);
+  if (lu.factorise(a)) {
+    auto x = b;
+    lu.solve(&x);
+    ZSqMatrix r(n);
+    for (int it = 0;; ++it) {
+      // r = b - a*x
+      r = b;
+      r.gemm(-1.0, a, x, 1.0);
+      const auto rnrm = col_norms_inf(r);
+      const auto xnrm = col_norms_inf(x);
+      bool converged = true;
+      for (auto j = 0ul; j < n; ++j) {
+        converged &= rnrm[j] <= xnrm[j] * cte; // nb: false if NaN
+      }
+      if (converged) {
+        if (info)
+          *info = {it, false};
+        return x;
+      }
+      if (it >= max_iter)
+        break;
+      lu.solve(&r);
+      x += r;
+    }
+  }
+
+  // Ill-conditioned: double precision
+  if (info)
+    *info = {max_iter, true};
+  return a.inverse() * b;
+}
+
 //******************************************************************************
 //******************************************************************************
 // Solve LinAlg equations:
@@ -574,6 +1262,26 @@ std::pair<Vector, SqMatrix> realSymmetricEigensystem(SqMatrix *A, bool sort) {
   // eval and evec respectively. The computed eigenvectors are normalized to
   // have unit magnitude. On output, B contains its Cholesky decomposition and
   // A is destroyed.
+#ifdef USELAPACK
+  // LAPACK: divide-and-conquer (dsyevd). A is symmetric, so row/column-major
+  // doesn't matter. Eigenvectors are returned in columns of A (column-major),
+  // i.e., rows in row-major; already sorted (ascending).
+  (void)sort;
+  const auto n_i = int(n);
+  const auto lda = int(A->m->tda);
+  int info = 0, lwork = -1, liwork = -1, iwork_size = 0;
+  double work_size = 0.0;
+  dsyevd_("V", "U", &n_i, A->m->data, &lda, e_values.vec->data, &work_size,
+          &lwork, &iwork_size, &liwork, &info, 1, 1);
+  lwork = std::max(int(work_size), 1);
+  liwork = std::max(iwork_size, 1);
+  auto work = std::vector<double>(std::size_t(lwork));
+  auto iwork = std::vector<int>(std::size_t(liwork));
+  dsyevd_("V", "U", &n_i, A->m->data, &lda, e_values.vec->data, work.data(),
+          &lwork, iwork.data(), &liwork, &info, 1, 1);
+  check_lapack_info(info, "dsyevd");
+  gsl_matrix_memcpy(e_vectors.m, A->m);
+#else
   gsl_eigen_symmv_workspace *work = gsl_eigen_symmv_alloc(n);
   gsl_eigen_symmv(A->m, e_values.vec, e_vectors.m, work);
   gsl_eigen_symmv_free(work);
@@ -583,6 +1291,7 @@ std::pair<Vector, SqMatrix> realSymmetricEigensystem(SqMatrix *A, bool sort) {
 
   auto tmp = e_vectors.transpose();
   e_vectors = tmp;
+#endif
 
   return eigen_vv;
 }
@@ -605,6 +1314,30 @@ std::pair<Vector, SqMatrix> realSymmetricEigensystem(SqMatrix *A, SqMatrix *B,
   // eval and evec respectively. The computed eigenvectors are normalized to
   // have unit magnitude. On output, B contains its Cholesky decomposition and
   // A is destroyed.
+#ifdef USELAPACK
+  // LAPACK: divide-and-conquer (dsygvd), itype=1: Av = eBv. As above, but
+  // eigenvectors are normalised as v^T B v = 1, so re-normalise them.
+  (void)sort;
+  const auto n_i = int(n);
+  const auto lda = int(A->m->tda);
+  const auto ldb = int(B->m->tda);
+  const int itype = 1;
+  int info = 0, lwork = -1, liwork = -1, iwork_size = 0;
+  double work_size = 0.0;
+  dsygvd_(&itype, "V", "U", &n_i, A->m->data, &lda, B->m->data, &ldb,
+          e_values.vec->data, &work_size, &lwork, &iwork_size, &liwork, &info,
+          1, 1);
+  lwork = std::max(int(work_size), 1);
+  liwork = std::max(iwork_size, 1);
+  auto work = std::vector<double>(std::size_t(lwork));
+  auto iwork = std::vector<int>(std::size_t(liwork));
+  dsygvd_(&itype, "V", "U", &n_i, A->m->data, &lda, B->m->data, &ldb,
+          e_values.vec->data, work.data(), &lwork, iwork.data(), &liwork,
+          &info, 1, 1);
+  check_lapack_info(info, "dsygvd");
+  gsl_matrix_memcpy(e_vectors.m, A->m);
+  normalise_rows(&e_vectors);
+#else
   gsl_eigen_gensymmv_workspace *work = gsl_eigen_gensymmv_alloc(n);
   gsl_eigen_gensymmv(A->m, B->m, e_values.vec, e_vectors.m, work);
   gsl_eigen_gensymmv_free(work);
@@ -614,6 +1347,7 @@ std::pair<Vector, SqMatrix> realSymmetricEigensystem(SqMatrix *A, SqMatrix *B,
 
   auto tmp = e_vectors.transpose();
   e_vectors = tmp;
+#endif
 
   return eigen_vv;
 }
@@ -5,11 +5,18 @@
 #include <gsl/gsl_eigen.h>
 #include <gsl/gsl_linalg.h>
 #include <gsl/gsl_math.h>
+#include <complex>
+#include <iterator>
+#include <memory>
+#include <new>
 #include <tuple>
 #include <utility>
 #include <vector>
 
 //! Defines SqMatrix, Vector, and linear-algebra solvers (incl Eigensystems)
+//! @details Built on GSL. If compiled with USELAPACK defined (UseLAPACK=yes
+//! in Makefile), matrix inversion and the symmetric eigensolvers instead call
+//! LAPACK, and GSL's BLAS calls (e.g., dgemm) use the linked (optimised) BLAS.
 namespace LinAlg {
 
 class SqMatrix;
@@ -26,6 +33,10 @@ public:
   template <typename T> Vector(const std::initializer_list<T> &l);
   Vector &operator=(const Vector &other);
   Vector(const Vector &other);
+  //! Move: steals the gsl buffer (no allocation)
+  Vector(Vector &&other) noexcept;
+  //! Move: swaps gsl buffers if same size (otherwise, does nothing)
+  Vector &operator=(Vector &&other) noexcept;
   ~Vector();
 
   void clip_low(const double value);
@@ -34,9 +45,9 @@ public:
 
   double &operator[](int i) const;
   double &operator[](std::size_t i) const;
-  Vector &operator+=(const Vector rhs);
+  Vector &operator+=(const Vector &rhs);
   friend Vector operator+(Vector lhs, const Vector &rhs);
-  Vector &operator-=(const Vector rhs);
+  Vector &operator-=(const Vector &rhs);
   friend Vector operator-(Vector lhs, const Vector &rhs);
   Vector &operator*=(const double x);
   friend Vector operator*(const double x, Vector rhs);
@@ -62,6 +73,10 @@ public:
   ~SqMatrix();
   SqMatrix(const SqMatrix &matrix);
   SqMatrix &operator=(const SqMatrix &other);
+  //! Move: steals the gsl buffer (no allocation)
+  SqMatrix(SqMatrix &&other) noexcept;
+  //! Move: swaps gsl buffers if same size (otherwise, does nothing)
+  SqMatrix &operator=(SqMatrix &&other) noexcept;
 
 public:
   //! Constructs a diagonal unit matrix (identity)
@@ -100,6 +115,8 @@ public:
 
   //! Returns the transpose of matrix: not destructive
   [[nodiscard]] SqMatrix transpose() const;
+  //! Transposes the matrix in place (no allocation)
+  SqMatrix &transpose_in_place();
   //! Determinate via LU decomp. Note: expensive.
   [[nodiscard]] double determinant() const;
   //! Inverts the matrix: nb: destructive
@@ -109,15 +126,70 @@ public:
 
   double *operator[](std::size_t i) const;
   friend SqMatrix operator*(const SqMatrix &lhs, const SqMatrix &rhs);
-  SqMatrix &operator+=(const SqMatrix rhs);
+  SqMatrix &operator+=(const SqMatrix &rhs);
   friend SqMatrix operator+(SqMatrix lhs, const SqMatrix &rhs);
-  SqMatrix &operator-=(const SqMatrix rhs);
+  SqMatrix &operator-=(const SqMatrix &rhs);
   friend SqMatrix operator-(SqMatrix lhs, const SqMatrix &rhs);
   SqMatrix &operator*=(const double x);
   friend SqMatrix operator*(const double x, SqMatrix rhs);
 
   void mult_elements_by(const SqMatrix &rhs);
   static SqMatrix mult_elements(SqMatrix lhs, const SqMatrix &rhs);
+
+  //! In-place (fused) multiply: M -> alpha*A*B + beta*M. No allocation.
+  //! nb: A and B must not be this matrix
+  SqMatrix &gemm(double alpha, const SqMatrix &a, const SqMatrix &b,
+                 double beta);
+  //! In-place: M -> M + x*B. No allocation
+  SqMatrix &axpy(double x, const SqMatrix &b);
+};
+
+//******************************************************************************
+/*!
+@brief Real symmetric matrix, in packed storage: only the n(n+1)/2 elements of
+the lower triangle are stored.
+@details Stored row-major: M_ij = M_ji = data[i(i+1)/2 + j], for j <= i (this
+is the same layout as LAPACK's column-major 'U' packed format). Half the
+memory (and memory traffic) of a full SqMatrix.
+*/
+class SymPackedMatrix {
+  std::size_t m_n{0};
+  std::vector<double> m_data{};
+
+public:
+  SymPackedMatrix() {}
+  //! n*n zero matrix
+  explicit SymPackedMatrix(std::size_t n) : m_n(n), m_data(n * (n + 1) / 2) {}
+  //! Packs the symmetric part of a: M_ij = (A_ij + A_ji)/2
+  explicit SymPackedMatrix(const SqMatrix &a);
+
+  //! Dimension (matrix is n*n)
+  std::size_t n() const { return m_n; }
+  //! M_ij (i and j in any order)
+  double operator()(std::size_t i, std::size_t j) const {
+    return m_data[index(i, j)];
+  }
+  //! M_ij = M_ji (i and j in any order)
+  double &operator()(std::size_t i, std::size_t j) {
+    return m_data[index(i, j)];
+  }
+  //! Packed data (see class description for layout)
+  const std::vector<double> &data() const { return m_data; }
+  std::vector<double> &data() { return m_data; }
+
+  //! Returns full (square) matrix
+  [[nodiscard]] SqMatrix unpack() const;
+
+  //! y -> alpha*M*x + beta*y; x and y must have n elements (like BLAS dspmv)
+  void spmv(double alpha, const double *x, double beta, double *y) const;
+
+  SymPackedMatrix &operator+=(const SymPackedMatrix &rhs);
+  SymPackedMatrix &operator*=(double x);
+
+private:
+  static std::size_t index(std::size_t i, std::size_t j) {
+    return i >= j ? i * (i + 1) / 2 + j : j * (j + 1) / 2 + i;
+  }
 };
 
 //******************************************************************************
@@ -248,6 +320,10 @@ public:
   ~ComplexSqMatrix();
   ComplexSqMatrix(const ComplexSqMatrix &other);
   ComplexSqMatrix &operator=(const ComplexSqMatrix &other);
+  //! Move: steals the gsl buffer (no allocation)
+  ComplexSqMatrix(ComplexSqMatrix &&other) noexcept;
+  //! Move: swaps gsl buffers if same size (otherwise, does nothing)
+  ComplexSqMatrix &operator=(ComplexSqMatrix &&other) noexcept;
 
 public:
   //! Constructs a diagonal unit matrix
@@ -257,6 +333,8 @@ public:
 
   //! Returns the transpose of matrix: not destructive
   [[nodiscard]] ComplexSqMatrix transpose() const;
+  //! Transposes the matrix in place (no allocation)
+  ComplexSqMatrix &transpose_in_place();
   //! Inverts the matrix: nb: destructive
   ComplexSqMatrix &invert();
   //! Returns the inverce of matrix: not destructive
@@ -316,6 +394,230 @@ public:
                                    const ComplexSqMatrix &rhs);
   friend ComplexSqMatrix operator-(ComplexSqMatrix lhs,
                                    const ComplexSqMatrix &rhs);
+
+  //! In-place (fused) multiply: M -> alpha*A*B + beta*M. No allocation.
+  //! nb: A and B must not be this matrix
+  ComplexSqMatrix &gemm(const ComplexDouble &alpha, const ComplexSqMatrix &a,
+                        const ComplexSqMatrix &b, const ComplexDouble &beta);
+  //! In-place: M -> M + x*B. No allocation
+  ComplexSqMatrix &axpy(const ComplexDouble &x, const ComplexSqMatrix &b);
+  //! In-place: M -> M + x*B, for real x. No allocation
+  ComplexSqMatrix &axpy(double x, const ComplexSqMatrix &b);
+};
+
+//******************************************************************************
+//! Minimal allocator for over-aligned storage (default: 64 bytes, i.e., one
+//! cache line, and enough for any SIMD width), for use with std::vector
+template <typename T, std::size_t Alignment = 64> struct AlignedAllocator {
+  using value_type = T;
+  template <typename U> struct rebind {
+    using other = AlignedAllocator<U, Alignment>;
+  };
+  AlignedAllocator() = default;
+  template <typename U>
+  AlignedAllocator(const AlignedAllocator<U, Alignment> &) {}
+
+  [[nodiscard]] T *allocate(std::size_t n) {
+    return static_cast<T *>(
+        ::operator new(n * sizeof(T), std::align_val_t(Alignment)));
+  }
+  void deallocate(T *p, std::size_t) noexcept {
+    ::operator delete(p, std::align_val_t(Alignment));
+  }
+
+  friend bool operator==(const AlignedAllocator &, const AlignedAllocator &) {
+    return true;
+  }
+  friend bool operator!=(const AlignedAllocator &, const AlignedAllocator &) {
+    return false;
+  }
+};
+
+//******************************************************************************
+/*!
+@brief
+Square matrix of std::complex<double>: contiguous, row-major, 64-byte aligned.
+@details
+Unlike ComplexSqMatrix (which wraps gsl_matrix_complex, with element access via
+gsl_complex), elements are plain std::complex<double>, so element-wise
+operations are simple loops that the compiler can vectorise. The memory layout
+({re, im} pairs, row-major) is the same as gsl_matrix_complex, so GSL (BLAS,
+LU) routines act on it directly through views; no copies. Convert to/from
+ComplexSqMatrix using the constructor and to_ComplexSqMatrix().
+
+For inverting many equal-size matrices (e.g., G(w) on a frequency grid), use
+invert_batch(), which shares the LU workspace between matrices.
+Copyable and movable (unlike ComplexSqMatrix, size is not fixed on assignment).
+*/
+class ZSqMatrix {
+public:
+  using value_type = std::complex<double>;
+
+private:
+  std::size_t m_n{0};
+  std::vector<value_type, AlignedAllocator<value_type>> m_data{};
+
+public:
+  ZSqMatrix() {}
+  //! n*n zero matrix
+  explicit ZSqMatrix(std::size_t n) : m_n(n), m_data(n * n) {}
+  //! Copy of gsl-based complex matrix
+  explicit ZSqMatrix(const ComplexSqMatrix &a);
+  //! Returns (copy) as a gsl-based complex matrix
+  [[nodiscard]] ComplexSqMatrix to_ComplexSqMatrix() const;
+
+  //! Dimension (matrix is n*n)
+  std::size_t n() const { return m_n; }
+  //! Pointer to start of row i, so that M[i][j] = M_ij
+  value_type *operator[](std::size_t i) { return m_data.data() + i * m_n; }
+  const value_type *operator[](std::size_t i) const {
+    return m_data.data() + i * m_n;
+  }
+  value_type &operator()(std::size_t i, std::size_t j) {
+    return m_data[i * m_n + j];
+  }
+  value_type operator()(std::size_t i, std::size_t j) const {
+    return m_data[i * m_n + j];
+  }
+  //! Contiguous (row-major) data; n*n elements
+  value_type *data() { return m_data.data(); }
+  const value_type *data() const { return m_data.data(); }
+
+  //! Sets all elements to zero
+  ZSqMatrix &zero();
+  //! M -> M + x*I [adds x to diagonal elements]
+  ZSqMatrix &plusIdent(const value_type &x = 1.0);
+  //! Multiply elements in place: Aij -> Aij*Bij
+  ZSqMatrix &mult_elements_by(const ZSqMatrix &b);
+
+  //! Inverts the matrix (LU decomposition): nb: destructive
+  ZSqMatrix &invert();
+  //! Returns the inverse of matrix: not destructive
+  [[nodiscard]] ZSqMatrix inverse() const;
+
+  ZSqMatrix &operator+=(const ZSqMatrix &rhs);
+  ZSqMatrix &operator-=(const ZSqMatrix &rhs);
+  ZSqMatrix &operator*=(const value_type &x);
+  friend ZSqMatrix operator+(ZSqMatrix lhs, const ZSqMatrix &rhs) {
+    return lhs += rhs;
+  }
+  friend ZSqMatrix operator-(ZSqMatrix lhs, const ZSqMatrix &rhs) {
+    return lhs -= rhs;
+  }
+  friend ZSqMatrix operator*(const value_type &x, ZSqMatrix rhs) {
+    return rhs *= x;
+  }
+  //! Matrix multiplication
+  friend ZSqMatrix operator*(const ZSqMatrix &a, const ZSqMatrix &b);
+
+  //! In-place (fused) multiply: M -> alpha*A*B + beta*M. No allocation.
+  //! nb: A and B must not be this matrix
+  ZSqMatrix &gemm(const value_type &alpha, const ZSqMatrix &a,
+                  const ZSqMatrix &b, const value_type &beta);
+  //! In-place: M -> M + x*B. No allocation
+  ZSqMatrix &axpy(const value_type &x, const ZSqMatrix &b);
+};
+
+//! Inverts (in place) each matrix in the list; all must be the same size.
+//! @details Equivalent to calling invert() on each, but the LU workspace is
+//! allocated once per thread (rather than once per matrix), and the list is
+//! split between OpenMP threads (when not already inside a parallel region).
+void invert_batch(std::vector<ZSqMatrix> *matrices);
+
+//! Diagnostics from solve_mixed()
+struct MixedSolveInfo {
+  //! Number of refinement steps taken
+  int iterations{0};
+  //! True if refinement failed, and double-precision solve was used instead
+  bool fallback{false};
+};
+
+/*!
+@brief Solves A*X = B for X (all n*n), in mixed precision
+@details
+A is LU-factorised in single precision (std::complex<float>): half the memory
+traffic, and twice the SIMD width, of double precision. The solution is then
+iteratively refined in double precision:
+  R = B - A*X;  X -> X + LU^{-1}*R,
+until the residual is at the double-precision level (as in LAPACK's zcgesv):
+|R_j|_inf <= |X_j|_inf * |A|_inf * eps * sqrt(n), for each column j. Each
+step gains ~7 digits for a well-conditioned A. If not converged after max_iter
+steps (ill-conditioned A, roughly cond(A) > 10^7), or A can't be factorised in
+single precision, falls back to a double-precision solve. Result agrees with
+A.inverse()*B to within the double-precision error.
+  - Each refinement step forms the residual with a full double-precision
+    product (n^3), so any speed-up over the double-precision solve depends on
+    the platform/BLAS; it has not been measured. Not used by default.
+*/
+[[nodiscard]] ZSqMatrix solve_mixed(const ZSqMatrix &a, const ZSqMatrix &b,
+                                    int max_iter = 10,
+                                    MixedSolveInfo *info = nullptr);
+
+//******************************************************************************
+/*!
+@brief Thread-local pool of scratch (work-space) matrices, to avoid repeated
+allocation of temporaries inside hot loops.
+@details
+get(n) returns a Handle to an n*n Matrix, re-using one previously returned to
+the calling thread's pool if possible (otherwise, allocates a new one). When
+the Handle is destroyed, the matrix goes back to the pool. Contents on get()
+are unspecified (whatever was left there last). Each thread has its own pool,
+so no locking is required; Handles must be destroyed by the same thread.
+Matrix is SqMatrix or ComplexSqMatrix. Usage:
+  auto tmp = ScratchPool<SqMatrix>::get(n);
+  tmp->gemm(1.0, a, b, 0.0); // tmp = a*b
+*/
+template <typename Matrix> class ScratchPool {
+  // Maximum number of (unused) matrices kept per thread
+  static constexpr std::size_t max_pool_size = 16;
+
+public:
+  //! Owns a scratch matrix; returns it to the pool on destruction
+  class Handle {
+    std::unique_ptr<Matrix> m_mat;
+
+  public:
+    explicit Handle(std::unique_ptr<Matrix> mat) : m_mat(std::move(mat)) {}
+    Handle(Handle &&) = default;
+    Handle &operator=(Handle &&) = delete;
+    Handle(const Handle &) = delete;
+    Handle &operator=(const Handle &) = delete;
+    ~Handle() {
+      if (m_mat)
+        release(std::move(m_mat));
+    }
+    Matrix &operator*() const { return *m_mat; }
+    Matrix *operator->() const { return m_mat.get(); }
+  };
+
+  //! Returns an n*n scratch matrix (contents unspecified)
+  [[nodiscard]] static Handle get(std::size_t n) {
+    auto &free_list = pool();
+    // most recently used first
+    for (auto it = free_list.rbegin(); it != free_list.rend(); ++it) {
+      if ((*it)->n == n) {
+        auto mat = std::move(*it);
+        free_list.erase(std::next(it).base());
+        return Handle{std::move(mat)};
+      }
+    }
+    return Handle{std::make_unique<Matrix>(n)};
+  }
+
+  //! Number of (unused) matrices currently stored in this thread's pool
+  static std::size_t size() { return pool().size(); }
+
+private:
+  static std::vector<std::unique_ptr<Matrix>> &pool() {
+    static thread_local std::vector<std::unique_ptr<Matrix>> s_pool;
+    return s_pool;
+  }
+  static void release(std::unique_ptr<Matrix> mat) {
+    auto &free_list = pool();
+    if (free_list.size() >= max_pool_size)
+      free_list.erase(free_list.begin());
+    free_list.push_back(std::move(mat));
+  }
 };
 
 //******************************************************************************
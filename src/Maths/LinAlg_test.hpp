@@ -1,9 +1,11 @@
 #pragma once
+#include "MBPT/GreenMatrix.hpp"
 #include "Maths/LinAlg_MatrixVector.hpp"
 #include "qip/Check.hpp"
 #include "qip/Maths.hpp"
 #include "qip/Vector.hpp"
 #include <algorithm>
+#include <cmath>
 #include <random>
 #include <string>
 
@@ -198,6 +200,133 @@ bool LinAlg(std::ostream &obuff) {
     const auto worst =
         *std::max_element(cbegin(each), cend(each), qip::comp_abs);
     pass &= qip::check_value(&obuff, "Eigen(RS) Av = eBv", worst, 0.0, 1.0e-12);
+
+    // e-vectors have unit magnitude, e-values sorted (same for GSL/LAPACK)
+    double worst_norm = 0.0;
+    bool sorted = true;
+    for (std::size_t i = 0; i < evals.n; ++i) {
+      const auto v = evecs.get_row(i);
+      worst_norm = std::max(worst_norm, std::abs(v * v - 1.0));
+      if (i > 0 && evals[i] < evals[i - 1])
+        sorted = false;
+    }
+    pass &= qip::check_value(&obuff, "Eigen(RS) Av = eBv |v|=1", worst_norm,
+                             0.0, 1.0e-14);
+    pass &= qip::check(&obuff, "Eigen(RS) Av = eBv sorted", sorted, true);
+  }
+
+  { // In-place (fused) operations, move, and scratch pool
+    LinAlg::SqMatrix a(40), b(40), c(40);
+    std::mt19937 gen(0.0); // seeded w/ constant; same each run
+    std::uniform_real_distribution<> dis(-1.0, 1.0);
+    for (auto *mat : {&a, &b, &c}) {
+      for (std::size_t i = 0; i < mat->n; ++i) {
+        for (std::size_t j = 0; j < mat->n; ++j) {
+          (*mat)[i][j] = dis(gen);
+        }
+      }
+    }
+    // c -> 2ab - 0.5c,  and c -> c + 3a
+    const auto expected = 2.0 * (a * b) - 0.5 * c + 3.0 * a;
+    c.gemm(2.0, a, b, -0.5).axpy(3.0, a);
+    pass &= qip::check_value(&obuff, "gemm + axpy",
+                             helper::max_matrixel(c - expected), 0.0, 1.0e-14);
+
+    // Move steals buffer; move-assign swaps them
+    const auto *data = c.m->data;
+    auto d = std::move(c);
+    a = std::move(d);
+    const bool moved_ok = a.m->data == data && c.m == nullptr;
+    pass &= qip::check(&obuff, "SqMatrix move", moved_ok, true);
+
+    // Scratch pool: returned matrices are re-used
+    const double *scratch_data = nullptr;
+    {
+      auto tmp = LinAlg::ScratchPool<LinAlg::SqMatrix>::get(40);
+      scratch_data = tmp->m->data;
+    }
+    auto tmp2 = LinAlg::ScratchPool<LinAlg::SqMatrix>::get(40);
+    auto tmp3 = LinAlg::ScratchPool<LinAlg::SqMatrix>::get(40);
+    const bool pool_ok =
+        tmp2->m->data == scratch_data && tmp3->m->data != scratch_data;
+    pass &= qip::check(&obuff, "ScratchPool", pool_ok, true);
+  }
+
+  { // Packed symmetric matrix: pack/unpack, and M*x
+    const std::size_t n = 37;
+    LinAlg::SqMatrix a(n);
+    LinAlg::Vector x(n), y(n);
+    std::mt19937 gen(0.0); // seeded w/ constant; same each run
+    std::uniform_real_distribution<> dis(-1.0, 1.0);
+    for (std::size_t i = 0; i < n; ++i) {
+      x[i] = dis(gen);
+      y[i] = dis(gen);
+      for (std::size_t j = 0; j < n; ++j) {
+        a[i][j] = dis(gen);
+      }
+    }
+    const LinAlg::SymPackedMatrix p(a);
+    auto sym = a + a.transpose();
+    sym *= 0.5;
+    pass &= qip::check_value(&obuff, "SymPacked unpack",
+                             helper::max_matrixel(p.unpack() - sym), 0.0, 0.0);
+
+    // y -> 2*M*x - 0.5*y
+    const auto expected = 2.0 * (sym * x) - 0.5 * y;
+    p.spmv(2.0, x.vec->data, -0.5, y.vec->data);
+    pass &= qip::check_value(&obuff, "SymPacked spmv",
+                             helper::max_vecel(y - expected), 0.0, 1.0e-14);
+  }
+
+  { // Packed Green matrix (Sigma storage), with G: compare to full GMatrix
+    const std::size_t n = 29;
+    MBPT::GMatrix g(n, true);
+    std::vector<double> xf(n), xg(n);
+    std::mt19937 gen(1.0); // seeded w/ constant; same each run
+    std::uniform_real_distribution<> dis(-1.0, 1.0);
+    for (std::size_t i = 0; i < n; ++i) {
+      xf[i] = dis(gen);
+      xg[i] = dis(gen);
+      for (std::size_t j = 0; j < n; ++j) {
+        g.ff[i][j] = dis(gen);
+        g.fg[i][j] = dis(gen);
+        g.gf[i][j] = dis(gen);
+        g.gg[i][j] = dis(gen);
+      }
+    }
+    // Packing symmetrises: ff -> (ff + ff^T)/2, fg -> (fg + gf^T)/2, gf = fg^T
+    MBPT::GMatrix sym(n, true);
+    for (std::size_t i = 0; i < n; ++i) {
+      for (std::size_t j = 0; j < n; ++j) {
+        sym.ff[i][j] = 0.5 * (g.ff[i][j] + g.ff[j][i]);
+        sym.gg[i][j] = 0.5 * (g.gg[i][j] + g.gg[j][i]);
+        sym.fg[i][j] = 0.5 * (g.fg[i][j] + g.gf[j][i]);
+        sym.gf[j][i] = sym.fg[i][j];
+      }
+    }
+    const MBPT::PackedGMatrix p(g);
+    const auto u = p.unpack();
+    const auto del_unpack = std::max(
+        {helper::max_matrixel(u.ff - sym.ff), helper::max_matrixel(u.fg - sym.fg),
+         helper::max_matrixel(u.gf - sym.gf),
+         helper::max_matrixel(u.gg - sym.gg)});
+    pass &= qip::check_value(&obuff, "PackedGMatrix unpack", del_unpack, 0.0,
+                             0.0);
+
+    // {f, g} = {ff*xf + fg*xg, gf*xf + gg*xg}
+    std::vector<double> f(n), gv(n);
+    p.mult(xf, xg, &f, &gv);
+    double del_mult = 0.0;
+    for (std::size_t i = 0; i < n; ++i) {
+      double ef = 0.0, eg = 0.0;
+      for (std::size_t j = 0; j < n; ++j) {
+        ef += sym.ff[i][j] * xf[j] + sym.fg[i][j] * xg[j];
+        eg += sym.gf[i][j] * xf[j] + sym.gg[i][j] * xg[j];
+      }
+      del_mult = std::max({del_mult, std::abs(f[i] - ef), std::abs(gv[i] - eg)});
+    }
+    pass &= qip::check_value(&obuff, "PackedGMatrix mult (incl. G)", del_mult,
+                             0.0, 1.0e-14);
   }
 
   //****************************************************************************
@@ -285,6 +414,15 @@ bool LinAlg(std::ostream &obuff) {
         qip::check_value(&obuff, "Complex Scalar mult",
                          std::max(std::abs(re2), std::abs(im2)), 0.0, 1.0e-16);
 
+    // In-place: m7 = x*m1*m2 + x*m3 + m4 (check relative to m1*m2 ~ 10^12)
+    auto m7 = m3;
+    m7.gemm(x, m1, m2, x).axpy(1.0, m4);
+    const auto [re_g, im_g] =
+        helper::max_matrixel(m7 - x * (m1 * m2) - x * m3 - m4);
+    pass &= qip::check_value(&obuff, "Complex gemm + axpy",
+                             std::max(std::abs(re_g), std::abs(im_g)) / 1.0e12,
+                             0.0, 1.0e-14);
+
     const auto m1r = m1.real();
     const auto m1i = m1.imaginary();
     const auto m1C = LinAlg::ComplexSqMatrix::make_complex({1.0, 0.0}, m1r) +
@@ -295,6 +433,92 @@ bool LinAlg(std::ostream &obuff) {
                          std::max(std::abs(re3), std::abs(im3)), 0.0, 1.0e-16);
   }
 
+  { // Contiguous std::complex matrix (ZSqMatrix), incl. batched inversion
+    const std::size_t n = 30;
+    std::mt19937 gen(0.0); // seeded w/ constant; same each run
+    std::uniform_real_distribution<> dis(-0.1, 0.1);
+    std::vector<LinAlg::ComplexSqMatrix> ms;
+    for (int k = 0; k < 5; ++k) {
+      auto &m = ms.emplace_back(n);
+      for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t j = 0; j < n; ++j) {
+          m[i][j] = LinAlg::ComplexDouble{dis(gen), dis(gen)}.val;
+        }
+      }
+      m.plusIdent(1.0, 0.5 * k); // "ensure" invertable
+    }
+
+    // Conversion, and arithmetic, vs. ComplexSqMatrix
+    const std::complex<double> x{3.1415926, 2.71828};
+    const LinAlg::ComplexDouble xc{x.real(), x.imag()};
+    const LinAlg::ZSqMatrix z0(ms[0]), z1(ms[1]), z2(ms[2]);
+    auto z = z2;
+    z.gemm(x, z0, z1, x).axpy(x, z0).mult_elements_by(z1);
+    z.plusIdent(x);
+    auto m = ms[2];
+    m.gemm(xc, ms[0], ms[1], xc).axpy(xc, ms[0]);
+    m.mult_elements_by(ms[1]);
+    m.plusIdent(x.real(), x.imag());
+    const auto [re, im] = helper::max_matrixel(z.to_ComplexSqMatrix() - m);
+    pass &= qip::check_value(&obuff, "ZSqMatrix vs ComplexSqMatrix",
+                             std::max(std::abs(re), std::abs(im)), 0.0,
+                             1.0e-14);
+
+    // Batched inversion: identical to one-by-one, and M^-1 * M = 1
+    std::vector<LinAlg::ZSqMatrix> zs(ms.cbegin(), ms.cend());
+    LinAlg::invert_batch(&zs);
+    double worst_batch = 0.0;
+    double worst_inv = 0.0;
+    for (std::size_t k = 0; k < ms.size(); ++k) {
+      const LinAlg::ZSqMatrix zk(ms[k]);
+      auto ident = zk.inverse() * zk;
+      ident.plusIdent(-1.0);
+      const auto diff = zk.inverse() - zs[k];
+      for (std::size_t i = 0; i < n * n; ++i) {
+        worst_inv = std::max(worst_inv, std::abs(ident.data()[i]));
+        worst_batch = std::max(worst_batch, std::abs(diff.data()[i]));
+      }
+    }
+    pass &= qip::check_value(&obuff, "ZSqMatrix inverse", worst_inv, 0.0,
+                             1.0e-14);
+    pass &= qip::check_value(&obuff, "ZSqMatrix batch inverse", worst_batch,
+                             0.0, 0.0);
+
+    // Mixed-precision solve: A*X = B, vs. double-precision solution
+    double worst_mixed = 0.0;
+    int worst_iter = 0;
+    for (auto k = 0ul; k + 1 < ms.size(); ++k) {
+      const LinAlg::ZSqMatrix a(ms[k]), b(ms[k + 1]);
+      LinAlg::MixedSolveInfo info;
+      const auto xm = LinAlg::solve_mixed(a, b, 10, &info);
+      const auto [re_m, im_m] =
+          helper::max_matrixel((xm - a.inverse() * b).to_ComplexSqMatrix());
+      worst_mixed = std::max({worst_mixed, std::abs(re_m), std::abs(im_m)});
+      worst_iter = std::max(worst_iter, info.fallback ? 99 : info.iterations);
+    }
+    pass &= qip::check_value(&obuff, "ZSqMatrix mixed solve", worst_mixed, 0.0,
+                             1.0e-14);
+    pass &= qip::check_value(&obuff, "ZSqMatrix mixed iterations", worst_iter,
+                             0, 3);
+
+    // Ill-conditioned (two rows almost equal): must fall back to double
+    LinAlg::ZSqMatrix a_ill(ms[0]);
+    for (std::size_t j = 0; j < n; ++j) {
+      a_ill(1, j) = a_ill(0, j);
+    }
+    a_ill(1, 1) += 1.0e-11;
+    const LinAlg::ZSqMatrix b_ill(ms[1]);
+    LinAlg::MixedSolveInfo info_ill;
+    const auto x_ill = LinAlg::solve_mixed(a_ill, b_ill, 10, &info_ill);
+    const auto [re_r, im_r] = helper::max_matrixel(
+        (a_ill * x_ill - b_ill).to_ComplexSqMatrix());
+    pass &= qip::check(&obuff, "ZSqMatrix mixed fallback", info_ill.fallback,
+                       true);
+    pass &= qip::check_value(&obuff, "ZSqMatrix mixed ill-cond",
+                             std::max(std::abs(re_r), std::abs(im_r)), 0.0,
+                             1.0e-3);
+  }
+
   return pass;
 }
 
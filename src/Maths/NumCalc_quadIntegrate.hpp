@@ -56,6 +56,23 @@ inline double integrate(const double dt, std::size_t beg, std::size_t end,
   return (Rint_mid + dq_inv * Rint_ends) * dt;
 }
 
+//******************************************************************************
+//! Integration weights for grid: sum_i w_i f(r_i) is the same as
+//! integrate(gr.du(), 0, 0, f, gr.drdu()) (quadrature end corrections, dr/du,
+//! and du are all included). Useful for forming integrals as matrix products
+inline std::vector<double> integration_weights(const Grid &gr) {
+  const auto num_points = gr.num_points();
+  std::vector<double> w(num_points);
+  for (auto i = 0ul; i < num_points; ++i) {
+    w[i] = gr.drdu(i) * gr.du();
+    if (i < Nquad)
+      w[i] *= cq[i] * dq_inv;
+    else if (i >= num_points - Nquad)
+      w[i] *= cq[num_points - i - 1] * dq_inv;
+  }
+  return w;
+}
+
 //******************************************************************************
 template <typename T>
 inline std::vector<T> derivative(const std::vector<T> &f,
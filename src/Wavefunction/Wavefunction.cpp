@@ -724,7 +724,7 @@ void Wavefunction::formSigma(
     const std::string &out_fname, const bool FeynmanQ, const bool ScreeningQ,
     const bool holeParticleQ, const int lmax, const bool GreenBasis,
     const bool PolBasis, const double omre, double w0, double wratio,
-    const std::optional<IO::InputBlock> &ek) {
+    const bool mixed_precision, const std::optional<IO::InputBlock> &ek) {
   if (valence.empty())
     return;
 
@@ -741,8 +741,9 @@ void Wavefunction::formSigma(
       FeynmanQ ? MBPT::Method::Feynman : MBPT::Method::Goldstone;
 
   const auto sigp = MBPT::Sigma_params{
-      method, nmin_core, include_G, lmax,       GreenBasis,    PolBasis,
-      omre,   w0,        wratio,    ScreeningQ, holeParticleQ, fk};
+      method,        nmin_core,       include_G, lmax,   GreenBasis,
+      PolBasis,      omre,            w0,        wratio, ScreeningQ,
+      holeParticleQ, mixed_precision, fk};
 
   const auto subgridp = MBPT::rgrid_params{r0, rmax, std::size_t(stride)};
 
@@ -1,3 +1,4 @@
+#include "DiracODE/DiracODE.hpp"
 #include "IO/ChronoTimer.hpp"
 #include "IO/FRW_fileReadWrite.hpp" //for 'ExtraPotential'
 #include "IO/InputBlock.hpp"
@@ -7,6 +8,7 @@
 #include "Wavefunction/Wavefunction.hpp"
 #include "git.info"
 #include "qip/Vector.hpp"
+#include <algorithm>
 #include <iostream>
 #include <string>
 
@@ -142,7 +144,9 @@ void ampsci(const IO::InputBlock &input) {
        {"convergence", "HF convergance goal, 1e-12"},
        {"method", "HartreeFock(default), Hartree, KohnSham"},
        {"Breit", "Scale for Breit. 0.0 default (no Breit), 1.0 include Breit"},
-       {"sortOutput", "Sort energy tables by energy? (default=false)"}});
+       {"sortOutput", "Sort energy tables by energy? (default=false)"},
+       {"AM_order", "Order of Adams-Moulton method used to solve Dirac "
+                    "equation: 5-8 (default=7). Lower is faster"}});
 
   if (!input_ok) {
     std::cout
@@ -152,6 +156,16 @@ void ampsci(const IO::InputBlock &input) {
 
   const auto str_core = input.get<std::string>({"HartreeFock"}, "core", "[]");
   const auto eps_HF = input.get({"HartreeFock"}, "convergence", 1.0e-12);
+  // Order of Adams-Moulton method (all Dirac equation solutions)
+  const auto AM_order =
+      input.get({"HartreeFock"}, "AM_order", DiracODE::Adams::Param::AMO);
+  if (AM_order < 5 || AM_order > 8) {
+    std::cout << "\n⚠️  WARNING AM_order must be between 5 and 8; using "
+              << std::clamp(AM_order, 5, 8) << "\n";
+  } else if (AM_order != DiracODE::Adams::Param::AMO) {
+    std::cout << "Using Adams-Moulton order " << AM_order << "\n";
+  }
+  DiracODE::set_AM_order(AM_order);
   const auto HF_method =
       input.get<std::string>({"HartreeFock"}, "method", "HartreeFock");
   if (HF_method == "Hartree")
@@ -330,7 +344,8 @@ void ampsci(const IO::InputBlock &input) {
                                                        "basis_for_pol",
                                                        "real_omega",
                                                        "imag_omega",
-                                                       "include_G"});
+                                                       "include_G",
+                                                       "mixed_precision"});
   const bool do_energyShifts =
       input.get({"Correlations"}, "energyShifts", false);
   const bool do_brueckner = input.get({"Correlations"}, "Brueckner", false);
@@ -355,6 +370,8 @@ void ampsci(const IO::InputBlock &input) {
   const auto PolBasis = input.get({"Correlations"}, "basis_for_pol", false);
   const auto each_valence = input.get({"Correlations"}, "each_valence", false);
   const auto include_G = input.get({"Correlations"}, "include_G", false);
+  const auto mixed_precision =
+      input.get({"Correlations"}, "mixed_precision", false);
   // force sigma_omre to be always -ve
   const auto sigma_omre = -std::abs(
       input.get({"Correlations"}, "real_omega", -0.33 * wf.energy_gap()));
@@ -401,7 +418,8 @@ void ampsci(const IO::InputBlock &input) {
     wf.formSigma(n_min_core, do_brueckner, sigma_rmin, sigma_rmax, sigma_stride,
                  each_valence, include_G, lambda_k, fk, sigma_read, sigma_write,
                  sigma_Feynman, sigma_Screening, hole_particle, sigma_lmax,
-                 GreenBasis, PolBasis, sigma_omre, w0, wratio, ek_Sig);
+                 GreenBasis, PolBasis, sigma_omre, w0, wratio, mixed_precision,
+                 ek_Sig);
   }
 
   // Calculate + print second-order energy shifts
@@ -0,0 +1,822 @@
+#include "Angular/CkTable.hpp"
+#include "Angular/SixJTable.hpp"
+#include "Angular/Wigner369j.hpp"
+#include "Coulomb/Coulomb.hpp"
+#include "DiracODE/DiracODE.hpp"
+#include "IO/ChronoTimer.hpp"
+#include "IO/InputBlock.hpp" // for time+date
+#include "Maths/Grid.hpp"
+#include "Maths/LinAlg_MatrixVector.hpp"
+#include "Physics/DiracHydrogen.hpp"
+#include "Physics/PhysConst_constants.hpp"
+#include "Wavefunction/DiracSpinor.hpp"
+#include "Wavefunction/Wavefunction.hpp"
+#include "git.info"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <complex>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <gsl/gsl_sf_coupling.h>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+// omp_get_thread_num() is not defined if not using -fopenmp
+#if defined(_OPENMP)
+#include <omp.h>
+#else
+#define omp_get_max_threads() 1
+#define omp_set_num_threads(n)
+#endif
+
+/*!
+@brief Micro-benchmarks for the Coulomb integral kernels.
+
+@details
+Times the Coulomb kernels (y^k_ab, YkTable, Q^k, Q^k(v), CoulombTable fill and
+read/write), angular factors (6j symbols), and the Green's function solve used
+in Feynman Sigma (double vs. mixed precision, and the homogeneous Dirac
+solutions: one at a time vs. batched), and the bound-state Dirac solver for
+each Adams-Moulton order, under fixed, reproducible
+conditions: fixed grids, fixed basis sets (hydrogen-like orbitals, and a Cs
+Hartree-Fock basis), and fixed (seeded) samples of integrals. Each timing is
+repeated, and the fastest is reported.
+
+To run, compile benchmarks (make benchmarks), and run from command line. Like
+unitTests, it takes optional command-line options (the names of which
+benchmarks to run). By default (if no extra arguments given), every benchmark
+is run.
+
+$./benchmarks help
+  * prints list of available benchmarks
+
+ e.g.:
+ $./benchmarks yk_ab Qk
+   * Will run just the yk_ab and Qk benchmarks
+
+Results are written (to screen, and to file benchmarks_<date>_<time>.csv) in
+csv format, one line per benchmark/basis/number of threads:
+
+  benchmark,basis,threads,ops,ns_per_op,GB_per_s,speedup
+
+ - ns_per_op: time per 'operation' (e.g., per y^k_ab function, per integral)
+ - GB_per_s: (minimum) memory traffic of the kernel, per second. This is an
+ estimate (of the data that must be read/written), not a measurement
+ - speedup: for parallel kernels, relative to single thread (thread scaling)
+
+Lines beginning with '#' are comments (git version, date, grid etc.). Compare
+files from two versions to catch performance regressions.
+
+When a new benchmark is written, for it to be run, it must be added to the
+benchmark_list vector.
+*/
+namespace Benchmark {
+
+//! Single benchmark result (one line of output)
+struct Result {
+  std::string name;
+  std::string basis;
+  int threads;
+  std::size_t ops;
+  double ns_per_op;
+  double GB_per_s;
+  double speedup;
+};
+
+//! Fixed set of orbitals to run benchmarks on
+struct Basis {
+  std::string name;
+  std::vector<DiracSpinor> orbs;
+};
+
+// Results are added to this, to stop compiler optimising away the work
+double g_sink = 0.0;
+
+//------------------------------------------------------------------------------
+// Runs f() 'reps' times; returns fastest time (in ns) per op
+template <typename Func>
+double time_ns(Func &&f, std::size_t ops, int reps = 3) {
+  double best_ms = std::numeric_limits<double>::max();
+  for (int i = 0; i < reps; ++i) {
+    IO::ChronoTimer t; // nb: un-named, so doesn't print
+    f();
+    best_ms = std::min(best_ms, t.reading_ms());
+  }
+  return best_ms * 1.0e6 / double(ops);
+}
+
+// Forms a result line; bytes is (estimated) memory traffic per op
+Result result(std::string_view name, const Basis &basis, int threads,
+              std::size_t ops, double ns_per_op, double bytes,
+              double speedup = 1.0) {
+  // bytes/ns = GB/s
+  return {std::string(name), basis.name, threads, ops,
+          ns_per_op,         bytes / ns_per_op, speedup};
+}
+
+// List of thread counts to test scaling: 1,2,4,..., max
+std::vector<int> thread_list() {
+  std::vector<int> list;
+  const auto max = omp_get_max_threads();
+  for (int n = 1; n < max; n *= 2) {
+    list.push_back(n);
+  }
+  list.push_back(max);
+  return list;
+}
+
+// Fixed (seeded) sample of {k,a,b,c,d} with non-zero angular factor
+struct Quartet {
+  int k;
+  std::size_t a, b, c, d;
+};
+std::vector<Quartet> sample_quartets(const Basis &basis, std::size_t number) {
+  std::mt19937 gen(42);
+  const auto &orbs = basis.orbs;
+  std::uniform_int_distribution<std::size_t> rindex(0, orbs.size() - 1);
+  std::vector<Quartet> list;
+  list.reserve(number);
+  while (list.size() < number) {
+    const auto a = rindex(gen), b = rindex(gen);
+    const auto c = rindex(gen), d = rindex(gen);
+    const auto [kmin, kmax] =
+        Coulomb::k_minmax_Q(orbs[a], orbs[b], orbs[c], orbs[d]);
+    for (int k = kmin; k <= kmax && list.size() < number; k += 2) {
+      list.push_back({k, a, b, c, d});
+    }
+  }
+  return list;
+}
+
+//******************************************************************************
+// y^k_ab, for each k separately: fixed set of pairs
+void yk_ab(const Basis &basis, std::vector<Result> *results) {
+  const auto &orbs = basis.orbs;
+  const auto num_points = orbs.front().rgrid->num_points();
+  const auto num_orbs = std::min(orbs.size(), 24ul);
+  std::vector<double> ykab(num_points);
+  const auto ops = num_orbs * num_orbs;
+  // reads f,g of a and b, writes y
+  const auto bytes = 5.0 * double(num_points * sizeof(double));
+  for (int k = 0; k <= 6; ++k) {
+    const auto ns = time_ns(
+        [&]() {
+          for (auto ia = 0ul; ia < num_orbs; ++ia) {
+            for (auto ib = 0ul; ib < num_orbs; ++ib) {
+              Coulomb::yk_ab(orbs[ia], orbs[ib], k, ykab);
+              g_sink += ykab.back();
+            }
+          }
+        },
+        ops);
+    results->push_back(
+        result("yk_ab k=" + std::to_string(k), basis, 1, ops, ns, bytes));
+  }
+}
+
+//******************************************************************************
+// YkTable::calculate: thread scaling, and vs. calculating one k at a time
+void YkTable(const Basis &basis, std::vector<Result> *results) {
+  const auto &orbs = basis.orbs;
+  const auto num_points = orbs.front().rgrid->num_points();
+  {
+    // Same set of y^k_ab as YkTable, but each k calculated separately
+    const auto ns = time_ns(
+        [&]() {
+          std::vector<double> ykab;
+          for (auto ia = 0ul; ia < orbs.size(); ++ia) {
+            for (auto ib = 0ul; ib <= ia; ++ib) {
+              const auto [k0, kI] = Coulomb::k_minmax(orbs[ia], orbs[ib]);
+              for (int k = k0; k <= kI; k += 2) {
+                Coulomb::yk_ab(orbs[ia], orbs[ib], k, ykab);
+                g_sink += ykab.back();
+              }
+            }
+          }
+        },
+        1);
+    // bytes: size of all y^k (written)
+    std::size_t bytes = 0;
+    for (auto ia = 0ul; ia < orbs.size(); ++ia) {
+      for (auto ib = 0ul; ib <= ia; ++ib) {
+        const auto [k0, kI] = Coulomb::k_minmax(orbs[ia], orbs[ib]);
+        bytes += std::size_t((kI - k0) / 2 + 1) * num_points * sizeof(double);
+      }
+    }
+    results->push_back(
+        result("YkTable (per-k yk_ab)", basis, 1, 1, ns, double(bytes)));
+  }
+  double t1 = 0.0;
+  for (const auto threads : thread_list()) {
+    omp_set_num_threads(threads);
+    std::size_t bytes = 0;
+    const auto ns = time_ns(
+        [&]() {
+          const Coulomb::YkTable yk(basis.orbs);
+          bytes = yk.arena_bytes();
+        },
+        1);
+    if (threads == 1)
+      t1 = ns;
+    // bytes: size of y^k arena (written)
+    results->push_back(result("YkTable::calculate", basis, threads, 1, ns,
+                              double(bytes), t1 / ns));
+  }
+  omp_set_num_threads(omp_get_max_threads());
+}
+
+//******************************************************************************
+// Q^k_abcd: from scratch, using YkTable, and looked up in QkTable
+void Qk(const Basis &basis, std::vector<Result> *results) {
+  const auto &orbs = basis.orbs;
+  const auto num_points = double(orbs.front().rgrid->num_points());
+  const auto quartets = sample_quartets(basis, 20000);
+  const Coulomb::YkTable yk(orbs);
+
+  { // From scratch (calculates y^k): only use part of list, since slow
+    const auto ops = 1000ul;
+    const auto ns = time_ns(
+        [&]() {
+          for (auto i = 0ul; i < ops; ++i) {
+            const auto &[k, a, b, c, d] = quartets[i];
+            g_sink += Coulomb::Qk_abcd(orbs[a], orbs[b], orbs[c], orbs[d], k);
+          }
+        },
+        ops);
+    // reads 4 orbitals (f,g), writes + reads y
+    const auto bytes = 10.0 * num_points * sizeof(double);
+    results->push_back(result("Qk_abcd direct", basis, 1, ops, ns, bytes));
+  }
+
+  { // Using existing y^k
+    const auto ops = quartets.size();
+    const auto ns = time_ns(
+        [&]() {
+          for (const auto &[k, a, b, c, d] : quartets) {
+            g_sink += yk.Qk(k, orbs[a], orbs[b], orbs[c], orbs[d]);
+          }
+        },
+        ops);
+    // reads y^k_bd, and f,g of a and c
+    const auto bytes = 5.0 * num_points * sizeof(double);
+    results->push_back(result("YkTable::Qk", basis, 1, ops, ns, bytes));
+  }
+
+  // Look-up in full table: hash map, and frozen (sorted arrays)
+  using Coulomb::Storage;
+  for (const auto storage : {Storage::hash, Storage::frozen}) {
+    Coulomb::QkTable qk(storage);
+    qk.fill(orbs, yk);
+    const auto ops = quartets.size();
+    const auto ns = time_ns(
+        [&]() {
+          for (const auto &[k, a, b, c, d] : quartets) {
+            g_sink += qk.Q(k, orbs[a], orbs[b], orbs[c], orbs[d]);
+          }
+        },
+        ops);
+    // key + value
+    const auto bytes = double(sizeof(Coulomb::QkTable::BigIndex) +
+                              sizeof(Coulomb::QkTable::Real));
+    const auto name =
+        storage == Storage::hash ? "QkTable::Q hash" : "QkTable::Q frozen";
+    results->push_back(result(name, basis, 1, ops, ns, bytes));
+  }
+}
+
+//******************************************************************************
+// Q^k(v)_bcd: from scratch, and using YkTable
+void Qkv(const Basis &basis, std::vector<Result> *results) {
+  const auto &orbs = basis.orbs;
+  const auto num_points = double(orbs.front().rgrid->num_points());
+  const auto quartets = sample_quartets(basis, 2000);
+  const Coulomb::YkTable yk(orbs);
+
+  { // From scratch (calculates y^k)
+    const auto ops = quartets.size();
+    const auto ns = time_ns(
+        [&]() {
+          for (const auto &[k, a, b, c, d] : quartets) {
+            const auto Qkv =
+                Coulomb::Qkv_bcd(orbs[a].k, orbs[b], orbs[c], orbs[d], k);
+            g_sink += Qkv.f(0);
+          }
+        },
+        ops);
+    // reads 3 orbitals (f,g), writes+reads y, writes f,g
+    const auto bytes = 10.0 * num_points * sizeof(double);
+    results->push_back(result("Qkv_bcd direct", basis, 1, ops, ns, bytes));
+  }
+
+  { // Using existing y^k
+    const auto ops = quartets.size();
+    const auto ns = time_ns(
+        [&]() {
+          for (const auto &[k, a, b, c, d] : quartets) {
+            const auto Qkv =
+                yk.Qkv_bcd(orbs[a].k, orbs[b], orbs[c], orbs[d], k);
+            g_sink += Qkv.f(0);
+          }
+        },
+        ops);
+    // reads y^k_bd and f,g of c, writes f,g
+    const auto bytes = 5.0 * num_points * sizeof(double);
+    results->push_back(result("YkTable::Qkv_bcd", basis, 1, ops, ns, bytes));
+  }
+}
+
+//******************************************************************************
+// CoulombTable::fill (thread scaling), and write/read/map to/from disk
+void QkTable(const Basis &basis, std::vector<Result> *results) {
+  const auto &orbs = basis.orbs;
+  const Coulomb::YkTable yk(orbs);
+  // nb: 'fill' prints some output; results are still captured in csv
+  const auto bytes = double(sizeof(Coulomb::QkTable::BigIndex) +
+                            sizeof(Coulomb::QkTable::Real));
+
+  double t1 = 0.0;
+  std::size_t num_integrals = 0;
+  for (const auto threads : thread_list()) {
+    omp_set_num_threads(threads);
+    // First, count the number of integrals (ops)
+    if (num_integrals == 0) {
+      Coulomb::QkTable qk;
+      qk.fill(orbs, yk);
+      for (const auto &qk_k : *(qk.operator->())) {
+        num_integrals += qk_k.size();
+      }
+    }
+    const auto ns = time_ns(
+        [&]() {
+          Coulomb::QkTable qk;
+          qk.fill(orbs, yk);
+        },
+        num_integrals, 2);
+    if (threads == 1)
+      t1 = ns;
+    results->push_back(result("CoulombTable::fill", basis, threads,
+                              num_integrals, ns, bytes, t1 / ns));
+  }
+  omp_set_num_threads(omp_get_max_threads());
+
+  // Read/write
+  Coulomb::QkTable qk(Coulomb::Storage::frozen);
+  qk.fill(orbs, yk);
+  const std::string fname = "tmp_benchmark_delete_me.qk";
+  const std::string fname_map = "tmp_benchmark_delete_me.qkm";
+
+  const auto file_bytes = [&](const std::string &name) {
+    return double(std::filesystem::file_size(name)) / double(num_integrals);
+  };
+
+  const auto ns_w = time_ns([&]() { qk.write(fname); }, num_integrals);
+  results->push_back(result("CoulombTable::write", basis, 1, num_integrals,
+                            ns_w, file_bytes(fname)));
+  const auto ns_r = time_ns(
+      [&]() {
+        Coulomb::QkTable qk2;
+        qk2.read(fname);
+      },
+      num_integrals);
+  results->push_back(result("CoulombTable::read", basis, 1, num_integrals,
+                            ns_r, file_bytes(fname)));
+
+  const auto ns_wm = time_ns([&]() { qk.write(fname_map, orbs); },
+                             num_integrals);
+  results->push_back(result("CoulombTable::write (map)", basis, 1,
+                            num_integrals, ns_wm, file_bytes(fname_map)));
+  const auto ns_m = time_ns(
+      [&]() {
+        Coulomb::QkTable qk2;
+        qk2.map(fname_map, orbs);
+      },
+      num_integrals);
+  // nb: map doesn't read the data, so 'GB/s' is not meaningful here
+  results->push_back(
+      result("CoulombTable::map", basis, 1, num_integrals, ns_m, 0.0));
+
+  std::remove(fname.c_str());
+  std::remove(fname_map.c_str());
+}
+
+//******************************************************************************
+// 6j symbols {ja jb k \ jc jd l}, for all j's in basis: native (Racah
+// formula), GSL, and SixJTable look-up
+void sixj(const Basis &basis, std::vector<Result> *results) {
+  const auto max_2j = DiracSpinor::max_tj(basis.orbs);
+  std::vector<std::array<int, 6>> list;
+  for (int ja = 1; ja <= max_2j; ja += 2) {
+    for (int jb = 1; jb <= max_2j; jb += 2) {
+      for (int k = 0; k <= 2 * max_2j; k += 2) {
+        for (int jc = 1; jc <= max_2j; jc += 2) {
+          for (int jd = 1; jd <= max_2j; jd += 2) {
+            for (int l = 0; l <= 2 * max_2j; l += 2) {
+              if (!Angular::sixj_zeroQ(ja, jb, k, jc, jd, l))
+                list.push_back({ja, jb, k, jc, jd, l});
+            }
+          }
+        }
+      }
+    }
+  }
+  const auto ops = list.size();
+
+  const auto ns_native = time_ns(
+      [&]() {
+        for (const auto &[a, b, c, d, e, f] : list)
+          g_sink += Angular::sixj_2(a, b, c, d, e, f);
+      },
+      ops);
+  results->push_back(result("sixj_2", basis, 1, ops, ns_native, 0.0));
+
+  const auto ns_batch = time_ns(
+      [&]() {
+        const auto sj = Angular::sixj_2(list);
+        g_sink += sj.back();
+      },
+      ops);
+  results->push_back(result("sixj_2 (batch)", basis, 1, ops, ns_batch, 0.0));
+
+  const auto ns_gsl = time_ns(
+      [&]() {
+        for (const auto &[a, b, c, d, e, f] : list)
+          g_sink += gsl_sf_coupling_6j(a, b, c, d, e, f);
+      },
+      ops);
+  results->push_back(result("gsl_sf_coupling_6j", basis, 1, ops, ns_gsl, 0.0));
+
+  const Angular::SixJTable sjt(2 * max_2j);
+  const auto ns_table = time_ns(
+      [&]() {
+        for (const auto &[a, b, c, d, e, f] : list)
+          g_sink += sjt.get(a, b, c, d, e, f);
+      },
+      ops);
+  results->push_back(
+      result("SixJTable::get", basis, 1, ops, ns_table, sizeof(double)));
+}
+
+//******************************************************************************
+// Green's function solve, G = [1 + A(w)]^{-1} * G0, at complex energy (as in
+// Feynman Sigma): double-precision inverse vs. mixed-precision solve (single
+// precision LU + refinement). A(w) is spectral sum over basis, on a ~150 point
+// sub-grid over [1e-4, 30], including f and g components (300 x 300 matrix)
+void GreenSolve(const Basis &basis, std::vector<Result> *results) {
+  const auto &orbs = basis.orbs;
+  const auto &gr = *orbs.front().rgrid;
+  const auto i0 = gr.getIndex(1.0e-4);
+  const auto stride = std::max(1ul, (gr.getIndex(30.0) - i0) / 150);
+  std::vector<std::size_t> sub;
+  for (auto i = i0; i < gr.getIndex(30.0); i += stride) {
+    sub.push_back(i);
+  }
+  const auto np = sub.size();
+  const auto n = 2 * np;
+
+  // Spectral G(e), on sub-grid: sum_a |a><a| / (e - e_a); f and g blocks
+  const auto green = [&](std::complex<double> e) {
+    LinAlg::ZSqMatrix G(n);
+    for (const auto &a : orbs) {
+      const auto c = 1.0 / (e - a.en());
+      for (auto i = 0ul; i < n; ++i) {
+        const auto ai = i < np ? a.f(sub[i]) : a.g(sub[i - np]);
+        for (auto j = 0ul; j < n; ++j) {
+          const auto aj = j < np ? a.f(sub[j]) : a.g(sub[j - np]);
+          G(i, j) += c * ai * aj;
+        }
+      }
+    }
+    return G;
+  };
+
+  // X = 1 + i*w*G0*dr (as in GreenAtComplex), for a few w
+  const std::vector<double> ws{0.01, 0.1, 1.0, 10.0};
+  const auto G0 = green({-0.5 * std::abs(orbs.front().en()), 0.0});
+  std::vector<LinAlg::ZSqMatrix> Xs;
+  for (const auto w : ws) {
+    auto &X = Xs.emplace_back(G0);
+    for (auto i = 0ul; i < n; ++i) {
+      for (auto j = 0ul; j < n; ++j) {
+        const auto j_sub = sub[j < np ? j : j - np];
+        X(i, j) *= std::complex<double>{0.0, w * gr.drdu(j_sub) * gr.du() *
+                                                 double(stride)};
+      }
+    }
+    X.plusIdent(1.0);
+  }
+  const auto ops = Xs.size();
+
+  std::vector<LinAlg::ZSqMatrix> Gd(ops), Gm(ops);
+  const auto ns_double = time_ns(
+      [&]() {
+        for (auto i = 0ul; i < ops; ++i) {
+          Gd[i] = Xs[i].inverse() * G0;
+        }
+      },
+      ops);
+  // Three n*n complex matrices: X, G0, and G
+  const auto bytes = 3.0 * double(n * n) * sizeof(std::complex<double>);
+  results->push_back(result("GreenSolve (double)", basis, 1, ops, ns_double,
+                            bytes));
+
+  int max_iter = 0;
+  int fallbacks = 0;
+  const auto ns_mixed = time_ns(
+      [&]() {
+        for (auto i = 0ul; i < ops; ++i) {
+          LinAlg::MixedSolveInfo info;
+          Gm[i] = LinAlg::solve_mixed(Xs[i], G0, 10, &info);
+          max_iter = std::max(max_iter, info.iterations);
+          fallbacks += info.fallback ? 1 : 0;
+        }
+      },
+      ops);
+  results->push_back(result("GreenSolve (mixed)", basis, 1, ops, ns_mixed,
+                            bytes, ns_double / ns_mixed));
+
+  // Accuracy: mixed vs. double, relative to largest element of G
+  double eps = 0.0;
+  for (auto i = 0ul; i < ops; ++i) {
+    double max_G = 0.0, max_del = 0.0;
+    for (auto k = 0ul; k < n * n; ++k) {
+      max_G = std::max(max_G, std::abs(Gd[i].data()[k]));
+      max_del = std::max(max_del, std::abs(Gd[i].data()[k] - Gm[i].data()[k]));
+    }
+    eps = std::max(eps, max_del / max_G);
+  }
+  std::cout << "GreenSolve: " << n << "x" << n << "; mixed vs. double: eps="
+            << eps << ", max refinement steps=" << max_iter
+            << ", fall-backs=" << fallbacks << "\n";
+  g_sink += std::abs(Gd.back()(0, 0)) + std::abs(Gm.back()(0, 0));
+}
+
+//******************************************************************************
+// Homogeneous Dirac solutions (regular at 0 and infinity), for each kappa in
+// basis at a single energy (as in Feynman Sigma, for G0): one at a time vs.
+// batched (several systems integrated together, one per SIMD lane)
+void DiracHomog(const Basis &basis, std::vector<Result> *results) {
+  const auto &orbs = basis.orbs;
+  const auto rgrid = orbs.front().rgrid;
+  const auto alpha = PhysConst::alpha;
+  // Screened Coulomb potential (Z=10 at origin, Z=1 at large r)
+  std::vector<double> v;
+  for (const auto r : rgrid->r()) {
+    v.push_back(-(1.0 + 9.0 * std::exp(-r)) / r);
+  }
+  std::vector<int> kappas;
+  for (const auto &a : orbs) {
+    if (std::find(kappas.begin(), kappas.end(), a.k) == kappas.end())
+      kappas.push_back(a.k);
+  }
+  const std::vector<double> ens(kappas.size(), -0.3);
+  const auto ops = kappas.size();
+
+  std::vector<DiracSpinor> x0s, xIs;
+  for (const auto kappa : kappas) {
+    x0s.emplace_back(0, kappa, rgrid);
+    xIs.emplace_back(0, kappa, rgrid);
+  }
+  auto x0s_b = x0s;
+  auto xIs_b = xIs;
+
+  const auto ns_scalar = time_ns(
+      [&]() {
+        for (auto i = 0ul; i < ops; ++i) {
+          DiracODE::regularAtOrigin(x0s[i], ens[i], v, {}, alpha);
+          DiracODE::regularAtInfinity(xIs[i], ens[i], v, {}, alpha);
+        }
+      },
+      ops);
+  // f and g, for x0 and xI (+ grid and potential)
+  const auto bytes = 6.0 * double(rgrid->num_points()) * sizeof(double);
+  results->push_back(
+      result("DiracHomog (scalar)", basis, 1, ops, ns_scalar, bytes));
+
+  const auto ns_batch = time_ns(
+      [&]() {
+        DiracODE::regularAtOrigin(x0s_b, ens, v, {}, alpha);
+        DiracODE::regularAtInfinity(xIs_b, ens, v, {}, alpha);
+      },
+      ops);
+  results->push_back(result("DiracHomog (batch)", basis, 1, ops, ns_batch,
+                            bytes, ns_scalar / ns_batch));
+
+  // Should be identical
+  double eps = 0.0;
+  for (auto i = 0ul; i < ops; ++i) {
+    const auto d0 = x0s[i] - x0s_b[i];
+    const auto dI = xIs[i] - xIs_b[i];
+    eps = std::max({eps, d0 * d0 / (x0s[i] * x0s[i]),
+                    dI * dI / (xIs[i] * xIs[i])});
+  }
+  std::cout << "DiracHomog: " << ops << " kappas; batch vs. scalar: eps="
+            << eps << "\n";
+  g_sink += x0s_b.back().f(100) + xIs_b.back().f(100);
+}
+
+//******************************************************************************
+// Bound-state Dirac solver (DiracODE::boundState), for each Adams-Moulton order
+// (DiracODE::set_AM_order). Coulomb potential (Z=10), for each (n,kappa) in
+// basis with n<=7. One op is one grid point integrated (summed over the trial
+// solutions for each state), i.e., ns_per_op is ns per grid point. Speed-up is
+// relative to default order (Param::AMO). Accuracy (vs. exact energy) printed.
+void DiracBound(const Basis &basis, std::vector<Result> *results) {
+  const auto rgrid = basis.orbs.front().rgrid;
+  const auto alpha = PhysConst::alpha;
+  const double zeff = 10.0;
+  std::vector<double> v;
+  for (const auto r : rgrid->r()) {
+    v.push_back(-zeff / r);
+  }
+  std::vector<std::pair<int, int>> states;
+  for (const auto &a : basis.orbs) {
+    if (a.n <= 7 && a.n > a.l() &&
+        std::find(states.begin(), states.end(), std::pair{a.n, a.k}) ==
+            states.end())
+      states.emplace_back(a.n, a.k);
+  }
+
+  const auto order0 = DiracODE::get_AM_order();
+  // {order, ops, ns_per_op}
+  std::vector<std::tuple<int, std::size_t, double>> timings;
+  for (int order = 5; order <= 8; ++order) {
+    DiracODE::set_AM_order(order);
+    std::vector<DiracSpinor> Fs;
+    for (const auto &[n, k] : states) {
+      Fs.emplace_back(n, k, rgrid);
+    }
+    const auto solve = [&]() {
+      for (auto &Fa : Fs) {
+        DiracODE::boundState(Fa, -0.5 * zeff * zeff / (Fa.n * Fa.n), v, {},
+                             alpha);
+      }
+    };
+    // Number of grid points integrated (each trial solution is ~pinf points)
+    solve();
+    std::size_t ops = 0;
+    double eps = 0.0;
+    int its = 0;
+    for (const auto &Fa : Fs) {
+      using namespace DiracHydrogen;
+      ops += std::size_t(Fa.its()) * Fa.max_pt();
+      its += Fa.its();
+      const auto en_exact =
+          enk(PrincipalQN(Fa.n), DiracQN(Fa.k), Zeff(zeff), AlphaFS(alpha));
+      eps = std::max(eps, std::abs((Fa.en() - en_exact) / en_exact));
+    }
+    const auto ns = time_ns(solve, ops);
+    timings.emplace_back(order, ops, ns);
+    std::cout << "DiracBound: AM order " << order << "; " << Fs.size()
+              << " states, " << its << " trial solutions; eps(en)=" << eps
+              << "\n";
+    g_sink += Fs.back().en();
+  }
+  DiracODE::set_AM_order(order0);
+
+  const auto ns0 = std::get<2>(
+      timings.at(std::size_t(DiracODE::Adams::Param::AMO - 5)));
+  for (const auto &[order, ops, ns] : timings) {
+    // f and g written; v, drdu, drduor read, per point
+    const auto bytes = 5.0 * sizeof(double);
+    results->push_back(result("DiracBound (AM" + std::to_string(order) + ")",
+                              basis, 1, ops, ns, bytes, ns0 / ns));
+  }
+}
+
+//******************************************************************************
+// Input basis sets:
+
+// Hydrogen-like (exact) orbitals, n<=10, l<=3
+Basis Hlike() {
+  const auto grid = std::make_shared<const Grid>(
+      GridParameters{2000, 1.0e-6, 150.0, 20.0, "loglinear"});
+  const double zeff = 10.0;
+  Basis basis{"H-like", {}};
+  for (int n = 1; n <= 10; ++n) {
+    for (int l = 0; l < n && l <= 3; ++l) {
+      for (const auto kappa : {l, -l - 1}) {
+        if (kappa == 0)
+          continue;
+        basis.orbs.push_back(DiracSpinor::exactHlike(n, kappa, grid, zeff));
+      }
+    }
+  }
+  return basis;
+}
+
+// Cs: B-spline basis (Hartree-Fock [Xe] core)
+Basis Cs() {
+  Wavefunction wf({2000, 1.0e-6, 150.0, 20.0, "loglinear", -1.0},
+                  {"Cs", -1, "Fermi", -1.0, -1.0}, 1.0);
+  wf.solve_core("HartreeFock", 0.0, "[Xe]");
+  wf.formBasis({"12spdf", 30, 7, 1.0e-5, 1.0e-6, 40.0, false});
+  return {"Cs", wf.basis};
+}
+
+//******************************************************************************
+// Vector of available benchmarks
+static const std::vector<
+    std::pair<std::string, void (*)(const Basis &, std::vector<Result> *)>>
+    benchmark_list{
+        //
+        {"yk_ab", &yk_ab},
+        {"YkTable", &YkTable},
+        {"Qk", &Qk},
+        {"Qkv", &Qkv},
+        {"QkTable", &QkTable},
+        {"sixj", &sixj},
+        {"GreenSolve", &GreenSolve},
+        {"DiracHomog", &DiracHomog},
+        {"DiracBound", &DiracBound}
+        //
+    };
+
+//------------------------------------------------------------------------------
+// Looks up benchmark + returns its function. If not in list, prints list
+auto get_benchmark(std::string_view in_name) {
+
+  for (const auto &[name, benchmark] : benchmark_list) {
+    if (name == in_name)
+      return benchmark;
+  }
+
+  if (in_name != "help") {
+    std::cout << "No benchmark named: " << in_name << "\n";
+  }
+  std::cout << "Available benchmarks:\n";
+  for (const auto &[name, benchmark] : benchmark_list) {
+    std::cout << name << "\n";
+  }
+  std::exit(1);
+}
+
+} // namespace Benchmark
+
+//******************************************************************************
+int main(int argc, char *argv[]) {
+
+  // Make a list of all benchmarks to Run
+  std::vector<std::string_view> name_list;
+  if (argc <= 1) {
+    for (const auto &[name, benchmark] : Benchmark::benchmark_list)
+      name_list.emplace_back(name);
+  } else {
+    for (int i = 1; i < argc; ++i)
+      name_list.emplace_back(argv[i]);
+  }
+  // check all exist before starting (so don't fail at the end)
+  for (const auto &name : name_list) {
+    Benchmark::get_benchmark(name);
+  }
+
+  std::ostringstream out_buff;
+  out_buff << "# ampsci benchmarks. git:" << GitInfo::gitversion << " ("
+           << GitInfo::gitbranch << ")\n";
+  out_buff << "# " << IO::time_date() << "\n";
+  out_buff << "# max threads: " << omp_get_max_threads() << "\n";
+
+  const std::vector<Benchmark::Basis> bases{Benchmark::Hlike(),
+                                            Benchmark::Cs()};
+  for (const auto &basis : bases) {
+    const auto &gr = *basis.orbs.front().rgrid;
+    out_buff << "# basis " << basis.name << ": " << basis.orbs.size()
+             << " orbitals; " << DiracSpinor::state_config(basis.orbs)
+             << "; grid: " << gr.num_points() << " points, " << gr.r0()
+             << " - " << gr.rmax() << "\n";
+  }
+
+  std::vector<Benchmark::Result> results;
+  for (const auto &name : name_list) {
+    const auto benchmark = Benchmark::get_benchmark(name);
+    for (const auto &basis : bases) {
+      std::cout << "\nRunning: " << name << " (" << basis.name << ")\n"
+                << std::flush;
+      benchmark(basis, &results);
+    }
+  }
+
+  out_buff << "benchmark,basis,threads,ops,ns_per_op,GB_per_s,speedup\n";
+  for (const auto &r : results) {
+    out_buff << r.name << "," << r.basis << "," << r.threads << "," << r.ops
+             << "," << r.ns_per_op << "," << r.GB_per_s << "," << r.speedup
+             << "\n";
+  }
+
+  // Output results:
+  std::cout << "\n" << out_buff.str();
+  std::ofstream of("benchmarks_" + IO::date() + "_" + IO::time() + ".csv");
+  of << out_buff.str();
+
+  // (so the compiler can't optimise away the benchmarks)
+  std::cout << "# (" << Benchmark::g_sink << ")\n";
+  return 0;
+}
@@ -1,12 +1,22 @@
+#include "Angular/CkTable.hpp"
+#include "Angular/SixJTable.hpp"
 #include "Angular/Wigner369j.hpp"
 #include "IO/FRW_fileReadWrite.hpp"
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
 #include <iostream>
+#include <limits>
 #include <sstream>
 #include <string>
 #include <vector>
 
 /*
 Quick routine that outputs numeric values for Wigner 3,6,9J symbols.
+Also has a 'batch' mode (-b), for evaluating very long lists of symbols.
 */
 
 //******************************************************************************
@@ -22,7 +32,12 @@ void instructions(const std::string &input = "") {
       << "(If inputting from command line, must include the quote marks!)\n"
       << "(You can list symbols in an input file, run like: "
       << "./wigner -f inputfile.in [-f optional if '.in' extension is used])\n"
-      << "You can use any symbol in place of the commas (incl space).\n\n";
+      << "You can use any symbol in place of the commas (incl space).\n\n"
+      << "Batch mode (for long lists; one value per line, in input order):\n"
+      << "  ./wigner -b [inputfile] [-o outputfile] [--binary]\n"
+      << "(Reads from stdin if no input file (or '-') given. Writes to stdout "
+         "if no -o. --binary writes raw doubles instead of text. Invalid "
+         "symbols give nan.)\n\n";
 }
 
 //******************************************************************************
@@ -88,6 +103,180 @@ void calculateSingleTerm(const std::string &input) {
   }
 }
 
+//******************************************************************************
+// Batch mode: symbols stored as 2*j (and 2*m) integers
+enum class SymbolType { skip, invalid, threej, cg, sixj, ninej };
+
+struct Symbol {
+  SymbolType type{SymbolType::skip};
+  std::array<int, 9> tj{};
+};
+
+//! Parses a single line (symbol) for batch mode. Faster than the istringstream
+//! in calculateSingleTerm; stops at the closing bracket
+Symbol parseSymbol(const std::string &line) {
+  Symbol symbol;
+  const auto first = line.find_first_not_of(" \t\r");
+  if (first == std::string::npos)
+    return symbol; // blank
+  const char *c = line.c_str() + first;
+  if (*c == '!' || *c == '#' || (c[0] == '/' && c[1] == '/'))
+    return symbol; // comment
+
+  const char bracket = *c;
+  const char close = bracket == '(' ? ')' : bracket == '<' ? '>' : '}';
+  if (bracket != '(' && bracket != '<' && bracket != '{') {
+    symbol.type = SymbolType::invalid;
+    return symbol;
+  }
+
+  std::size_t num = 0;
+  bool ok = true;
+  for (++c; *c != '\0' && *c != close;) {
+    // skip separators (any non-number character)
+    if (!((*c >= '0' && *c <= '9') || *c == '-' || *c == '+' || *c == '.')) {
+      ++c;
+      continue;
+    }
+    char *end;
+    const auto x = std::strtod(c, &end);
+    if (end == c) {
+      ++c; // e.g., lone '-'
+      continue;
+    }
+    c = end;
+    const auto two_x = std::lround(2.0 * x);
+    if (num == symbol.tj.size() || std::abs(2.0 * x - double(two_x)) > 1.0e-6) {
+      ok = false;
+      break;
+    }
+    symbol.tj[num++] = int(two_x);
+  }
+
+  if (!ok)
+    symbol.type = SymbolType::invalid;
+  else if (bracket == '(' && num == 6)
+    symbol.type = SymbolType::threej;
+  else if (bracket == '<' && num == 6)
+    symbol.type = SymbolType::cg;
+  else if (bracket == '{' && num == 6)
+    symbol.type = SymbolType::sixj;
+  else if (bracket == '{' && num == 9)
+    symbol.type = SymbolType::ninej;
+  else
+    symbol.type = SymbolType::invalid;
+  return symbol;
+}
+
+//! Evaluates symbol: from lookup tables if possible, otherwise calculates
+double evaluateSymbol(const Symbol &s, const Angular::SixJTable &sixj,
+                      const Angular::CkTable &Ck) {
+  const auto &j = s.tj;
+  switch (s.type) {
+  case SymbolType::threej:
+    // Special case (ja, jb, k, -1/2, 1/2, 0) is stored in C^k table
+    if (j[3] == -1 && j[4] == 1 && j[5] == 0 && j[0] % 2 == 1 &&
+        j[1] % 2 == 1 && j[2] % 2 == 0 && std::max(j[0], j[1]) <= Ck.max_tj() &&
+        j[2] / 2 <= Ck.max_k()) {
+      // nb: 3j doesn't depend on l, so any kappa with correct j
+      return Ck.get_3jkab(j[2] / 2, -(j[0] + 1) / 2, -(j[1] + 1) / 2);
+    }
+    return Angular::threej_2(j[0], j[1], j[2], j[3], j[4], j[5]);
+  case SymbolType::cg:
+    return Angular::cg_2(j[0], j[1], j[2], j[3], j[4], j[5]);
+  case SymbolType::sixj:
+    if (std::max({j[0], j[1], j[2], j[3], j[4], j[5]}) <= sixj.max_2jk())
+      return sixj.get(j[0], j[1], j[2], j[3], j[4], j[5]);
+    return Angular::sixj_2(j[0], j[1], j[2], j[3], j[4], j[5]);
+  case SymbolType::ninej:
+    return Angular::ninej_2(j[0], j[1], j[2], j[3], j[4], j[5], j[6], j[7],
+                            j[8]);
+  case SymbolType::invalid:
+    return std::numeric_limits<double>::quiet_NaN();
+  case SymbolType::skip:
+    break;
+  }
+  return 0.0;
+}
+
+//! Batch mode: reads symbols (one per line) from 'in', evaluates them in
+//! parallel, and writes one value per symbol to 'out' (in input order).
+//! Processed in chunks, so memory use doesn't depend on length of input.
+void batchMode(std::istream &in, std::FILE *out, bool binary) {
+  // Symbols with 2j up to this are looked up in 6j table (~8 MB); larger ones
+  // are calculated directly
+  constexpr int max_2j_table = 24;
+  constexpr std::size_t chunk_size = 1 << 16;
+
+  Angular::SixJTable sixj;
+  Angular::CkTable Ck;
+
+  const auto t0 = std::chrono::steady_clock::now();
+  std::size_t count = 0, num_invalid = 0;
+
+  std::vector<std::string> lines(chunk_size);
+  std::vector<Symbol> symbols(chunk_size);
+  std::vector<double> values(chunk_size);
+  // Text output: formatted in parallel into fixed-width buffers
+  constexpr std::size_t width = 32;
+  std::vector<char> text(binary ? 0 : chunk_size * width);
+  std::vector<int> text_len(binary ? 0 : chunk_size);
+
+  while (in) {
+    std::size_t num_lines = 0;
+    while (num_lines < chunk_size && std::getline(in, lines[num_lines]))
+      ++num_lines;
+    if (num_lines == 0)
+      break;
+
+#pragma omp parallel for
+    for (std::size_t i = 0; i < num_lines; ++i) {
+      symbols[i] = parseSymbol(lines[i]);
+    }
+
+    // Extend lookup tables, if required (up to max_2j_table)
+    int max_6j = -1, max_3j = -1;
+    for (std::size_t i = 0; i < num_lines; ++i) {
+      const auto &j = symbols[i].tj;
+      if (symbols[i].type == SymbolType::sixj)
+        max_6j = std::max({max_6j, j[0], j[1], j[2], j[3], j[4], j[5]});
+      else if (symbols[i].type == SymbolType::threej)
+        max_3j = std::max({max_3j, j[0], j[1], j[2]});
+    }
+    if (max_6j > sixj.max_2jk())
+      sixj.fill(std::min(max_6j, max_2j_table));
+    if (max_3j > Ck.max_tj() && Ck.max_tj() < max_2j_table)
+      Ck.fill(std::min(max_3j, max_2j_table));
+
+#pragma omp parallel for
+    for (std::size_t i = 0; i < num_lines; ++i) {
+      values[i] = evaluateSymbol(symbols[i], sixj, Ck);
+      if (!binary && symbols[i].type != SymbolType::skip) {
+        text_len[i] = std::snprintf(&text[i * width], width, "%.17g\n",
+                                    values[i]);
+      }
+    }
+
+    for (std::size_t i = 0; i < num_lines; ++i) {
+      if (symbols[i].type == SymbolType::skip)
+        continue;
+      ++count;
+      if (symbols[i].type == SymbolType::invalid)
+        ++num_invalid;
+      if (binary)
+        std::fwrite(&values[i], sizeof(double), 1, out);
+      else
+        std::fwrite(&text[i * width], 1, std::size_t(text_len[i]), out);
+    }
+  }
+
+  const auto t = std::chrono::duration<double>(
+                     std::chrono::steady_clock::now() - t0)
+                     .count();
+  std::cerr << "Evaluated " << count << " symbols (" << num_invalid
+            << " invalid) in " << t << " s\n";
+}
+
 //******************************************************************************
 int main(int num_in, char *argv[]) {
 
@@ -97,6 +286,42 @@ int main(int num_in, char *argv[]) {
   }
 
   auto first_arg = (std::string)argv[1];
+
+  if (first_arg == "-b") {
+    // Batch mode: ./wigner -b [inputfile] [-o outputfile] [--binary]
+    std::string in_name = "-", out_name = "";
+    bool binary = false;
+    for (int i = 2; i < num_in; ++i) {
+      const std::string arg = argv[i];
+      if (arg == "-o" && i + 1 < num_in) {
+        out_name = argv[++i];
+      } else if (arg == "--binary") {
+        binary = true;
+      } else {
+        in_name = arg;
+      }
+    }
+    std::ifstream in_file;
+    if (in_name == "-") {
+      std::ios_base::sync_with_stdio(false);
+    } else {
+      in_file.open(in_name);
+      if (!in_file) {
+        std::cerr << "Cannot open input file: " << in_name << "\n";
+        return 1;
+      }
+    }
+    const auto mode = binary ? "wb" : "w";
+    auto *out = out_name == "" ? stdout : std::fopen(out_name.c_str(), mode);
+    if (out == nullptr) {
+      std::cerr << "Cannot open output file: " << out_name << "\n";
+      return 1;
+    }
+    batchMode(in_name == "-" ? std::cin : in_file, out, binary);
+    if (out != stdout)
+      std::fclose(out);
+    return 0;
+  }
   auto f_ext =
       (first_arg.size() > 3) ? first_arg.substr(first_arg.size() - 3) : "";
 